@@ -8,6 +8,7 @@
 #include "Bots/ShooterBot.h"
 #include "Bots/ShooterAIController.h"
 #include "Online/ShooterPlayerState.h"
+#include "Bots/ShooterLOSService.h"
 
 UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -109,19 +110,13 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 	{
 		if (MyBot != NULL)
 		{
-			// Perform trace to retrieve hit info
-			FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, InActor);
-			
-			TraceParams.bReturnPhysicalMaterial = true;
-			TraceParams.AddIgnoredActor(MyBot);
-			const FVector StartLocation = MyBot->GetActorLocation();
-			FHitResult Hit(ForceInit);
-			GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-			if (Hit.bBlockingHit == true)
+			UShooterLOSService* LOSService = GetWorld()->GetSubsystem<UShooterLOSService>();
+			const FShooterLOSResult* LOS = LOSService ? LOSService->RequestLOS(MyBot, InEnemyActor, EndLocation) : NULL;
+			if (LOS && LOS->bBlockingHit == true)
 			{
 				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
-				AActor* HitActor = Hit.GetActor();
-				if (Hit.GetActor() != NULL)
+				AActor* HitActor = LOS->HitActor.Get();
+				if (HitActor != NULL)
 				{
 					// If the hit is our target actor consider it LOS
 					if (HitActor == InActor)
@@ -152,9 +147,7 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 					if (InEnemyActor == NULL)
 					{
 						// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
-						FVector HitDelta = Hit.ImpactPoint - StartLocation;
-						FVector TargetDelta = EndLocation - StartLocation;
-						if (TargetDelta.SizeSquared() < HitDelta.SizeSquared())
+						if (LOS->TargetDistSq < LOS->HitDistSq)
 						{
 							bHasLOS = true;
 						}
@@ -3,18 +3,47 @@
 #include "ShooterGame.h"
 #include "Bots/BTTask_FindPointNearEnemy.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterNavQueryService.h"
+#include "Bots/ShooterTacticalPointService.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyAllTypes.h"
-#include "NavigationSystem.h"
 
 
 UBTTask_FindPointNearEnemy::UBTTask_FindPointNearEnemy(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
 {
+	bNotifyTick = true;
+	Timeout = 1.0f;
+	ThreatCost = 300.0f;
+	DangerCost = 1000.0f;
 }
 
 EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FBTFindPointNearEnemyMemory* MyMemory = (FBTFindPointNearEnemyMemory*)NodeMemory;
+	MyMemory->StartTime = OwnerComp.GetWorld()->GetTimeSeconds();
+
+	return RequestPoint(OwnerComp);
+}
+
+void UBTTask_FindPointNearEnemy::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	const FBTFindPointNearEnemyMemory* MyMemory = (FBTFindPointNearEnemyMemory*)NodeMemory;
+
+	EBTNodeResult::Type Result = RequestPoint(OwnerComp);
+	if (Result == EBTNodeResult::InProgress && OwnerComp.GetWorld()->GetTimeSeconds() - MyMemory->StartTime > Timeout)
+	{
+		Result = EBTNodeResult::Failed;
+	}
+
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(OwnerComp, Result);
+	}
+}
+
+EBTNodeResult::Type UBTTask_FindPointNearEnemy::RequestPoint(UBehaviorTreeComponent& OwnerComp) const
 {
 	AShooterAIController* MyController = Cast<AShooterAIController>(OwnerComp.GetAIOwner());
 	if (MyController == NULL)
@@ -24,13 +53,38 @@ EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeCompone
 	
 	APawn* MyBot = MyController->GetPawn();
 	AShooterCharacter* Enemy = MyController->GetEnemy();
-	if (Enemy && MyBot)
+	UShooterNavQueryService* NavQueryService = OwnerComp.GetWorld()->GetSubsystem<UShooterNavQueryService>();
+	if (Enemy && MyBot && NavQueryService)
 	{
-		const float SearchRadius = 200.0f;
-		const FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * (MyBot->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal();
 		FVector Loc(0);
-		UNavigationSystemV1::K2_GetRandomReachablePointInRadius(MyController, SearchOrigin, Loc, SearchRadius);
-		if (Loc != FVector::ZeroVector)
+
+		// prefer baked points that see the enemy, cheapest to reach first
+		UShooterTacticalPointService* TacticalService = OwnerComp.GetWorld()->GetSubsystem<UShooterTacticalPointService>();
+		if (TacticalService && TacticalService->HasData())
+		{
+			FShooterTacticalQuery Query;
+			Query.QuerierLocation = MyBot->GetActorLocation();
+			Query.EnemyLocation = Enemy->GetActorLocation();
+			Query.MinEnemyDistance = 400.0f;
+			Query.MaxEnemyDistance = 1200.0f;
+			Query.Visibility = EShooterTacticalVisibility::Visible;
+			Query.FriendlyTeam = MyController->GetFriendlyTeam();
+			// without teams bot's own presence would count as threat
+			Query.ThreatCost = Query.FriendlyTeam != INDEX_NONE ? ThreatCost : 0.0f;
+			Query.DangerCost = DangerCost;
+			if (TacticalService->FindTacticalPoint(Query, Loc))
+			{
+				OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Loc);
+				return EBTNodeResult::Succeeded;
+			}
+		}
+
+		const EShooterNavQueryStatus::Type Status = NavQueryService->RequestPointNearEnemy(Enemy, MyBot->GetActorLocation(), Loc);
+		if (Status == EShooterNavQueryStatus::Pending)
+		{
+			return EBTNodeResult::InProgress;
+		}
+		if (Status == EShooterNavQueryStatus::Succeeded)
 		{
 			OwnerComp.GetBlackboardComponent()->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Loc);
 			return EBTNodeResult::Succeeded;
@@ -39,3 +93,8 @@ EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeCompone
 
 	return EBTNodeResult::Failed;
 }
+
+uint16 UBTTask_FindPointNearEnemy::GetInstanceMemorySize() const
+{
+	return sizeof(FBTFindPointNearEnemyMemory);
+}
@@ -10,14 +10,36 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterPawnIndex.h"
+#include "Bots/ShooterLOSService.h"
+#include "Bots/ShooterBehaviorTreeComponent.h"
+#include "Bots/ShooterAIScheduler.h"
+
+float CVar_ShooterBotPerception_Interval = 0.2f;
+static FAutoConsoleVariableRef CVarShooterBotPerceptionInterval(TEXT("ShooterBotPerception.Interval"), CVar_ShooterBotPerception_Interval, TEXT("Time between bot perception updates, applies to bots spawned after change"), ECVF_Default );
+
+int32 CVar_ShooterBotPerception_OnlyOnChange = 1;
+static FAutoConsoleVariableRef CVarShooterBotPerceptionOnlyOnChange(TEXT("ShooterBotPerception.OnlyOnChange"), CVar_ShooterBotPerception_OnlyOnChange, TEXT("Write bot blackboard keys and focus only when perception changed, 0 writes them on every update"), ECVF_Default );
+
+int32 CVar_ShooterBotPerception_LOSCandidates = 4;
+static FAutoConsoleVariableRef CVarShooterBotPerceptionLOSCandidates(TEXT("ShooterBotPerception.LOSCandidates"), CVar_ShooterBotPerception_LOSCandidates, TEXT("Closest enemies checked for line of sight at once, doubled while all of them are out of sight"), ECVF_Default );
 
 AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
  	BlackboardComp = ObjectInitializer.CreateDefaultSubobject<UBlackboardComponent>(this, TEXT("BlackBoardComp"));
  	
-	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
+	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UShooterBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
 
 	bWantsPlayerState = true;
+
+	EnemyKeyID = FBlackboard::InvalidKey;
+	NeedAmmoKeyID = FBlackboard::InvalidKey;
+	HasLOSKeyID = FBlackboard::InvalidKey;
+	bForceApplyPerception = true;
+
+	AimDirection = FVector::ForwardVector;
+	bAimCanFire = false;
+	AimFrame = 0;
 }
 
 void AShooterAIController::OnPossess(APawn* InPawn)
@@ -36,6 +58,16 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 
 		EnemyKeyID = BlackboardComp->GetKeyID("Enemy");
 		NeedAmmoKeyID = BlackboardComp->GetKeyID("NeedAmmo");
+		HasLOSKeyID = BlackboardComp->GetKeyID("HasLOS");
+
+		// blackboard survives respawns, so clear what previous pawn knew
+		Perception = FShooterBotPerception();
+		bForceApplyPerception = true;
+		ApplyPerception();
+
+		// random first delay spreads bots over frames
+		const float Interval = FMath::Max(CVar_ShooterBotPerception_Interval, 0.01f);
+		GetWorldTimerManager().SetTimer(TimerHandle_UpdatePerception, this, &AShooterAIController::UpdatePerception, Interval, true, FMath::FRand() * Interval);
 
 		BehaviorComp->StartTree(*(Bot->BotBehavior));
 	}
@@ -45,6 +77,8 @@ void AShooterAIController::OnUnPossess()
 {
 	Super::OnUnPossess();
 
+	GetWorldTimerManager().ClearTimer(TimerHandle_UpdatePerception);
+
 	BehaviorComp->StopTree();
 }
 
@@ -52,6 +86,13 @@ void AShooterAIController::BeginInactiveState()
 {
 	Super::BeginInactiveState();
 
+	// pawn was reset between matches, StartBots brings bot back
+	const AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode && !GameMode->IsMatchInProgress())
+	{
+		return;
+	}
+
 	AGameStateBase const* const GameState = GetWorld()->GetGameState();
 
 	const float MinRespawnDelay = GameState ? GameState->GetPlayerRespawnDelay(this) : 1.0f;
@@ -72,27 +113,22 @@ void AShooterAIController::FindClosestEnemy()
 		return;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
+	TArray<AShooterCharacter*> ClosestEnemies;
+	GetWorld()->GetSubsystem<UShooterPawnIndex>()->FindNearestPawns(MyBot->GetActorLocation(), 1, ClosestEnemies,
+		[this](AShooterCharacter* TestPawn) { return TestPawn->IsEnemyFor(this); }, GetFriendlyTeam());
 
-	for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+	if (ClosestEnemies.Num() > 0)
 	{
-		if (TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
+		SetEnemy(ClosestEnemies[0]);
 	}
+}
 
-	if (BestPawn)
-	{
-		SetEnemy(BestPawn);
-	}
+int32 AShooterAIController::GetFriendlyTeam() const
+{
+	const AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
+	const AShooterGameMode* Game = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+
+	return (MyPlayerState && Game && Game->IsTeamGame()) ? MyPlayerState->GetTeamNum() : INDEX_NONE;
 }
 
 bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy)
@@ -101,25 +137,35 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 	APawn* MyBot = GetPawn();
 	if (MyBot != NULL)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
+		// closest first, so the first one in sight is the best one
+		// only the nearest few are queried, farther ones just when none of those is in sight
+		UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+		const int32 FriendlyTeam = GetFriendlyTeam();
+		TArray<AShooterCharacter*> Enemies;
 		AShooterCharacter* BestPawn = NULL;
-
-		for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+		int32 NumChecked = 0;
+		for (int32 MaxCount = FMath::Max(CVar_ShooterBotPerception_LOSCandidates, 1); BestPawn == NULL; MaxCount *= 2)
 		{
-			if (TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
+			Enemies.Reset();
+			PawnIndex->FindNearestPawns(MyBot->GetActorLocation(), MaxCount, Enemies,
+				[this, ExcludeEnemy](AShooterCharacter* TestPawn) { return TestPawn != ExcludeEnemy && TestPawn->IsEnemyFor(this); }, FriendlyTeam);
+
+			for (; NumChecked < Enemies.Num(); NumChecked++)
 			{
-				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
+				if (HasWeaponLOSToEnemy(Enemies[NumChecked], true) == true)
 				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
+					BestPawn = Enemies[NumChecked];
+					break;
 				}
 			}
+
+			// fewer than asked for, there are no more enemies
+			if (Enemies.Num() < MaxCount)
+			{
+				break;
+			}
 		}
+
 		if (BestPawn)
 		{
 			SetEnemy(BestPawn);
@@ -131,25 +177,15 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 
 bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
 {
-	
-	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
+	UShooterLOSService* LOSService = GetWorld()->GetSubsystem<UShooterLOSService>();
+	const FShooterLOSResult* LOS = LOSService ? LOSService->RequestLOS(GetPawn(), InEnemyActor, InEnemyActor->GetActorLocation()) : NULL;
 
 	bool bHasLOS = false;
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, GetPawn());
-
-	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
-	
-	FHitResult Hit(ForceInit);
-	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
+	if (LOS && LOS->bBlockingHit == true)
 	{
 		// Theres a blocking hit - check if its our enemy actor
-		AActor* HitActor = Hit.GetActor();
-		if (Hit.GetActor() != NULL)
+		AActor* HitActor = LOS->HitActor.Get();
+		if (HitActor != NULL)
 		{
 			if (HitActor == InEnemyActor)
 			{
@@ -175,8 +211,6 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 		}
 	}
 
-	
-
 	return bHasLOS;
 }
 
@@ -193,7 +227,9 @@ void AShooterAIController::ShootEnemy()
 	AShooterCharacter* Enemy = GetEnemy();
 	if ( Enemy && ( Enemy->IsAlive() )&& (MyWeapon->GetCurrentAmmo() > 0) && ( MyWeapon->CanFire() == true ) )
 	{
-		if (LineOfSightTo(Enemy, MyBot->GetActorLocation()))
+		UShooterLOSService* LOSService = GetWorld()->GetSubsystem<UShooterLOSService>();
+		const FShooterLOSResult* LOS = LOSService ? LOSService->RequestLOS(MyBot, Enemy, Enemy->GetActorLocation()) : NULL;
+		if (LOS && (!LOS->bBlockingHit || LOS->HitActor == Enemy) && (!HasAimSolution() || bAimCanFire))
 		{
 			bCanShoot = true;
 		}
@@ -211,23 +247,93 @@ void AShooterAIController::ShootEnemy()
 
 void AShooterAIController::CheckAmmo(const class AShooterWeapon* CurrentWeapon)
 {
-	if (CurrentWeapon && BlackboardComp)
+	if (CurrentWeapon)
 	{
 		const int32 Ammo = CurrentWeapon->GetCurrentAmmo();
 		const int32 MaxAmmo = CurrentWeapon->GetMaxAmmo();
 		const float Ratio = (float) Ammo / (float) MaxAmmo;
 
-		BlackboardComp->SetValue<UBlackboardKeyType_Bool>(NeedAmmoKeyID, (Ratio <= 0.1f));
+		Perception.bNeedAmmo = (Ratio <= 0.1f);
+
+		// weapon calls this on every shot, changes are picked up by next perception update
+		if (!CVar_ShooterBotPerception_OnlyOnChange)
+		{
+			ApplyPerception();
+		}
 	}
 }
 
 void AShooterAIController::SetEnemy(class APawn* InPawn)
 {
-	if (BlackboardComp)
+	Perception.Enemy = InPawn;
+	ApplyPerception();
+}
+
+void AShooterAIController::UpdatePerception()
+{
+	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
+	if (MyBot == NULL)
+	{
+		return;
+	}
+
+	CheckAmmo(MyBot->GetWeapon());
+
+	APawn* Enemy = Perception.Enemy.Get();
+	Perception.bHasLOS = (HasLOSKeyID != FBlackboard::InvalidKey) && Enemy && HasWeaponLOSToEnemy(Enemy, false);
+
+	ApplyPerception();
+}
+
+void AShooterAIController::ApplyPerception()
+{
+	if (BlackboardComp == NULL)
+	{
+		return;
+	}
+
+	UShooterAIScheduler* Scheduler = GetWorld()->GetSubsystem<UShooterAIScheduler>();
+	const bool bWriteAll = bForceApplyPerception || !CVar_ShooterBotPerception_OnlyOnChange;
+	bForceApplyPerception = false;
+
+	const bool bWriteEnemy = bWriteAll || Perception.Enemy != AppliedPerception.Enemy;
+	if (bWriteEnemy)
 	{
-		BlackboardComp->SetValue<UBlackboardKeyType_Object>(EnemyKeyID, InPawn);
-		SetFocus(InPawn);
+		APawn* Enemy = Perception.Enemy.Get();
+		BlackboardComp->SetValue<UBlackboardKeyType_Object>(EnemyKeyID, Enemy);
+		SetFocus(Enemy);
 	}
+
+	const bool bWriteNeedAmmo = bWriteAll || Perception.bNeedAmmo != AppliedPerception.bNeedAmmo;
+	if (bWriteNeedAmmo)
+	{
+		BlackboardComp->SetValue<UBlackboardKeyType_Bool>(NeedAmmoKeyID, Perception.bNeedAmmo);
+	}
+
+	const bool bWriteHasLOS = HasLOSKeyID != FBlackboard::InvalidKey && (bWriteAll || Perception.bHasLOS != AppliedPerception.bHasLOS);
+	if (bWriteHasLOS)
+	{
+		BlackboardComp->SetValue<UBlackboardKeyType_Bool>(HasLOSKeyID, Perception.bHasLOS);
+	}
+
+	if (Scheduler)
+	{
+		Scheduler->AddBlackboardUpdate(bWriteEnemy);
+		Scheduler->AddBlackboardUpdate(bWriteNeedAmmo);
+		if (HasLOSKeyID != FBlackboard::InvalidKey)
+		{
+			Scheduler->AddBlackboardUpdate(bWriteHasLOS);
+		}
+	}
+
+	AppliedPerception = Perception;
+}
+
+void AShooterAIController::SetAimSolution(const FVector& InAimDirection, bool bInAimCanFire)
+{
+	AimDirection = InAimDirection;
+	bAimCanFire = bInAimCanFire;
+	AimFrame = GFrameCounter;
 }
 
 class AShooterCharacter* AShooterAIController::GetEnemy() const
@@ -248,6 +354,12 @@ void AShooterAIController::UpdateControlRotation(float DeltaTime, bool bUpdatePa
 	if( !FocalPoint.IsZero() && GetPawn())
 	{
 		FVector Direction = FocalPoint - GetPawn()->GetActorLocation();
+
+		// lead enemy when looking at it
+		if (HasAimSolution() && GetFocusActor() != NULL && GetFocusActor() == GetEnemy())
+		{
+			Direction = AimDirection;
+		}
 		FRotator NewControlRotation = Direction.Rotation();
 		
 		NewControlRotation.Yaw = FRotator::ClampAxis(NewControlRotation.Yaw);
@@ -273,6 +385,7 @@ void AShooterAIController::GameHasEnded(AActor* EndGameFocus, bool bIsWinner)
 
 	// Cancel the repsawn timer
 	GetWorldTimerManager().ClearTimer(TimerHandle_Respawn);
+	GetWorldTimerManager().ClearTimer(TimerHandle_UpdatePerception);
 
 	// Clear any enemy
 	SetEnemy(NULL);
@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterAIScheduler.h"
+#include "Bots/ShooterBehaviorTreeComponent.h"
+#include "Bots/ShooterAIController.h"
+
+int32 CVar_ShooterAILOD_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterAILODEnable(TEXT("ShooterAILOD.Enable"), CVar_ShooterAILOD_Enable, TEXT("Schedule bot behavior trees by significance, 0 ticks every tree every frame"), ECVF_Default );
+
+float CVar_ShooterAILOD_BudgetMs = 1.0f;
+static FAutoConsoleVariableRef CVarShooterAILODBudgetMs(TEXT("ShooterAILOD.BudgetMs"), CVar_ShooterAILOD_BudgetMs, TEXT("Behavior tree time per frame in ms, trees past it wait until their tier's max staleness"), ECVF_Default );
+
+float CVar_ShooterAILOD_NearDistance = 3000.0f;
+static FAutoConsoleVariableRef CVarShooterAILODNearDistance(TEXT("ShooterAILOD.NearDistance"), CVar_ShooterAILOD_NearDistance, TEXT("Bots closer than this to a human are in tier 0"), ECVF_Default );
+
+float CVar_ShooterAILOD_FarDistance = 8000.0f;
+static FAutoConsoleVariableRef CVarShooterAILODFarDistance(TEXT("ShooterAILOD.FarDistance"), CVar_ShooterAILOD_FarDistance, TEXT("Bots closer than this to a human are in tier 1, others in tier 2"), ECVF_Default );
+
+float CVar_ShooterAILOD_CombatDistance = 4000.0f;
+static FAutoConsoleVariableRef CVarShooterAILODCombatDistance(TEXT("ShooterAILOD.CombatDistance"), CVar_ShooterAILOD_CombatDistance, TEXT("Bots closer than this to their enemy are fighting and stay in tier 0"), ECVF_Default );
+
+float CVar_ShooterAILOD_Interval1 = 0.1f;
+static FAutoConsoleVariableRef CVarShooterAILODInterval1(TEXT("ShooterAILOD.Interval1"), CVar_ShooterAILOD_Interval1, TEXT("Min time between behavior tree ticks in tier 1"), ECVF_Default );
+
+float CVar_ShooterAILOD_Interval2 = 0.25f;
+static FAutoConsoleVariableRef CVarShooterAILODInterval2(TEXT("ShooterAILOD.Interval2"), CVar_ShooterAILOD_Interval2, TEXT("Min time between behavior tree ticks in tier 2"), ECVF_Default );
+
+float CVar_ShooterAILOD_MaxStaleness0 = 0.1f;
+static FAutoConsoleVariableRef CVarShooterAILODMaxStaleness0(TEXT("ShooterAILOD.MaxStaleness0"), CVar_ShooterAILOD_MaxStaleness0, TEXT("Max time between behavior tree ticks in tier 0, regardless of budget"), ECVF_Default );
+
+float CVar_ShooterAILOD_MaxStaleness1 = 0.25f;
+static FAutoConsoleVariableRef CVarShooterAILODMaxStaleness1(TEXT("ShooterAILOD.MaxStaleness1"), CVar_ShooterAILOD_MaxStaleness1, TEXT("Max time between behavior tree ticks in tier 1, regardless of budget"), ECVF_Default );
+
+float CVar_ShooterAILOD_MaxStaleness2 = 0.5f;
+static FAutoConsoleVariableRef CVarShooterAILODMaxStaleness2(TEXT("ShooterAILOD.MaxStaleness2"), CVar_ShooterAILOD_MaxStaleness2, TEXT("Max time between behavior tree ticks in tier 2, regardless of budget"), ECVF_Default );
+
+void UShooterAIScheduler::RegisterComponent(UShooterBehaviorTreeComponent* BehaviorComp)
+{
+	if (BehaviorComp)
+	{
+		Components.AddUnique(BehaviorComp);
+	}
+}
+
+void UShooterAIScheduler::UnregisterComponent(UShooterBehaviorTreeComponent* BehaviorComp)
+{
+	Components.RemoveSingleSwap(BehaviorComp, false);
+}
+
+bool UShooterAIScheduler::ShouldTick(uint8 Tier, float PendingDeltaTime)
+{
+	if (!CVar_ShooterAILOD_Enable)
+	{
+		return true;
+	}
+
+	const float MinInterval[SHOOTER_AI_LOD_TIERS] = { 0.0f, CVar_ShooterAILOD_Interval1, CVar_ShooterAILOD_Interval2 };
+	const float MaxStaleness[SHOOTER_AI_LOD_TIERS] = { CVar_ShooterAILOD_MaxStaleness0, CVar_ShooterAILOD_MaxStaleness1, CVar_ShooterAILOD_MaxStaleness2 };
+	Tier = FMath::Min<uint8>(Tier, SHOOTER_AI_LOD_TIERS - 1);
+
+	if (PendingDeltaTime < MinInterval[Tier])
+	{
+		return false;
+	}
+
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		FrameTreeTime = 0.0;
+	}
+
+	if (PendingDeltaTime >= MaxStaleness[Tier])
+	{
+		TierStats[Tier].NumForcedTicks += (FrameTreeTime >= CVar_ShooterAILOD_BudgetMs * 0.001) ? 1 : 0;
+		return true;
+	}
+
+	if (FrameTreeTime >= CVar_ShooterAILOD_BudgetMs * 0.001)
+	{
+		TierStats[Tier].NumDeferredTicks++;
+		return false;
+	}
+
+	return true;
+}
+
+void UShooterAIScheduler::AddTickSample(uint8 Tier, float Staleness, double Seconds)
+{
+	FShooterAILODTierStats& Stats = TierStats[FMath::Min<uint8>(Tier, SHOOTER_AI_LOD_TIERS - 1)];
+	Stats.NumTicks++;
+	Stats.TotalStaleness += Staleness;
+	Stats.MaxStaleness = FMath::Max(Stats.MaxStaleness, Staleness);
+
+	FrameTreeTime += Seconds;
+	TotalTreeTime += Seconds;
+}
+
+void UShooterAIScheduler::UpdateTiers()
+{
+	UWorld* World = GetWorld();
+
+	TArray<FVector, TInlineAllocator<8>> HumanLocations;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* HumanPawn = It->Get() ? It->Get()->GetPawn() : NULL;
+		if (HumanPawn)
+		{
+			HumanLocations.Add(HumanPawn->GetActorLocation());
+		}
+	}
+
+	for (int32 Idx = 0; Idx < SHOOTER_AI_LOD_TIERS; Idx++)
+	{
+		TierStats[Idx].NumBots = 0;
+	}
+
+	const float NearDistSq = FMath::Square(CVar_ShooterAILOD_NearDistance);
+	const float FarDistSq = FMath::Square(CVar_ShooterAILOD_FarDistance);
+	const float CombatDistSq = FMath::Square(CVar_ShooterAILOD_CombatDistance);
+
+	for (UShooterBehaviorTreeComponent* BehaviorComp : Components)
+	{
+		const AShooterAIController* Controller = BehaviorComp ? Cast<AShooterAIController>(BehaviorComp->GetOwner()) : NULL;
+		const APawn* Bot = Controller ? Controller->GetPawn() : NULL;
+		if (Bot == NULL)
+		{
+			continue;
+		}
+
+		const FVector BotLocation = Bot->GetActorLocation();
+		const AShooterCharacter* Enemy = Controller->GetEnemy();
+		const bool bInCombat = Enemy && Enemy->IsAlive() && FVector::DistSquared(Enemy->GetActorLocation(), BotLocation) <= CombatDistSq;
+
+		float ClosestHumanDistSq = MAX_FLT;
+		for (const FVector& HumanLocation : HumanLocations)
+		{
+			ClosestHumanDistSq = FMath::Min(ClosestHumanDistSq, FVector::DistSquared(HumanLocation, BotLocation));
+		}
+
+		BehaviorComp->LODTier = (bInCombat || ClosestHumanDistSq <= NearDistSq) ? 0 : (ClosestHumanDistSq <= FarDistSq ? 1 : 2);
+		TierStats[BehaviorComp->LODTier].NumBots++;
+	}
+}
+
+void UShooterAIScheduler::Tick(float DeltaTime)
+{
+	UpdateTiers();
+
+	NumFrames++;
+	TotalGameThreadTime += FPlatformTime::ToSeconds(GGameThreadTime);
+	TotalTime += DeltaTime;
+}
+
+ETickableTickType UShooterAIScheduler::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterAIScheduler::IsTickable() const
+{
+	return Components.Num() > 0;
+}
+
+TStatId UShooterAIScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAIScheduler, STATGROUP_Tickables);
+}
+
+UWorld* UShooterAIScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterAIScheduler::DumpStats() const
+{
+	const int32 SafeNumFrames = FMath::Max(NumFrames, 1);
+	UE_LOG(LogShooter, Log, TEXT("AI LOD: %s, %d bots, %d frames, behavior trees %.3f ms/frame, game thread %.3f ms/frame"),
+		CVar_ShooterAILOD_Enable ? TEXT("enabled") : TEXT("disabled"), Components.Num(), NumFrames,
+		1000.0 * TotalTreeTime / SafeNumFrames, 1000.0 * TotalGameThreadTime / SafeNumFrames);
+
+	for (int32 Idx = 0; Idx < SHOOTER_AI_LOD_TIERS; Idx++)
+	{
+		const FShooterAILODTierStats& Stats = TierStats[Idx];
+		UE_LOG(LogShooter, Log, TEXT("  tier %d: %d bots, %d ticks, %d forced, %d deferred, avg staleness %.3f s, max %.3f s"),
+			Idx, Stats.NumBots, Stats.NumTicks, Stats.NumForcedTicks, Stats.NumDeferredTicks,
+			Stats.NumTicks > 0 ? Stats.TotalStaleness / Stats.NumTicks : 0.0, Stats.MaxStaleness);
+	}
+
+	const double SafeTotalTime = FMath::Max(TotalTime, 0.001);
+	UE_LOG(LogShooter, Log, TEXT("  re-evaluations %.1f/s, blackboard writes %.1f/s, unchanged skipped %.1f/s"),
+		NumFlowUpdates / SafeTotalTime, NumBlackboardWrites / SafeTotalTime, NumSkippedBlackboardWrites / SafeTotalTime);
+}
+
+void UShooterAIScheduler::ResetStats()
+{
+	for (int32 Idx = 0; Idx < SHOOTER_AI_LOD_TIERS; Idx++)
+	{
+		const int32 NumBots = TierStats[Idx].NumBots;
+		TierStats[Idx] = FShooterAILODTierStats();
+		TierStats[Idx].NumBots = NumBots;
+	}
+
+	NumFrames = 0;
+	TotalTreeTime = 0.0;
+	TotalGameThreadTime = 0.0;
+	TotalTime = 0.0;
+	NumFlowUpdates = 0;
+	NumBlackboardWrites = 0;
+	NumSkippedBlackboardWrites = 0;
+}
+
+void UShooterAIScheduler::Deinitialize()
+{
+	Components.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterAILODStatsCmd(TEXT("ShooterAILOD.Stats"), TEXT("[server] Prints behavior tree ticks per update tier and server frame time. Pass 'reset' to clear them, compare runs with ShooterAILOD.Enable or ShooterBotPerception.OnlyOnChange 0 and 1."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterAIScheduler* Scheduler = World ? World->GetSubsystem<UShooterAIScheduler>() : NULL;
+		if (Scheduler)
+		{
+			Scheduler->DumpStats();
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				Scheduler->ResetStats();
+			}
+		}
+	})
+);
@@ -0,0 +1,225 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterAimSolver.h"
+#include "Bots/ShooterAIController.h"
+#include "Bots/ShooterBot.h"
+#include "Weapons/ShooterWeapon.h"
+
+int32 CVar_ShooterAim_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterAimEnable(TEXT("ShooterAim.Enable"), CVar_ShooterAim_Enable, TEXT("Lead bot aim by shot flight time, solved for all bots at once"), ECVF_Default );
+
+float CVar_ShooterAim_FireTolerance = 10.0f;
+static FAutoConsoleVariableRef CVarShooterAimFireTolerance(TEXT("ShooterAim.FireTolerance"), CVar_ShooterAim_FireTolerance, TEXT("Max angle in degrees between bot aim and lead direction to fire"), ECVF_Default );
+
+/** flight time refinements, each one moves aim point to where target is when shot arrives */
+static const int32 ShooterAimLeadIterations = 3;
+
+void FShooterAimBatch::Reset(int32 InNum)
+{
+	Num = InNum;
+	const int32 PaddedNum = Align(InNum, 4);
+
+	for (TArray<float>* Array : { &ShooterX, &ShooterY, &ShooterZ, &TargetX, &TargetY, &TargetZ, &VelocityX, &VelocityY, &VelocityZ,
+		&ViewX, &ViewY, &ViewZ, &InvShotSpeed, &RangeSq, &AimX, &AimY, &AimZ })
+	{
+		Array->SetNumUninitialized(PaddedNum, false);
+		FMemory::Memzero(Array->GetData() + InNum, (PaddedNum - InNum) * sizeof(float));
+	}
+
+	bFire.SetNumZeroed(PaddedNum, false);
+}
+
+void FShooterAimBatch::Set(int32 Idx, const FVector& Shooter, const FVector& Target, const FVector& Velocity, const FVector& View, float ShotSpeed, float Range)
+{
+	ShooterX[Idx] = Shooter.X;
+	ShooterY[Idx] = Shooter.Y;
+	ShooterZ[Idx] = Shooter.Z;
+	TargetX[Idx] = Target.X;
+	TargetY[Idx] = Target.Y;
+	TargetZ[Idx] = Target.Z;
+	VelocityX[Idx] = Velocity.X;
+	VelocityY[Idx] = Velocity.Y;
+	VelocityZ[Idx] = Velocity.Z;
+	ViewX[Idx] = View.X;
+	ViewY[Idx] = View.Y;
+	ViewZ[Idx] = View.Z;
+	InvShotSpeed[Idx] = ShotSpeed > 0.0f ? 1.0f / ShotSpeed : 0.0f;
+	RangeSq[Idx] = FMath::Square(FMath::Min(Range, WORLD_MAX));
+}
+
+void FShooterAimBatch::Solve(float CosFireTolerance)
+{
+	const VectorRegister Tiny = VectorSetFloat1(KINDA_SMALL_NUMBER);
+	const VectorRegister CosTolerance = VectorSetFloat1(CosFireTolerance);
+
+	for (int32 Idx = 0; Idx < Num; Idx += 4)
+	{
+		const VectorRegister DX = VectorSubtract(VectorLoad(&TargetX[Idx]), VectorLoad(&ShooterX[Idx]));
+		const VectorRegister DY = VectorSubtract(VectorLoad(&TargetY[Idx]), VectorLoad(&ShooterY[Idx]));
+		const VectorRegister DZ = VectorSubtract(VectorLoad(&TargetZ[Idx]), VectorLoad(&ShooterZ[Idx]));
+		const VectorRegister VX = VectorLoad(&VelocityX[Idx]);
+		const VectorRegister VY = VectorLoad(&VelocityY[Idx]);
+		const VectorRegister VZ = VectorLoad(&VelocityZ[Idx]);
+		const VectorRegister InvSpeed = VectorLoad(&InvShotSpeed[Idx]);
+
+		VectorRegister PX = DX;
+		VectorRegister PY = DY;
+		VectorRegister PZ = DZ;
+		for (int32 Iteration = 0; Iteration < ShooterAimLeadIterations; Iteration++)
+		{
+			const VectorRegister DistSq = VectorMax(VectorMultiplyAdd(PZ, PZ, VectorMultiplyAdd(PY, PY, VectorMultiply(PX, PX))), Tiny);
+			const VectorRegister FlightTime = VectorMultiply(VectorMultiply(DistSq, VectorReciprocalSqrtAccurate(DistSq)), InvSpeed);
+			PX = VectorMultiplyAdd(VX, FlightTime, DX);
+			PY = VectorMultiplyAdd(VY, FlightTime, DY);
+			PZ = VectorMultiplyAdd(VZ, FlightTime, DZ);
+		}
+
+		const VectorRegister DistSq = VectorMax(VectorMultiplyAdd(PZ, PZ, VectorMultiplyAdd(PY, PY, VectorMultiply(PX, PX))), Tiny);
+		const VectorRegister InvDist = VectorReciprocalSqrtAccurate(DistSq);
+		const VectorRegister AX = VectorMultiply(PX, InvDist);
+		const VectorRegister AY = VectorMultiply(PY, InvDist);
+		const VectorRegister AZ = VectorMultiply(PZ, InvDist);
+		VectorStore(AX, &AimX[Idx]);
+		VectorStore(AY, &AimY[Idx]);
+		VectorStore(AZ, &AimZ[Idx]);
+
+		const VectorRegister Facing = VectorMultiplyAdd(AZ, VectorLoad(&ViewZ[Idx]), VectorMultiplyAdd(AY, VectorLoad(&ViewY[Idx]), VectorMultiply(AX, VectorLoad(&ViewX[Idx]))));
+		const VectorRegister FireMask = VectorBitwiseAnd(VectorCompareGE(Facing, CosTolerance), VectorCompareLE(DistSq, VectorLoad(&RangeSq[Idx])));
+		const int32 FireBits = VectorMaskBits(FireMask);
+		bFire[Idx + 0] = (FireBits >> 0) & 1;
+		bFire[Idx + 1] = (FireBits >> 1) & 1;
+		bFire[Idx + 2] = (FireBits >> 2) & 1;
+		bFire[Idx + 3] = (FireBits >> 3) & 1;
+	}
+}
+
+void FShooterAimBatch::SolveScalar(float CosFireTolerance)
+{
+	for (int32 Idx = 0; Idx < Num; Idx++)
+	{
+		const FVector Delta(TargetX[Idx] - ShooterX[Idx], TargetY[Idx] - ShooterY[Idx], TargetZ[Idx] - ShooterZ[Idx]);
+		const FVector Velocity(VelocityX[Idx], VelocityY[Idx], VelocityZ[Idx]);
+
+		FVector AimPoint = Delta;
+		for (int32 Iteration = 0; Iteration < ShooterAimLeadIterations; Iteration++)
+		{
+			AimPoint = Delta + Velocity * (AimPoint.Size() * InvShotSpeed[Idx]);
+		}
+
+		const float DistSq = FMath::Max(AimPoint.SizeSquared(), KINDA_SMALL_NUMBER);
+		const FVector Aim = AimPoint * FMath::InvSqrt(DistSq);
+		AimX[Idx] = Aim.X;
+		AimY[Idx] = Aim.Y;
+		AimZ[Idx] = Aim.Z;
+
+		const float Facing = Aim | FVector(ViewX[Idx], ViewY[Idx], ViewZ[Idx]);
+		bFire[Idx] = (Facing >= CosFireTolerance && DistSq <= RangeSq[Idx]) ? 1 : 0;
+	}
+}
+
+void UShooterAimSolver::Tick(float DeltaTime)
+{
+	Controllers.Reset();
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		AShooterAIController* AIC = Cast<AShooterAIController>(*It);
+		AShooterBot* Bot = AIC ? Cast<AShooterBot>(AIC->GetPawn()) : NULL;
+		AShooterCharacter* Enemy = AIC ? AIC->GetEnemy() : NULL;
+		if (Bot && Bot->GetWeapon() && Enemy && Enemy->IsAlive())
+		{
+			Controllers.Add(AIC);
+		}
+	}
+
+	Batch.Reset(Controllers.Num());
+	for (int32 Idx = 0; Idx < Controllers.Num(); Idx++)
+	{
+		AShooterAIController* AIC = Controllers[Idx].Get();
+		AShooterBot* Bot = CastChecked<AShooterBot>(AIC->GetPawn());
+		AShooterCharacter* Enemy = AIC->GetEnemy();
+		AShooterWeapon* Weapon = Bot->GetWeapon();
+
+		Batch.Set(Idx, Bot->GetPawnViewLocation(), Enemy->GetActorLocation(), Enemy->GetVelocity(), AIC->GetControlRotation().Vector(),
+			Weapon->GetShotSpeed(), Weapon->GetShotRange());
+	}
+
+	Batch.Solve(FMath::Cos(FMath::DegreesToRadians(CVar_ShooterAim_FireTolerance)));
+
+	for (int32 Idx = 0; Idx < Controllers.Num(); Idx++)
+	{
+		Controllers[Idx]->SetAimSolution(Batch.GetAim(Idx), Batch.bFire[Idx] != 0);
+	}
+}
+
+void UShooterAimSolver::RunBenchmark(int32 NumBots, int32 NumIterations)
+{
+	FRandomStream Random(1234);
+	FShooterAimBatch SIMDBatch;
+	SIMDBatch.Reset(NumBots);
+	for (int32 Idx = 0; Idx < NumBots; Idx++)
+	{
+		const FVector Shooter = Random.VRand() * Random.FRandRange(0.0f, 10000.0f);
+		const FVector Target = Shooter + Random.VRand() * Random.FRandRange(200.0f, 5000.0f);
+		SIMDBatch.Set(Idx, Shooter, Target, Random.VRand() * Random.FRandRange(0.0f, 600.0f), Random.VRand(),
+			(Idx % 2) ? 2000.0f : 0.0f, (Idx % 2) ? 20000.0f : 10000.0f);
+	}
+
+	FShooterAimBatch ScalarBatch = SIMDBatch;
+	const float CosFireTolerance = FMath::Cos(FMath::DegreesToRadians(CVar_ShooterAim_FireTolerance));
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		ScalarBatch.SolveScalar(CosFireTolerance);
+	}
+	const double ScalarTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		SIMDBatch.Solve(CosFireTolerance);
+	}
+	const double SIMDTime = FPlatformTime::Seconds() - StartTime;
+
+	float MaxError = 0.0f;
+	int32 NumFireMismatches = 0;
+	for (int32 Idx = 0; Idx < NumBots; Idx++)
+	{
+		MaxError = FMath::Max(MaxError, FVector::Dist(SIMDBatch.GetAim(Idx), ScalarBatch.GetAim(Idx)));
+		NumFireMismatches += (SIMDBatch.bFire[Idx] != ScalarBatch.bFire[Idx]) ? 1 : 0;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Aim benchmark: %d bots, scalar %.4f ms, batched %.4f ms per solve, max aim difference %.6f, %d fire decisions differ"),
+		NumBots, 1000.0 * ScalarTime / NumIterations, 1000.0 * SIMDTime / NumIterations, MaxError, NumFireMismatches);
+}
+
+ETickableTickType UShooterAimSolver::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterAimSolver::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return CVar_ShooterAim_Enable && World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+TStatId UShooterAimSolver::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAimSolver, STATGROUP_Tickables);
+}
+
+UWorld* UShooterAimSolver::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterAimBenchmarkCmd(TEXT("ShooterAim.Benchmark"), TEXT("Times batched bot aim against one bot at a time. Optional number of bots and iterations, default 256 and 1000."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		const int32 NumBots = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 256;
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+		UShooterAimSolver::RunBenchmark(NumBots, NumIterations);
+	})
+);
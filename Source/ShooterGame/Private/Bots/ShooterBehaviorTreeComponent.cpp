@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBehaviorTreeComponent.h"
+#include "Bots/ShooterAIScheduler.h"
+
+UShooterBehaviorTreeComponent::UShooterBehaviorTreeComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	LODTier = 0;
+	PendingDeltaTime = 0.0f;
+}
+
+void UShooterBehaviorTreeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UShooterAIScheduler* WorldScheduler = GetWorld()->GetSubsystem<UShooterAIScheduler>();
+	if (WorldScheduler && GetOwnerRole() == ROLE_Authority)
+	{
+		WorldScheduler->RegisterComponent(this);
+		Scheduler = WorldScheduler;
+	}
+}
+
+void UShooterBehaviorTreeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Scheduler.IsValid())
+	{
+		Scheduler->UnregisterComponent(this);
+		Scheduler = NULL;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UShooterBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	PendingDeltaTime += DeltaTime;
+
+	UShooterAIScheduler* WorldScheduler = Scheduler.Get();
+	if (WorldScheduler && !WorldScheduler->ShouldTick(LODTier, PendingDeltaTime))
+	{
+		return;
+	}
+
+	if (WorldScheduler && bRequestedFlowUpdate)
+	{
+		WorldScheduler->AddFlowUpdate();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Super::TickComponent(PendingDeltaTime, TickType, ThisTickFunction);
+
+	if (WorldScheduler)
+	{
+		WorldScheduler->AddTickSample(LODTier, PendingDeltaTime, FPlatformTime::Seconds() - StartTime);
+	}
+	PendingDeltaTime = 0.0f;
+}
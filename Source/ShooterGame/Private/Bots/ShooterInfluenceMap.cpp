@@ -0,0 +1,495 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterInfluenceMap.h"
+#include "Online/ShooterPlayerState.h"
+#include "NavigationSystem.h"
+#include "Async/Async.h"
+
+float CVar_ShooterInfluence_CellSize = 400.0f;
+static FAutoConsoleVariableRef CVarShooterInfluenceCellSize(TEXT("ShooterInfluence.CellSize"), CVar_ShooterInfluence_CellSize, TEXT("Size of influence map cell in world units, grid is rebuilt on change"), ECVF_Default );
+
+float CVar_ShooterInfluence_UpdateRate = 10.0f;
+static FAutoConsoleVariableRef CVarShooterInfluenceUpdateRate(TEXT("ShooterInfluence.UpdateRate"), CVar_ShooterInfluence_UpdateRate, TEXT("Influence map updates per second"), ECVF_Default );
+
+float CVar_ShooterInfluence_PawnRadius = 1500.0f;
+static FAutoConsoleVariableRef CVarShooterInfluencePawnRadius(TEXT("ShooterInfluence.PawnRadius"), CVar_ShooterInfluence_PawnRadius, TEXT("Distance at which pawn presence falls off to 0"), ECVF_Default );
+
+float CVar_ShooterInfluence_DangerHalfLife = 3.0f;
+static FAutoConsoleVariableRef CVarShooterInfluenceDangerHalfLife(TEXT("ShooterInfluence.DangerHalfLife"), CVar_ShooterInfluence_DangerHalfLife, TEXT("Seconds for danger from damage and explosions to halve"), ECVF_Default );
+
+int32 CVar_ShooterInfluence_Draw = 0;
+static FAutoConsoleVariableRef CVarShooterInfluenceDraw(TEXT("ShooterInfluence.Draw"), CVar_ShooterInfluence_Draw, TEXT("Draw influence map: 1 presence and danger, 2 danger only"), ECVF_Cheat );
+
+/** radius of danger added by a single hit */
+static const float ShooterInfluenceHitRadius = 500.0f;
+
+/** presence layers are rebuilt from scratch this often to get rid of float drift */
+static const int32 ShooterInfluenceRebuildInterval = 50;
+
+/** max cells per axis */
+static const int32 ShooterInfluenceMaxCells = 512;
+
+void FShooterInfluenceWorkState::Update(const FShooterInfluenceInput& Input)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	CatchUp();
+	FShooterInfluenceGrid& Grid = *WriteGrid;
+
+	if (++UpdatesSinceRebuild >= ShooterInfluenceRebuildInterval || StampRadius != Input.PawnRadius)
+	{
+		for (TArray<float>& Layer : Grid.Presence)
+		{
+			FMemory::Memzero(Layer.GetData(), Layer.Num() * sizeof(float));
+		}
+		bAllDirty = true;
+		PawnStamps.Reset();
+		UpdatesSinceRebuild = 0;
+		StampRadius = Input.PawnRadius;
+	}
+
+	// only pawns that changed cell or team are restamped
+	TSet<uint32> SeenPawns;
+	SeenPawns.Reserve(Input.Pawns.Num());
+	for (const FShooterInfluenceInput::FPawnSample& Pawn : Input.Pawns)
+	{
+		SeenPawns.Add(Pawn.Id);
+
+		const int32 LayerIdx = GetLayer(Pawn.Team);
+		const int32 CellIdx = Grid.GetCellIndex(Pawn.Location);
+		TPair<int32, int32>* Stamp = PawnStamps.Find(Pawn.Id);
+		if (Stamp && Stamp->Key == LayerIdx && Stamp->Value == CellIdx)
+		{
+			continue;
+		}
+
+		if (Stamp)
+		{
+			StampPawn(Stamp->Key, Stamp->Value, -1.0f);
+		}
+		StampPawn(LayerIdx, CellIdx, 1.0f);
+		PawnStamps.Add(Pawn.Id, TPair<int32, int32>(LayerIdx, CellIdx));
+	}
+
+	for (TMap<uint32, TPair<int32, int32>>::TIterator It(PawnStamps); It; ++It)
+	{
+		if (!SeenPawns.Contains(It.Key()))
+		{
+			StampPawn(It.Value().Key, It.Value().Value, -1.0f);
+			It.RemoveCurrent();
+		}
+	}
+
+	// decay only cells that have danger
+	const float Decay = FMath::Pow(0.5f, Input.DeltaTime / FMath::Max(Input.DangerHalfLife, 0.01f));
+	for (TSet<int32>::TIterator It(ActiveDangerCells); It; ++It)
+	{
+		float& Value = Grid.Danger[*It];
+		Value *= Decay;
+		MarkDirty(*It);
+		if (Value < 0.01f)
+		{
+			Value = 0.0f;
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FShooterInfluenceInput::FDangerSample& Event : Input.DangerEvents)
+	{
+		StampDanger(Event.Location, Event.Radius, Event.Amount);
+	}
+
+	LastUpdateTime = FPlatformTime::Seconds() - StartTime;
+}
+
+void FShooterInfluenceWorkState::Publish()
+{
+	Swap(WriteGrid, PublishedGrid);
+	bPublished = true;
+}
+
+void FShooterInfluenceWorkState::CatchUp()
+{
+	FShooterInfluenceGrid& Grid = *WriteGrid;
+	if (bPublished)
+	{
+		const FShooterInfluenceGrid& Source = *PublishedGrid;
+
+		// grids differ in shape until first full copy, or after a layer was added to only one of them
+		if (bAllDirty || Source.SizeX != Grid.SizeX || Source.SizeY != Grid.SizeY || Source.LayerTeams.Num() != Grid.LayerTeams.Num())
+		{
+			Grid = Source;
+		}
+		else
+		{
+			for (TConstSetBitIterator<> It(DirtyCells); It; ++It)
+			{
+				const int32 CellIdx = It.GetIndex();
+				Grid.Danger[CellIdx] = Source.Danger[CellIdx];
+				for (int32 LayerIdx = 0; LayerIdx < Grid.Presence.Num(); LayerIdx++)
+				{
+					Grid.Presence[LayerIdx][CellIdx] = Source.Presence[LayerIdx][CellIdx];
+				}
+			}
+		}
+
+		DirtyCells.Reset();
+		bAllDirty = false;
+		bPublished = false;
+	}
+
+	if (DirtyCells.Num() != Grid.SizeX * Grid.SizeY)
+	{
+		DirtyCells.Init(false, Grid.SizeX * Grid.SizeY);
+	}
+}
+
+void FShooterInfluenceWorkState::MarkDirty(int32 CellIdx)
+{
+	if (!bAllDirty)
+	{
+		DirtyCells[CellIdx] = true;
+	}
+}
+
+void FShooterInfluenceWorkState::StampPawn(int32 LayerIdx, int32 CellIdx, float Sign)
+{
+	if (CellIdx == INDEX_NONE || StampRadius <= 0.0f)
+	{
+		return;
+	}
+
+	FShooterInfluenceGrid& Grid = *WriteGrid;
+	TArray<float>& Layer = Grid.Presence[LayerIdx];
+	const int32 CenterX = CellIdx % Grid.SizeX;
+	const int32 CenterY = CellIdx / Grid.SizeX;
+	const int32 Reach = FMath::CeilToInt(StampRadius / Grid.CellSize);
+
+	for (int32 Y = FMath::Max(CenterY - Reach, 0); Y <= FMath::Min(CenterY + Reach, Grid.SizeY - 1); Y++)
+	{
+		for (int32 X = FMath::Max(CenterX - Reach, 0); X <= FMath::Min(CenterX + Reach, Grid.SizeX - 1); X++)
+		{
+			const float Dist = FMath::Sqrt((float)FMath::Square(X - CenterX) + FMath::Square(Y - CenterY)) * Grid.CellSize;
+			const float Weight = 1.0f - Dist / StampRadius;
+			if (Weight > 0.0f)
+			{
+				Layer[Y * Grid.SizeX + X] += Sign * Weight;
+				MarkDirty(Y * Grid.SizeX + X);
+			}
+		}
+	}
+}
+
+void FShooterInfluenceWorkState::StampDanger(const FVector& Location, float Radius, float Amount)
+{
+	FShooterInfluenceGrid& Grid = *WriteGrid;
+	if (Radius <= 0.0f || Grid.CellSize <= 0.0f)
+	{
+		return;
+	}
+
+	const int32 MinX = FMath::Max(FMath::FloorToInt((Location.X - Radius - Grid.Origin.X) / Grid.CellSize), 0);
+	const int32 MinY = FMath::Max(FMath::FloorToInt((Location.Y - Radius - Grid.Origin.Y) / Grid.CellSize), 0);
+	const int32 MaxX = FMath::Min(FMath::FloorToInt((Location.X + Radius - Grid.Origin.X) / Grid.CellSize), Grid.SizeX - 1);
+	const int32 MaxY = FMath::Min(FMath::FloorToInt((Location.Y + Radius - Grid.Origin.Y) / Grid.CellSize), Grid.SizeY - 1);
+
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		for (int32 X = MinX; X <= MaxX; X++)
+		{
+			const FVector2D CellCenter = Grid.Origin + FVector2D(X + 0.5f, Y + 0.5f) * Grid.CellSize;
+			const float Weight = 1.0f - FVector2D::Distance(CellCenter, FVector2D(Location)) / Radius;
+			if (Weight > 0.0f)
+			{
+				const int32 CellIdx = Y * Grid.SizeX + X;
+				Grid.Danger[CellIdx] += Amount * Weight;
+				ActiveDangerCells.Add(CellIdx);
+				MarkDirty(CellIdx);
+			}
+		}
+	}
+}
+
+int32 FShooterInfluenceWorkState::GetLayer(int32 Team)
+{
+	FShooterInfluenceGrid& Grid = *WriteGrid;
+	int32 LayerIdx = Grid.LayerTeams.Find(Team);
+	if (LayerIdx == INDEX_NONE)
+	{
+		LayerIdx = Grid.LayerTeams.Add(Team);
+		Grid.Presence.AddDefaulted_GetRef().SetNumZeroed(Grid.SizeX * Grid.SizeY);
+	}
+	return LayerIdx;
+}
+
+void UShooterInfluenceMap::InitGrid(FShooterInfluenceGrid& Grid, float CellSize) const
+{
+	FBox Bounds(FVector(-20000.0f), FVector(20000.0f));
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+	if (NavData && NavData->GetBounds().IsValid)
+	{
+		Bounds = NavData->GetBounds();
+	}
+
+	Grid.CellSize = FMath::Max(CellSize, 50.0f);
+	Grid.Origin = FVector2D(Bounds.Min);
+	Grid.SizeX = FMath::Clamp(FMath::CeilToInt((Bounds.Max.X - Bounds.Min.X) / Grid.CellSize), 1, ShooterInfluenceMaxCells);
+	Grid.SizeY = FMath::Clamp(FMath::CeilToInt((Bounds.Max.Y - Bounds.Min.Y) / Grid.CellSize), 1, ShooterInfluenceMaxCells);
+	Grid.LayerTeams.Reset();
+	Grid.Presence.Reset();
+	Grid.Danger.Reset();
+	Grid.Danger.SetNumZeroed(Grid.SizeX * Grid.SizeY);
+}
+
+void UShooterInfluenceMap::GatherPawns(FShooterInfluenceInput& Input) const
+{
+	for (AShooterCharacter* Pawn : TActorRange<AShooterCharacter>(GetWorld()))
+	{
+		if (Pawn->IsAlive())
+		{
+			const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Pawn->GetPlayerState());
+			Input.Pawns.Add({ Pawn->GetUniqueID(), PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE, Pawn->GetActorLocation() });
+		}
+	}
+}
+
+bool UShooterInfluenceMap::IsRecording() const
+{
+	// clients never tick the map, events would pile up
+	const UWorld* World = GetWorld();
+	return World && World->GetNetMode() != NM_Client;
+}
+
+void UShooterInfluenceMap::AddDamageEvent(const FVector& Location, float Damage)
+{
+	if (IsRecording())
+	{
+		PendingDanger.Add({ Location, ShooterInfluenceHitRadius, Damage / 100.0f });
+	}
+}
+
+void UShooterInfluenceMap::AddExplosion(const FVector& Location, float Radius, float Damage)
+{
+	if (IsRecording())
+	{
+		PendingDanger.Add({ Location, Radius, Damage / 100.0f });
+	}
+}
+
+float UShooterInfluenceMap::GetThreat(const FVector& Location, int32 FriendlyTeam) const
+{
+	const FShooterInfluenceGrid& Grid = *ReadGrid;
+	const int32 CellIdx = Grid.GetCellIndex(Location);
+	float Threat = 0.0f;
+	if (CellIdx != INDEX_NONE)
+	{
+		for (int32 LayerIdx = 0; LayerIdx < Grid.LayerTeams.Num(); LayerIdx++)
+		{
+			if (FriendlyTeam == INDEX_NONE || Grid.LayerTeams[LayerIdx] != FriendlyTeam)
+			{
+				Threat += Grid.Presence[LayerIdx][CellIdx];
+			}
+		}
+	}
+	return Threat;
+}
+
+float UShooterInfluenceMap::GetDanger(const FVector& Location) const
+{
+	const FShooterInfluenceGrid& Grid = *ReadGrid;
+	const int32 CellIdx = Grid.GetCellIndex(Location);
+	return CellIdx != INDEX_NONE ? Grid.Danger[CellIdx] : 0.0f;
+}
+
+void UShooterInfluenceMap::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+
+	if (PendingUpdate.IsValid())
+	{
+		if (!PendingUpdate.IsReady())
+		{
+			return;
+		}
+
+		// worker is done, publish
+		PendingUpdate = TFuture<void>();
+		WorkState->Publish();
+		ReadGrid = WorkState->PublishedGrid;
+		NumUpdates++;
+		TotalUpdateTime += WorkState->LastUpdateTime;
+	}
+
+	DrawDebug();
+
+	if (TimeSinceUpdate < 1.0f / FMath::Max(CVar_ShooterInfluence_UpdateRate, 0.1f))
+	{
+		return;
+	}
+
+	if (!WorkState.IsValid() || WorkState->WriteGrid->CellSize != FMath::Max(CVar_ShooterInfluence_CellSize, 50.0f))
+	{
+		WorkState = MakeShared<FShooterInfluenceWorkState, ESPMode::ThreadSafe>();
+		InitGrid(*WorkState->WriteGrid, CVar_ShooterInfluence_CellSize);
+	}
+
+	FShooterInfluenceInput Input;
+	GatherPawns(Input);
+	Input.DangerEvents = MoveTemp(PendingDanger);
+	Input.DeltaTime = TimeSinceUpdate;
+	Input.PawnRadius = CVar_ShooterInfluence_PawnRadius;
+	Input.DangerHalfLife = CVar_ShooterInfluence_DangerHalfLife;
+	TimeSinceUpdate = 0.0f;
+
+	TSharedPtr<FShooterInfluenceWorkState, ESPMode::ThreadSafe> State = WorkState;
+	PendingUpdate = Async(EAsyncExecution::ThreadPool, [State, Input = MoveTemp(Input)]()
+	{
+		State->Update(Input);
+	});
+}
+
+void UShooterInfluenceMap::DrawDebug() const
+{
+#if ENABLE_DRAW_DEBUG
+	const APlayerController* PC = CVar_ShooterInfluence_Draw ? GetWorld()->GetFirstPlayerController() : NULL;
+	const APawn* ViewPawn = PC ? PC->GetPawn() : NULL;
+	if (ViewPawn == NULL)
+	{
+		return;
+	}
+
+	// grid is 2D, draw it at viewer's feet
+	const FShooterInfluenceGrid& Grid = *ReadGrid;
+	const float DrawZ = ViewPawn->GetActorLocation().Z - ViewPawn->GetDefaultHalfHeight();
+	const FVector HalfCell(Grid.CellSize * 0.45f, Grid.CellSize * 0.45f, 2.0f);
+
+	for (int32 CellIdx = 0; CellIdx < Grid.Danger.Num(); CellIdx++)
+	{
+		float Presence = 0.0f;
+		if (CVar_ShooterInfluence_Draw == 1)
+		{
+			for (const TArray<float>& Layer : Grid.Presence)
+			{
+				Presence += Layer[CellIdx];
+			}
+		}
+
+		const float Danger = Grid.Danger[CellIdx];
+		if (Presence > 0.05f || Danger > 0.05f)
+		{
+			const FVector2D Center = Grid.Origin + FVector2D((CellIdx % Grid.SizeX) + 0.5f, (CellIdx / Grid.SizeX) + 0.5f) * Grid.CellSize;
+			const FColor Color(FMath::Clamp(FMath::RoundToInt(Danger * 255.0f), 0, 255), 0, FMath::Clamp(FMath::RoundToInt(Presence * 128.0f), 0, 255), 96);
+			DrawDebugSolidBox(GetWorld(), FVector(Center, DrawZ), HalfCell, Color);
+		}
+	}
+#endif
+}
+
+void UShooterInfluenceMap::RunBenchmark(int32 NumIterations)
+{
+	FShooterInfluenceInput Input;
+	GatherPawns(Input);
+
+	// not enough pawns around, make some up
+	FRandomStream Random(1234);
+	FShooterInfluenceGrid BoundsGrid;
+	InitGrid(BoundsGrid, 1000.0f);
+	const FVector2D Extent = FVector2D(BoundsGrid.SizeX, BoundsGrid.SizeY) * BoundsGrid.CellSize;
+	for (int32 Idx = Input.Pawns.Num(); Idx < 64; Idx++)
+	{
+		const FVector Location(BoundsGrid.Origin.X + Random.FRand() * Extent.X, BoundsGrid.Origin.Y + Random.FRand() * Extent.Y, 0.0f);
+		Input.Pawns.Add({ (uint32)(MAX_uint32 - Idx), Idx % 2, Location });
+	}
+	Input.PawnRadius = CVar_ShooterInfluence_PawnRadius;
+	Input.DangerHalfLife = CVar_ShooterInfluence_DangerHalfLife;
+	Input.DeltaTime = 1.0f / FMath::Max(CVar_ShooterInfluence_UpdateRate, 0.1f);
+
+	for (const float CellSize : { 800.0f, 400.0f, 200.0f, 100.0f })
+	{
+		FShooterInfluenceWorkState State;
+		InitGrid(*State.WriteGrid, CellSize);
+
+		double StartTime = FPlatformTime::Seconds();
+		State.Update(Input);
+		const double FullTime = FPlatformTime::Seconds() - StartTime;
+
+		// pawns move a bit and some explosions go off every update
+		FShooterInfluenceInput StepInput = Input;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (FShooterInfluenceInput::FPawnSample& Pawn : StepInput.Pawns)
+			{
+				Pawn.Location += FVector(Random.FRandRange(-60.0f, 60.0f), Random.FRandRange(-60.0f, 60.0f), 0.0f);
+			}
+			StepInput.DangerEvents.Reset();
+			StepInput.DangerEvents.Add({ StepInput.Pawns[Iteration % StepInput.Pawns.Num()].Location, 300.0f, 0.8f });
+
+			// publish like Tick does, so catching up with the other grid is timed too
+			State.Publish();
+			State.Update(StepInput);
+		}
+		const double StepTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogShooter, Log, TEXT("Influence benchmark: cell %.0f, %dx%d cells, %d pawns: first update %.3f ms, incremental %.3f ms/update"),
+			CellSize, State.WriteGrid->SizeX, State.WriteGrid->SizeY, Input.Pawns.Num(), 1000.0 * FullTime, 1000.0 * StepTime / FMath::Max(NumIterations, 1));
+	}
+
+	if (NumUpdates > 0)
+	{
+		UE_LOG(LogShooter, Log, TEXT("Influence map: %d updates, %.3f ms/update on worker"), NumUpdates, 1000.0 * TotalUpdateTime / NumUpdates);
+	}
+}
+
+ETickableTickType UShooterInfluenceMap::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterInfluenceMap::IsTickable() const
+{
+	return IsRecording() && GetWorld()->IsGameWorld();
+}
+
+TStatId UShooterInfluenceMap::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterInfluenceMap, STATGROUP_Tickables);
+}
+
+UWorld* UShooterInfluenceMap::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterInfluenceMap::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ReadGrid = MakeShared<FShooterInfluenceGrid, ESPMode::ThreadSafe>();
+}
+
+void UShooterInfluenceMap::Deinitialize()
+{
+	if (PendingUpdate.IsValid())
+	{
+		PendingUpdate.Wait();
+	}
+	WorkState.Reset();
+	PendingDanger.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterInfluenceBenchmarkCmd(TEXT("ShooterInfluence.Benchmark"), TEXT("[server] Times influence map updates at cell sizes 800, 400, 200 and 100. Optional number of iterations."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterInfluenceMap* InfluenceMap = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterInfluenceMap>() : NULL;
+		if (InfluenceMap)
+		{
+			InfluenceMap->RunBenchmark(Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100);
+		}
+	})
+);
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterLOSService.h"
+
+int32 CVar_ShooterLOS_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterLOSEnable(TEXT("ShooterLOS.Enable"), CVar_ShooterLOS_Enable, TEXT("Cache bot line of sight and refresh it with async traces, 0 to trace on every request"), ECVF_Default );
+
+float CVar_ShooterLOS_TTL = 0.1f;
+static FAutoConsoleVariableRef CVarShooterLOSTTL(TEXT("ShooterLOS.TTL"), CVar_ShooterLOS_TTL, TEXT("Age in seconds after which a line of sight result is refreshed"), ECVF_Default );
+
+int32 CVar_ShooterLOS_AsyncTracesPerFrame = 16;
+static FAutoConsoleVariableRef CVarShooterLOSAsyncTracesPerFrame(TEXT("ShooterLOS.AsyncTracesPerFrame"), CVar_ShooterLOS_AsyncTracesPerFrame, TEXT("Max number of async line of sight traces issued per frame"), ECVF_Default );
+
+int32 CVar_ShooterLOS_SyncTracesPerFrame = 4;
+static FAutoConsoleVariableRef CVarShooterLOSSyncTracesPerFrame(TEXT("ShooterLOS.SyncTracesPerFrame"), CVar_ShooterLOS_SyncTracesPerFrame, TEXT("Max number of blocking traces per frame for requests without any cached result"), ECVF_Default );
+
+float CVar_ShooterLOS_TargetCellSize = 50.0f;
+static FAutoConsoleVariableRef CVarShooterLOSTargetCellSize(TEXT("ShooterLOS.TargetCellSize"), CVar_ShooterLOS_TargetCellSize, TEXT("Location targets closer than this share a cached result"), ECVF_Default );
+
+/** entries not requested for this long are dropped */
+static const float ShooterLOSEntryLifetime = 2.0f;
+
+const FShooterLOSResult* UShooterLOSService::RequestLOS(APawn* Querier, AActor* Target, const FVector& TargetLocation)
+{
+	UWorld* World = GetWorld();
+	if (Querier == NULL || World == NULL)
+	{
+		return NULL;
+	}
+
+	NumRequests++;
+
+	FShooterLOSKey Key;
+	Key.Querier = Querier;
+	Key.Target = Target;
+	if (Target == NULL)
+	{
+		const float CellSize = FMath::Max(CVar_ShooterLOS_TargetCellSize, 1.0f);
+		Key.TargetCell = FIntVector(FMath::FloorToInt(TargetLocation.X / CellSize), FMath::FloorToInt(TargetLocation.Y / CellSize), FMath::FloorToInt(TargetLocation.Z / CellSize));
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.TargetLocation = TargetLocation;
+	Entry.LastRequestTime = World->GetTimeSeconds();
+
+	const float Age = World->GetTimeSeconds() - Entry.Result.TraceTime;
+	if (CVar_ShooterLOS_Enable && Entry.bHasResult)
+	{
+		if (Age <= CVar_ShooterLOS_TTL)
+		{
+			NumCacheHits++;
+		}
+		else
+		{
+			// serve old result, fresh one will be ready in a frame or two
+			NumStaleHits++;
+			if (Entry.bPending)
+			{
+				NumCoalesced++;
+			}
+			else
+			{
+				Entry.bPending = true;
+				PendingKeys.Add(Key);
+			}
+		}
+
+		TotalResultAge += Age;
+		return &Entry.Result;
+	}
+
+	if (CVar_ShooterLOS_Enable && SyncTracesLeft <= 0)
+	{
+		// out of blocking traces this frame, queue it and report nothing yet
+		if (Entry.bPending)
+		{
+			NumCoalesced++;
+		}
+		else
+		{
+			Entry.bPending = true;
+			PendingKeys.Add(Key);
+		}
+		return NULL;
+	}
+
+	SyncTracesLeft--;
+	NumSyncTraces++;
+
+	FVector StartLocation, EndLocation;
+	GetTraceEnds(Querier, TargetLocation, StartLocation, EndLocation);
+
+	FHitResult Hit(ForceInit);
+	World->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, GetTraceParams(Querier));
+	StoreResult(Entry, &Hit, StartLocation, EndLocation);
+
+	return &Entry.Result;
+}
+
+void UShooterLOSService::GetTraceEnds(APawn* Querier, const FVector& TargetLocation, FVector& OutStart, FVector& OutEnd) const
+{
+	// same start as the uncached bot trace: actor location raised by BaseEyeHeight, not the view location
+	OutStart = Querier->GetActorLocation();
+	OutStart.Z += Querier->BaseEyeHeight;
+	OutEnd = TargetLocation;
+}
+
+FCollisionQueryParams UShooterLOSService::GetTraceParams(APawn* Querier) const
+{
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, Querier);
+	TraceParams.AddIgnoredActor(Querier->GetController());
+	return TraceParams;
+}
+
+void UShooterLOSService::StoreResult(FEntry& Entry, const FHitResult* Hit, const FVector& Start, const FVector& End)
+{
+	const bool bBlockingHit = Hit && Hit->bBlockingHit;
+
+	Entry.Result.bBlockingHit = bBlockingHit;
+	Entry.Result.HitActor = bBlockingHit ? Hit->GetActor() : NULL;
+	Entry.Result.HitDistSq = bBlockingHit ? (Hit->ImpactPoint - Start).SizeSquared() : 0.0f;
+	Entry.Result.TargetDistSq = (End - Start).SizeSquared();
+	Entry.Result.TraceTime = GetWorld()->GetTimeSeconds();
+	Entry.bHasResult = true;
+}
+
+void UShooterLOSService::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FShooterLOSKey Key;
+	if (!InFlight.RemoveAndCopyValue(Datum.UserData, Key))
+	{
+		return;
+	}
+
+	FEntry* Entry = Entries.Find(Key);
+	if (Entry)
+	{
+		const FHitResult* Hit = NULL;
+		for (const FHitResult& TestHit : Datum.OutHits)
+		{
+			if (TestHit.bBlockingHit)
+			{
+				Hit = &TestHit;
+				break;
+			}
+		}
+
+		StoreResult(*Entry, Hit, Datum.Start, Datum.End);
+		Entry->bPending = false;
+	}
+}
+
+void UShooterLOSService::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	SyncTracesLeft = CVar_ShooterLOS_SyncTracesPerFrame;
+
+	// drop entries nobody asks for anymore
+	const float Now = World->GetTimeSeconds();
+	for (TMap<FShooterLOSKey, FEntry>::TIterator It(Entries); It; ++It)
+	{
+		if (!It.Key().Querier.IsValid() || Now - It.Value().LastRequestTime > ShooterLOSEntryLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// issue queued traces within budget, oldest first
+	int32 NumIssued = 0;
+	int32 NumProcessed = 0;
+	for (; NumProcessed < PendingKeys.Num() && NumIssued < CVar_ShooterLOS_AsyncTracesPerFrame; NumProcessed++)
+	{
+		const FShooterLOSKey& Key = PendingKeys[NumProcessed];
+		FEntry* Entry = Entries.Find(Key);
+		APawn* Querier = Key.Querier.Get();
+		if (Entry == NULL || Querier == NULL)
+		{
+			continue;
+		}
+
+		FVector StartLocation, EndLocation;
+		GetTraceEnds(Querier, Entry->TargetLocation, StartLocation, EndLocation);
+
+		FTraceDelegate TraceDelegate;
+		TraceDelegate.BindUObject(this, &UShooterLOSService::OnTraceCompleted);
+
+		const uint32 TraceId = NextTraceId++;
+		InFlight.Add(TraceId, Key);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, EndLocation, COLLISION_WEAPON, GetTraceParams(Querier), FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+
+		NumIssued++;
+		NumAsyncTraces++;
+	}
+
+	PendingKeys.RemoveAt(0, NumProcessed, false);
+}
+
+ETickableTickType UShooterLOSService::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterLOSService::IsTickable() const
+{
+	// bots only run on server, clients never request anything
+	const UWorld* World = GetWorld();
+	return World && World->GetNetMode() != NM_Client;
+}
+
+TStatId UShooterLOSService::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterLOSService, STATGROUP_Tickables);
+}
+
+UWorld* UShooterLOSService::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterLOSService::DumpStats() const
+{
+	const int32 NumAnswered = NumCacheHits + NumStaleHits;
+	UE_LOG(LogShooter, Log, TEXT("LOS service: %d requests, %d cache hits, %d stale hits, %d coalesced, %d sync traces, %d async traces, avg result age %.3f s, %d entries, %d queued, %d in flight"),
+		NumRequests, NumCacheHits, NumStaleHits, NumCoalesced, NumSyncTraces, NumAsyncTraces, NumAnswered > 0 ? TotalResultAge / NumAnswered : 0.0,
+		Entries.Num(), PendingKeys.Num(), InFlight.Num());
+}
+
+void UShooterLOSService::ResetStats()
+{
+	NumRequests = 0;
+	NumCacheHits = 0;
+	NumStaleHits = 0;
+	NumCoalesced = 0;
+	NumSyncTraces = 0;
+	NumAsyncTraces = 0;
+	TotalResultAge = 0.0;
+}
+
+void UShooterLOSService::Deinitialize()
+{
+	Entries.Empty();
+	PendingKeys.Empty();
+	InFlight.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterLOSStatsCmd(TEXT("ShooterLOS.Stats"), TEXT("[server] Prints bot line of sight cache counters. Pass 'reset' to clear them."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterLOSService* LOSService = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterLOSService>() : NULL;
+		if (LOSService)
+		{
+			LOSService->DumpStats();
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				LOSService->ResetStats();
+			}
+		}
+	})
+);
@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterNavQueryService.h"
+#include "NavigationSystem.h"
+
+float CVar_ShooterNavQuery_BudgetMs = 0.5f;
+static FAutoConsoleVariableRef CVarShooterNavQueryBudgetMs(TEXT("ShooterNavQuery.BudgetMs"), CVar_ShooterNavQuery_BudgetMs, TEXT("Navmesh query time per frame in ms, at least one query runs every frame"), ECVF_Default );
+
+float CVar_ShooterNavQuery_CacheTime = 0.5f;
+static FAutoConsoleVariableRef CVarShooterNavQueryCacheTime(TEXT("ShooterNavQuery.CacheTime"), CVar_ShooterNavQuery_CacheTime, TEXT("Seconds a point near an enemy is reused by other bots"), ECVF_Default );
+
+/** number of direction sectors around enemy */
+static const int32 ShooterNavQueryNumSectors = 8;
+
+/** distance of search origin from enemy */
+static const float ShooterNavQueryApproachDistance = 600.0f;
+
+/** search radius around origin */
+static const float ShooterNavQuerySearchRadius = 200.0f;
+
+/** entries not requested for this long are dropped */
+static const float ShooterNavQueryEntryLifetime = 5.0f;
+
+EShooterNavQueryStatus::Type UShooterNavQueryService::RequestPointNearEnemy(AActor* Enemy, const FVector& QuerierLocation, FVector& OutLocation)
+{
+	if (Enemy == NULL)
+	{
+		return EShooterNavQueryStatus::Failed;
+	}
+
+	NumRequests++;
+
+	const FVector ToQuerier = QuerierLocation - Enemy->GetActorLocation();
+	const float Angle = FMath::Atan2(ToQuerier.Y, ToQuerier.X) + PI;
+
+	FShooterNavQueryKey Key;
+	Key.Enemy = Enemy;
+	Key.Sector = (uint8)(FMath::FloorToInt(Angle / (2.0f * PI) * ShooterNavQueryNumSectors) % ShooterNavQueryNumSectors);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.LastRequestTime = Now;
+
+	if (Entry.bHasResult && Now - Entry.QueryTime <= CVar_ShooterNavQuery_CacheTime)
+	{
+		NumCacheHits++;
+		OutLocation = Entry.Location;
+		return Entry.bSuccess ? EShooterNavQueryStatus::Succeeded : EShooterNavQueryStatus::Failed;
+	}
+
+	if (!Entry.bQueued)
+	{
+		Entry.bQueued = true;
+		PendingKeys.Add(Key);
+	}
+	return EShooterNavQueryStatus::Pending;
+}
+
+void UShooterNavQueryService::RunQuery(const FShooterNavQueryKey& Key, FEntry& Entry)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const AActor* Enemy = Key.Enemy.Get();
+
+	Entry.bSuccess = false;
+	if (NavSys && Enemy)
+	{
+		// search on the side of the sector, same distance as before
+		const float Angle = (Key.Sector + 0.5f) * (2.0f * PI / ShooterNavQueryNumSectors) - PI;
+		const FVector SearchOrigin = Enemy->GetActorLocation() + ShooterNavQueryApproachDistance * FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+
+		FNavLocation NavLocation;
+		Entry.bSuccess = NavSys->GetRandomReachablePointInRadius(SearchOrigin, ShooterNavQuerySearchRadius, NavLocation);
+		Entry.Location = NavLocation.Location;
+	}
+
+	Entry.bHasResult = true;
+	Entry.bQueued = false;
+	Entry.QueryTime = GetWorld()->GetTimeSeconds();
+	NumQueries++;
+}
+
+void UShooterNavQueryService::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (TMap<FShooterNavQueryKey, FEntry>::TIterator It(Entries); It; ++It)
+	{
+		if (!It.Key().Enemy.IsValid() || (!It.Value().bQueued && Now - It.Value().LastRequestTime > ShooterNavQueryEntryLifetime))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = CVar_ShooterNavQuery_BudgetMs * 0.001;
+
+	int32 NumProcessed = 0;
+	for (; NumProcessed < PendingKeys.Num(); NumProcessed++)
+	{
+		if (NumProcessed > 0 && FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			break;
+		}
+
+		FEntry* Entry = Entries.Find(PendingKeys[NumProcessed]);
+		if (Entry)
+		{
+			RunQuery(PendingKeys[NumProcessed], *Entry);
+		}
+	}
+	PendingKeys.RemoveAt(0, NumProcessed, false);
+
+	const double FrameQueryTime = FPlatformTime::Seconds() - StartTime;
+	TotalQueryTime += FrameQueryTime;
+	MaxFrameQueryTime = FMath::Max(MaxFrameQueryTime, FrameQueryTime);
+	NumFrames++;
+}
+
+ETickableTickType UShooterNavQueryService::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterNavQueryService::IsTickable() const
+{
+	return Entries.Num() > 0;
+}
+
+TStatId UShooterNavQueryService::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterNavQueryService, STATGROUP_Tickables);
+}
+
+UWorld* UShooterNavQueryService::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterNavQueryService::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Nav queries: %d requests, %d cache hits, %d queries, %d frames, %.3f ms/frame avg, %.3f ms max, %d queued"),
+		NumRequests, NumCacheHits, NumQueries, NumFrames, NumFrames > 0 ? 1000.0 * TotalQueryTime / NumFrames : 0.0, 1000.0 * MaxFrameQueryTime, PendingKeys.Num());
+}
+
+void UShooterNavQueryService::ResetStats()
+{
+	NumRequests = 0;
+	NumCacheHits = 0;
+	NumQueries = 0;
+	NumFrames = 0;
+	MaxFrameQueryTime = 0.0;
+	TotalQueryTime = 0.0;
+}
+
+void UShooterNavQueryService::Deinitialize()
+{
+	Entries.Empty();
+	PendingKeys.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterNavQueryStatsCmd(TEXT("ShooterNavQuery.Stats"), TEXT("[server] Prints bot navmesh query counters and time per frame. Pass 'reset' to clear them."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterNavQueryService* NavQueryService = World ? World->GetSubsystem<UShooterNavQueryService>() : NULL;
+		if (NavQueryService)
+		{
+			NavQueryService->DumpStats();
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				NavQueryService->ResetStats();
+			}
+		}
+	})
+);
@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterTacticalPointData.h"
+#include "Player/ShooterCharacterMovement.h"
+#include "NavigationSystem.h"
+
+UShooterTacticalPointData::UShooterTacticalPointData(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	PathCostScale = 10.0f;
+	Spacing = 400.0f;
+	MaxPathDistance = 4000.0f;
+}
+
+#if WITH_EDITOR
+
+/** more points than this make the tables too large, sampling is coarsened to fit */
+static const int32 TacticalBakeMaxPoints = 1024;
+
+/** vertical step when looking for navmesh on multiple floors */
+static const float TacticalBakeFloorStep = 300.0f;
+
+/** eye height used for visibility */
+static const float TacticalBakeEyeHeight = 150.0f;
+
+/** height of low cover */
+static const float TacticalBakeCoverHeight = 50.0f;
+
+/** how close an obstacle must be to count as cover */
+static const float TacticalBakeCoverDistance = 100.0f;
+
+/** height and reach of wall run probes */
+static const float TacticalBakeWallRunHeight = 90.0f;
+static const float TacticalBakeWallRunReach = 120.0f;
+
+/** wall must continue this far along run direction */
+static const float TacticalBakeWallRunLength = 300.0f;
+
+/** pairs further apart are never visible */
+static const float TacticalBakeMaxVisibilityDistance = 6000.0f;
+
+/** pairs further apart don't get path costs */
+static const float TacticalBakeMaxPathDistance = 4000.0f;
+
+/** max distance from cluster seed */
+static const float TacticalBakeClusterRadius = 1500.0f;
+
+bool UShooterTacticalPointData::Bake(UWorld* World, float InSpacing)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : NULL;
+	if (NavData == NULL)
+	{
+		return false;
+	}
+
+	Spacing = FMath::Max(InSpacing, 100.0f);
+	Points.Reset();
+
+	// sample navmesh on a grid, one point per floor
+	const FBox Bounds = NavData->GetBounds();
+	const FVector ProjectExtent(Spacing * 0.5f, Spacing * 0.5f, TacticalBakeFloorStep * 0.5f);
+	for (float X = Bounds.Min.X; X <= Bounds.Max.X; X += Spacing)
+	{
+		for (float Y = Bounds.Min.Y; Y <= Bounds.Max.Y; Y += Spacing)
+		{
+			for (float Z = Bounds.Min.Z; Z <= Bounds.Max.Z; Z += TacticalBakeFloorStep)
+			{
+				FNavLocation NavLocation;
+				if (NavSys->ProjectPointToNavigation(FVector(X, Y, Z), NavLocation, ProjectExtent, NavData))
+				{
+					const bool bDuplicate = Points.ContainsByPredicate([&NavLocation, this](const FShooterTacticalPoint& TestPoint)
+					{
+						return FVector::DistSquared(TestPoint.Location, NavLocation.Location) < FMath::Square(Spacing * 0.5f);
+					});
+					if (!bDuplicate)
+					{
+						FShooterTacticalPoint& Point = Points.AddDefaulted_GetRef();
+						Point.Location = NavLocation.Location;
+					}
+				}
+			}
+		}
+	}
+
+	// too many points, keep one per bucket and grow buckets until they fit so the whole map stays covered
+	if (Points.Num() > TacticalBakeMaxPoints)
+	{
+		const int32 NumSampled = Points.Num();
+		float BucketSize = Spacing;
+		while (Points.Num() > TacticalBakeMaxPoints)
+		{
+			BucketSize *= 1.25f;
+
+			TSet<FIntVector> Buckets;
+			TArray<FShooterTacticalPoint> Kept;
+			for (const FShooterTacticalPoint& Point : Points)
+			{
+				const FIntVector Bucket(FMath::FloorToInt(Point.Location.X / BucketSize), FMath::FloorToInt(Point.Location.Y / BucketSize), FMath::FloorToInt(Point.Location.Z / BucketSize));
+				bool bAlreadyInBucket = false;
+				Buckets.Add(Bucket, &bAlreadyInBucket);
+				if (!bAlreadyInBucket)
+				{
+					Kept.Add(Point);
+				}
+			}
+			Points = MoveTemp(Kept);
+		}
+
+		UE_LOG(LogShooter, Warning, TEXT("Tactical bake: %d points with spacing %.0f, downsampled to %d with spacing %.0f. Use larger spacing."), NumSampled, Spacing, Points.Num(), BucketSize);
+		Spacing = BucketSize;
+	}
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(TacticalBakeTrace), false);
+	const UShooterCharacterMovement* MovementCDO = GetDefault<UShooterCharacterMovement>();
+	const int32 NumDirections = 8;
+
+	// cover and wall run entries
+	for (FShooterTacticalPoint& Point : Points)
+	{
+		Point.Flags = 0;
+		for (int32 DirIdx = 0; DirIdx < NumDirections; DirIdx++)
+		{
+			const float Angle = DirIdx * 2.0f * PI / NumDirections;
+			const FVector Dir(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+
+			const FVector CoverStart = Point.Location + FVector(0.0f, 0.0f, TacticalBakeCoverHeight);
+			if (World->LineTraceTestByChannel(CoverStart, CoverStart + Dir * TacticalBakeCoverDistance, COLLISION_WEAPON, TraceParams))
+			{
+				Point.Flags |= EShooterTacticalPoint::Cover;
+
+				const FVector EyeStart = Point.Location + FVector(0.0f, 0.0f, TacticalBakeEyeHeight);
+				if (World->LineTraceTestByChannel(EyeStart, EyeStart + Dir * TacticalBakeCoverDistance, COLLISION_WEAPON, TraceParams))
+				{
+					Point.Flags |= EShooterTacticalPoint::FullCover;
+				}
+			}
+
+			FHitResult WallHit;
+			const FVector WallStart = Point.Location + FVector(0.0f, 0.0f, TacticalBakeWallRunHeight);
+			if ((Point.Flags & EShooterTacticalPoint::WallRunEntry) == 0
+				&& World->LineTraceSingleByChannel(WallHit, WallStart, WallStart + Dir * TacticalBakeWallRunReach, ECC_Pawn, TraceParams)
+				&& MovementCDO->CanSurfaceBeWallRan(WallHit.ImpactNormal))
+			{
+				// wall has to continue along either run direction
+				const FVector Along = FVector::CrossProduct(WallHit.ImpactNormal, FVector::UpVector).GetSafeNormal();
+				for (const float Sign : { 1.0f, -1.0f })
+				{
+					const FVector AlongStart = WallStart + Along * Sign * TacticalBakeWallRunLength;
+					if (World->LineTraceTestByChannel(AlongStart, AlongStart + Dir * TacticalBakeWallRunReach, ECC_Pawn, TraceParams))
+					{
+						Point.Flags |= EShooterTacticalPoint::WallRunEntry;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// pairwise visibility and path costs
+	const int32 NumPoints = Points.Num();
+	MaxPathDistance = TacticalBakeMaxPathDistance;
+	VisibilityBits.Reset();
+	VisibilityBits.SetNumZeroed((NumPoints * NumPoints + 31) / 32);
+	PathCosts.Reset();
+	PathCosts.Init(MAX_uint16, NumPoints * NumPoints);
+
+	TArray<int32> NumVisible;
+	NumVisible.SetNumZeroed(NumPoints);
+
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		PathCosts[i * NumPoints + i] = 0;
+
+		for (int32 j = i + 1; j < NumPoints; j++)
+		{
+			const FVector& From = Points[i].Location;
+			const FVector& To = Points[j].Location;
+			const float DistSq = FVector::DistSquared(From, To);
+
+			if (DistSq <= FMath::Square(TacticalBakeMaxVisibilityDistance)
+				&& !World->LineTraceTestByChannel(From + FVector(0.0f, 0.0f, TacticalBakeEyeHeight), To + FVector(0.0f, 0.0f, TacticalBakeEyeHeight), COLLISION_WEAPON, TraceParams))
+			{
+				const int32 BitIJ = i * NumPoints + j;
+				const int32 BitJI = j * NumPoints + i;
+				VisibilityBits[BitIJ >> 5] |= 1u << (BitIJ & 31);
+				VisibilityBits[BitJI >> 5] |= 1u << (BitJI & 31);
+				NumVisible[i]++;
+				NumVisible[j]++;
+			}
+
+			float PathCost = 0.0f;
+			if (DistSq <= FMath::Square(MaxPathDistance)
+				&& NavSys->GetPathCost(From, To, PathCost, NavData) == ENavigationQueryResult::Success)
+			{
+				const uint16 Quantized = (uint16)FMath::Min(FMath::CeilToInt(PathCost / PathCostScale), MAX_uint16 - 1);
+				PathCosts[i * NumPoints + j] = Quantized;
+				PathCosts[j * NumPoints + i] = Quantized;
+			}
+		}
+	}
+
+	// points seeing more than three quarters of all others are sightlines
+	TArray<int32> SortedVisible = NumVisible;
+	SortedVisible.Sort();
+	const int32 SightlineThreshold = NumPoints > 0 ? FMath::Max(SortedVisible[(NumPoints * 3) / 4], 1) : 0;
+
+	// greedy clusters, best seeing points become seeds
+	TArray<int32> Order;
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		Order.Add(i);
+		Points[i].Cluster = MAX_uint16;
+		if (NumVisible[i] >= SightlineThreshold)
+		{
+			Points[i].Flags |= EShooterTacticalPoint::Sightline;
+		}
+	}
+	Order.Sort([&NumVisible](int32 A, int32 B) { return NumVisible[A] > NumVisible[B]; });
+
+	uint16 NumClusters = 0;
+	for (int32 Seed : Order)
+	{
+		if (Points[Seed].Cluster != MAX_uint16)
+		{
+			continue;
+		}
+
+		Points[Seed].Cluster = NumClusters;
+		for (int32 j = 0; j < NumPoints; j++)
+		{
+			if (Points[j].Cluster == MAX_uint16 && IsVisible(Seed, j)
+				&& FVector::DistSquared(Points[Seed].Location, Points[j].Location) <= FMath::Square(TacticalBakeClusterRadius))
+			{
+				Points[j].Cluster = NumClusters;
+			}
+		}
+		NumClusters++;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Tactical bake: %d points, %d clusters, %d KB"), NumPoints, NumClusters,
+		(VisibilityBits.Num() * sizeof(uint32) + PathCosts.Num() * sizeof(uint16) + Points.Num() * sizeof(FShooterTacticalPoint)) / 1024);
+
+	return true;
+}
+
+#endif
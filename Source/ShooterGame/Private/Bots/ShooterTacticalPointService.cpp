@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterTacticalPointService.h"
+#include "Bots/ShooterTacticalPointData.h"
+#include "Bots/ShooterInfluenceMap.h"
+#if WITH_EDITOR
+#include "AssetRegistryModule.h"
+#endif
+
+/** path length over straight distance assumed for pairs without baked path cost */
+static const float TacticalPathEstimateScale = 1.5f;
+
+FString UShooterTacticalPointService::GetDataPackageName(UWorld* World)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName()));
+	return FString::Printf(TEXT("/Game/TacticalPoints/%s_TacticalPoints"), *MapName);
+}
+
+void UShooterTacticalPointService::LoadData()
+{
+	if (bLoadAttempted)
+	{
+		return;
+	}
+
+	bLoadAttempted = true;
+
+	const FString PackageName = GetDataPackageName(GetWorld());
+	if (FPackageName::DoesPackageExist(PackageName))
+	{
+		const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+		SetData(LoadObject<UShooterTacticalPointData>(NULL, *ObjectPath));
+	}
+}
+
+void UShooterTacticalPointService::SetData(UShooterTacticalPointData* InData)
+{
+	bLoadAttempted = true;
+	Data = InData;
+	Cells.Reset();
+
+	if (Data)
+	{
+		CellSize = Data->Spacing * 2.0f;
+		for (int32 Idx = 0; Idx < Data->Points.Num(); Idx++)
+		{
+			Cells.FindOrAdd(GetCellCoords(Data->Points[Idx].Location)).Add((uint16)Idx);
+		}
+	}
+}
+
+FIntPoint UShooterTacticalPointService::GetCellCoords(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+bool UShooterTacticalPointService::HasData()
+{
+	LoadData();
+	return Data != NULL && Data->Points.Num() > 0;
+}
+
+UShooterTacticalPointData* UShooterTacticalPointService::GetData()
+{
+	LoadData();
+	return Data;
+}
+
+int32 UShooterTacticalPointService::FindNearestPoint(const FVector& Location)
+{
+	if (!HasData())
+	{
+		return INDEX_NONE;
+	}
+
+	int32 BestIdx = INDEX_NONE;
+	float BestDistSq = MAX_FLT;
+
+	const FIntPoint Center = GetCellCoords(Location);
+	for (int32 X = Center.X - 1; X <= Center.X + 1; X++)
+	{
+		for (int32 Y = Center.Y - 1; Y <= Center.Y + 1; Y++)
+		{
+			const TArray<uint16>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (Cell)
+			{
+				for (uint16 Idx : *Cell)
+				{
+					const float DistSq = FVector::DistSquared(Data->Points[Idx].Location, Location);
+					if (DistSq < BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestIdx = Idx;
+					}
+				}
+			}
+		}
+	}
+
+	return BestIdx;
+}
+
+bool UShooterTacticalPointService::FindTacticalPoint(const FShooterTacticalQuery& Query, FVector& OutLocation)
+{
+	const int32 QuerierIdx = FindNearestPoint(Query.QuerierLocation);
+	const int32 EnemyIdx = FindNearestPoint(Query.EnemyLocation);
+	if (QuerierIdx == INDEX_NONE || EnemyIdx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const float MinDistSq = FMath::Square(Query.MinEnemyDistance);
+	const float MaxDistSq = FMath::Square(Query.MaxEnemyDistance);
+	const FIntPoint QueryMin = GetCellCoords(Query.EnemyLocation - FVector(Query.MaxEnemyDistance));
+	const FIntPoint QueryMax = GetCellCoords(Query.EnemyLocation + FVector(Query.MaxEnemyDistance));
+
+	const UShooterInfluenceMap* InfluenceMap = (Query.ThreatCost > 0.0f || Query.DangerCost > 0.0f) ? GetWorld()->GetSubsystem<UShooterInfluenceMap>() : NULL;
+
+	int32 BestIdx = INDEX_NONE;
+	float BestCost = MAX_FLT;
+	int32 NumEstimated = 0;
+
+	for (int32 X = QueryMin.X; X <= QueryMax.X; X++)
+	{
+		for (int32 Y = QueryMin.Y; Y <= QueryMax.Y; Y++)
+		{
+			const TArray<uint16>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (Cell == NULL)
+			{
+				continue;
+			}
+
+			for (uint16 Idx : *Cell)
+			{
+				const FShooterTacticalPoint& Point = Data->Points[Idx];
+				const float DistSq = FVector::DistSquared(Point.Location, Query.EnemyLocation);
+				if ((Point.Flags & Query.RequiredFlags) != Query.RequiredFlags || DistSq < MinDistSq || DistSq > MaxDistSq)
+				{
+					continue;
+				}
+
+				if ((Query.Visibility == EShooterTacticalVisibility::Visible && !Data->IsVisible(EnemyIdx, Idx))
+					|| (Query.Visibility == EShooterTacticalVisibility::Hidden && Data->IsVisible(EnemyIdx, Idx)))
+				{
+					continue;
+				}
+
+				float Cost = Data->GetPathCost(QuerierIdx, Idx);
+				if (Cost == MAX_FLT && !Data->HasBakedPathCost(QuerierIdx, Idx))
+				{
+					Cost = FVector::Dist(Data->Points[QuerierIdx].Location, Point.Location) * TacticalPathEstimateScale;
+					NumEstimated++;
+				}
+
+				// avoid points near other enemies and where people were just hit
+				if (InfluenceMap && Cost < MAX_FLT)
+				{
+					Cost += Query.ThreatCost * InfluenceMap->GetThreat(Point.Location, Query.FriendlyTeam) + Query.DangerCost * InfluenceMap->GetDanger(Point.Location);
+				}
+
+				if (Cost < BestCost)
+				{
+					BestCost = Cost;
+					BestIdx = Idx;
+				}
+			}
+		}
+	}
+
+	if (NumEstimated > 0)
+	{
+		UE_LOG(LogShooter, Verbose, TEXT("Tactical query: %d candidates beyond baked path distance %.0f, used distance estimate"), NumEstimated, Data->MaxPathDistance);
+	}
+
+	if (BestIdx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutLocation = Data->Points[BestIdx].Location;
+	return true;
+}
+
+void UShooterTacticalPointService::Deinitialize()
+{
+	Data = NULL;
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+#if WITH_EDITOR
+FAutoConsoleCommandWithWorldAndArgs ShooterTacticalBakeCmd(TEXT("ShooterTactical.Bake"), TEXT("[editor] Bakes tactical points of current map to /Game/TacticalPoints. Optional point spacing, default 400."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterTacticalPointService* TacticalService = World ? World->GetSubsystem<UShooterTacticalPointService>() : NULL;
+		if (TacticalService == NULL)
+		{
+			return;
+		}
+
+		const float Spacing = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 400.0f;
+		const FString PackageName = UShooterTacticalPointService::GetDataPackageName(World);
+
+		UPackage* Package = CreatePackage(*PackageName);
+		UShooterTacticalPointData* Data = NewObject<UShooterTacticalPointData>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+		if (!Data->Bake(World, Spacing))
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Tactical bake: %s has no navmesh"), *World->GetMapName());
+			return;
+		}
+
+		FAssetRegistryModule::AssetCreated(Data);
+		Package->MarkPackageDirty();
+
+		const FString FileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+		if (UPackage::SavePackage(Package, Data, RF_Public | RF_Standalone, *FileName))
+		{
+			UE_LOG(LogShooter, Log, TEXT("Tactical bake: saved %s"), *FileName);
+		}
+
+		TacticalService->SetData(Data);
+	})
+);
+#endif
@@ -0,0 +1,210 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterDecalManager.h"
+#include "Components/DecalComponent.h"
+#include "ShooterGameUserSettings.h"
+
+float CVar_ShooterDecals_MergeRadius = 4.0f;
+static FAutoConsoleVariableRef CVarShooterDecalsMergeRadius(TEXT("ShooterDecals.MergeRadius"), CVar_ShooterDecals_MergeRadius, TEXT("Decals landing closer than this to a visible decal on the same component refresh it instead of using a new slot. 0: Disable merging"), ECVF_Default );
+
+/** how often expired decals are hidden */
+static const float DecalExpireInterval = 0.5f;
+
+void UShooterDecalManager::SpawnDecal(const FDecalData& Decal, const FVector& DecalSize, const FHitResult& SurfaceHit)
+{
+	UPrimitiveComponent* HitComponent = SurfaceHit.Component.Get();
+	UWorld* World = GetWorld();
+	if (Decal.DecalMaterial == NULL || HitComponent == NULL || World == NULL)
+	{
+		return;
+	}
+
+	const UShooterGameUserSettings* UserSettings = GEngine ? Cast<UShooterGameUserSettings>(GEngine->GetGameUserSettings()) : NULL;
+	const int32 Budget = UserSettings ? UserSettings->GetDecalBudget() : 64;
+	if (Budget <= 0)
+	{
+		return;
+	}
+
+	const float ExpireTime = Decal.LifeSpan > 0.0f ? World->GetTimeSeconds() + Decal.LifeSpan : MAX_FLT;
+
+	FShooterDecalRing& Ring = Rings.FindOrAdd(Decal.DecalMaterial);
+	TrimRing(Ring, Budget);
+
+	if (MergeDecal(Ring, SurfaceHit, ExpireTime))
+	{
+		++NumMergedDecals;
+		return;
+	}
+
+	FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
+	RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
+
+	FShooterDecalSlot* Slot = NULL;
+	if (Ring.Slots.Num() < Budget)
+	{
+		Slot = &Ring.Slots[Ring.Slots.AddDefaulted()];
+	}
+	else
+	{
+		// full, overwrite the oldest one
+		Slot = &Ring.Slots[Ring.Head];
+		Ring.Head = (Ring.Head + 1) % Ring.Slots.Num();
+	}
+
+	// component dies with the actor it was created for, recreate it
+	if (Slot->Decal == NULL || Slot->Decal->IsPendingKill())
+	{
+		Slot->Decal = UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, DecalSize,
+			HitComponent, SurfaceHit.BoneName,
+			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition, 0.0f);
+	}
+	else
+	{
+		Slot->Decal->AttachToComponent(HitComponent, FAttachmentTransformRules::KeepWorldTransform, SurfaceHit.BoneName);
+		Slot->Decal->SetWorldLocationAndRotation(SurfaceHit.ImpactPoint, RandomDecalRotation);
+		Slot->Decal->DecalSize = DecalSize;
+		Slot->Decal->SetVisibility(true);
+		Slot->Decal->MarkRenderStateDirty();
+	}
+
+	Slot->ExpireTime = Slot->Decal ? ExpireTime : 0.0f;
+
+	if (!World->GetTimerManager().IsTimerActive(TimerHandle_HideExpiredDecals))
+	{
+		World->GetTimerManager().SetTimer(TimerHandle_HideExpiredDecals, this, &UShooterDecalManager::HideExpiredDecals, DecalExpireInterval, true);
+	}
+}
+
+bool UShooterDecalManager::MergeDecal(FShooterDecalRing& Ring, const FHitResult& SurfaceHit, float ExpireTime) const
+{
+	const float MergeRadiusSq = FMath::Square(CVar_ShooterDecals_MergeRadius);
+	if (MergeRadiusSq <= 0.0f)
+	{
+		return false;
+	}
+
+	for (FShooterDecalSlot& Slot : Ring.Slots)
+	{
+		if (Slot.ExpireTime > 0.0f && Slot.Decal && !Slot.Decal->IsPendingKill() &&
+			Slot.Decal->GetAttachParent() == SurfaceHit.Component.Get() &&
+			FVector::DistSquared(Slot.Decal->GetComponentLocation(), SurfaceHit.ImpactPoint) < MergeRadiusSq)
+		{
+			Slot.ExpireTime = FMath::Max(Slot.ExpireTime, ExpireTime);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UShooterDecalManager::TrimRing(FShooterDecalRing& Ring, int32 Budget) const
+{
+	while (Ring.Slots.Num() > Budget)
+	{
+		const int32 OldestIdx = Ring.Head % Ring.Slots.Num();
+		if (Ring.Slots[OldestIdx].Decal)
+		{
+			Ring.Slots[OldestIdx].Decal->DestroyComponent();
+		}
+
+		Ring.Slots.RemoveAt(OldestIdx, 1, false);
+		Ring.Head = Ring.Slots.Num() > 0 ? OldestIdx % Ring.Slots.Num() : 0;
+	}
+}
+
+void UShooterDecalManager::HideExpiredDecals()
+{
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	int32 NumVisible = 0;
+
+	for (TPair<UMaterialInterface*, FShooterDecalRing>& It : Rings)
+	{
+		for (FShooterDecalSlot& Slot : It.Value.Slots)
+		{
+			if (Slot.ExpireTime > 0.0f && Slot.ExpireTime <= TimeSeconds)
+			{
+				if (Slot.Decal && !Slot.Decal->IsPendingKill())
+				{
+					Slot.Decal->SetVisibility(false);
+				}
+				Slot.ExpireTime = 0.0f;
+			}
+
+			NumVisible += (Slot.ExpireTime > 0.0f) ? 1 : 0;
+		}
+	}
+
+	// nothing left to expire, restart on next decal
+	if (NumVisible == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_HideExpiredDecals);
+	}
+}
+
+int32 UShooterDecalManager::GetNumVisibleDecals() const
+{
+	int32 NumVisible = 0;
+	for (const TPair<UMaterialInterface*, FShooterDecalRing>& It : Rings)
+	{
+		for (const FShooterDecalSlot& Slot : It.Value.Slots)
+		{
+			NumVisible += (Slot.ExpireTime > 0.0f && Slot.Decal && !Slot.Decal->IsPendingKill()) ? 1 : 0;
+		}
+	}
+
+	return NumVisible;
+}
+
+int32 UShooterDecalManager::GetNumDecalComponents() const
+{
+	int32 NumComponents = 0;
+	for (const TPair<UMaterialInterface*, FShooterDecalRing>& It : Rings)
+	{
+		for (const FShooterDecalSlot& Slot : It.Value.Slots)
+		{
+			NumComponents += (Slot.Decal && !Slot.Decal->IsPendingKill()) ? 1 : 0;
+		}
+	}
+
+	return NumComponents;
+}
+
+int32 UShooterDecalManager::GetNumMergedDecals() const
+{
+	return NumMergedDecals;
+}
+
+bool UShooterDecalManager::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// decals are purely cosmetic
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UShooterDecalManager::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_HideExpiredDecals);
+	}
+
+	Rings.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterDecalsStatsCmd(TEXT("ShooterDecals.Stats"), TEXT("Prints number of visible and allocated decals and current budget."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterDecalManager* DecalManager = World ? World->GetSubsystem<UShooterDecalManager>() : NULL;
+		const UShooterGameUserSettings* UserSettings = GEngine ? Cast<UShooterGameUserSettings>(GEngine->GetGameUserSettings()) : NULL;
+		if (DecalManager)
+		{
+			UE_LOG(LogShooter, Log, TEXT("Decals: %d visible, %d components, %d merged, budget %d per material"),
+				DecalManager->GetNumVisibleDecals(), DecalManager->GetNumDecalComponents(), DecalManager->GetNumMergedDecals(),
+				UserSettings ? UserSettings->GetDecalBudget() : 0);
+		}
+	})
+);
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterExplosionEffect.h"
+#include "Effects/ShooterDecalManager.h"
 
 AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -37,13 +38,11 @@ void AShooterExplosionEffect::BeginPlay()
 
 	if (Decal.DecalMaterial)
 	{
-		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
-		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
-
-		UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
-			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			Decal.LifeSpan);
+		UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>();
+		if (DecalManager)
+		{
+			DecalManager->SpawnDecal(Decal, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f), SurfaceHit);
+		}
 	}
 }
 
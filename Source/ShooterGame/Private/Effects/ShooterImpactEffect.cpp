@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterImpactEffect.h"
+#include "Effects/ShooterDecalManager.h"
 
 AShooterImpactEffect::AShooterImpactEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -31,13 +32,11 @@ void AShooterImpactEffect::PostInitializeComponents()
 
 	if (DefaultDecal.DecalMaterial)
 	{
-		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
-		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
-
-		UGameplayStatics::SpawnDecalAttached(DefaultDecal.DecalMaterial, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize),
-			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
-			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
-			DefaultDecal.LifeSpan);
+		UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>();
+		if (DecalManager)
+		{
+			DecalManager->SpawnDecal(DefaultDecal, FVector(1.0f, DefaultDecal.DecalSize, DefaultDecal.DecalSize), SurfaceHit);
+		}
 	}
 }
 
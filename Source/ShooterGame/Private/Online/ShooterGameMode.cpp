@@ -10,6 +10,17 @@
 #include "Online/ShooterGameSession.h"
 #include "Bots/ShooterAIController.h"
 #include "ShooterTeamStart.h"
+#include "Online/ShooterSpawnService.h"
+#include "Online/ShooterSpawnScorer.h"
+#include "Player/ShooterPawnPool.h"
+#include "Online/ShooterTelemetry.h"
+
+int32 CVar_ShooterGame_SoftReset = 1;
+static FAutoConsoleVariableRef CVarShooterGameSoftReset(TEXT("ShooterGame.SoftReset"), CVar_ShooterGame_SoftReset, TEXT("Restart match in place on dedicated servers instead of reloading map"), ECVF_Default );
+
+/** when last match ended and when restart began, kept across map reloads */
+static double GLastMatchEndTime = 0.0;
+static double GMatchRestartTime = 0.0;
 
 
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -29,6 +40,10 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 
 	MinRespawnDelay = 5.0f;
 
+	RulesName = TEXT("FreeForAll");
+	WinnerPlayerState = NULL;
+	WinnerTeam = 0;
+
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
 	bUseSeamlessTravel = FParse::Param(FCommandLine::Get(), TEXT("NoSeamlessTravel")) ? false : true;
@@ -41,6 +56,20 @@ void AShooterGameMode::PostInitProperties()
 	{
 		PlayerControllerClass = PlatformPlayerControllerClass;
 	}
+
+	// default object answers rule queries before a game is initialized
+	CompileRules(RulesName);
+}
+
+void AShooterGameMode::CompileRules(FName Name)
+{
+	const FShooterGameRuleSet* RuleSet = UShooterGameRules::FindRuleSet(Name);
+	if (RuleSet == NULL)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Game rules %s not found, using defaults"), *Name.ToString());
+	}
+
+	Rules.Compile(RuleSet ? *RuleSet : FShooterGameRuleSet());
 }
 
 FString AShooterGameMode::GetBotsCountOptionName()
@@ -54,6 +83,10 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	// players are put on teams on login, before match starts
+	const FString RulesOption = UGameplayStatics::ParseOption(Options, TEXT("Rules"));
+	CompileRules(RulesOption.IsEmpty() ? RulesName : FName(*RulesOption));
+
 	const UGameInstance* GameInstance = GetGameInstance();
 	if (GameInstance && Cast<UShooterGameInstance>(GameInstance)->GetOnlineMode() != EOnlineMode::Offline)
 	{
@@ -61,6 +94,17 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	}
 }
 
+void AShooterGameMode::InitGameState()
+{
+	Super::InitGameState();
+
+	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
+	if (MyGameState)
+	{
+		MyGameState->NumTeams = Rules.NumTeams;
+	}
+}
+
 void AShooterGameMode::SetAllowBots(bool bInAllowBots, int32 InMaxBots)
 {
 	bAllowBots = bInAllowBots;
@@ -161,6 +205,14 @@ void AShooterGameMode::HandleMatchIsWaitingToStart()
 
 void AShooterGameMode::HandleMatchHasStarted()
 {
+	if (GLastMatchEndTime > 0.0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		UE_LOG(LogShooter, Log, TEXT("Time between matches: %.2f s, %.2f s of it restarting (%s)"), Now - GLastMatchEndTime, Now - GMatchRestartTime,
+			CVar_ShooterGame_SoftReset > 0 && GetNetMode() == NM_DedicatedServer ? TEXT("soft reset") : TEXT("map reload"));
+		GLastMatchEndTime = 0.0;
+	}
+
 	bNeedsBotCreation = true;
 	Super::HandleMatchHasStarted();
 
@@ -168,6 +220,11 @@ void AShooterGameMode::HandleMatchHasStarted()
 	MyGameState->RemainingTime = RoundTime;	
 	StartBots();	
 
+	if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+	{
+		Telemetry->Record(EShooterTelemetryEvent::MatchStart, 0, NULL, NULL, MyGameState->PlayerArray.Num(), FVector::ZeroVector);
+	}
+
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 	{
@@ -192,6 +249,11 @@ void AShooterGameMode::FinishMatch()
 		EndMatch();
 		DetermineMatchWinner();		
 
+		if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+		{
+			Telemetry->Record(EShooterTelemetryEvent::MatchEnd, 0, NULL, NULL, MyGameState->PlayerArray.Num(), FVector::ZeroVector);
+		}
+
 		// notify players
 		for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 		{
@@ -211,6 +273,7 @@ void AShooterGameMode::FinishMatch()
 
 		// set up to restart the match
 		MyGameState->RemainingTime = TimeBetweenMatches;
+		GLastMatchEndTime = FPlatformTime::Seconds();
 	}
 }
 
@@ -254,12 +317,74 @@ void AShooterGameMode::RequestFinishAndExitToMainMenu()
 
 void AShooterGameMode::DetermineMatchWinner()
 {
-	// nothing to do here
+	AShooterGameState const* const MyGameState = CastChecked<AShooterGameState>(GameState);
+	WinnerPlayerState = NULL;
+	WinnerTeam = Rules.NumTeams;
+
+	if (Rules.WinCondition == EShooterWinCondition::BestPlayer)
+	{
+		float BestScore = MIN_flt;
+		int32 BestPlayer = -1;
+		int32 NumBestPlayers = 0;
+
+		for (int32 i = 0; i < MyGameState->PlayerArray.Num(); i++)
+		{
+			const float PlayerScore = MyGameState->PlayerArray[i]->GetScore();
+			if (BestScore < PlayerScore)
+			{
+				BestScore = PlayerScore;
+				BestPlayer = i;
+				NumBestPlayers = 1;
+			}
+			else if (BestScore == PlayerScore)
+			{
+				NumBestPlayers++;
+			}
+		}
+
+		WinnerPlayerState = (NumBestPlayers == 1) ? Cast<AShooterPlayerState>(MyGameState->PlayerArray[BestPlayer]) : NULL;
+	}
+	else if (Rules.WinCondition == EShooterWinCondition::BestTeam)
+	{
+		int32 BestScore = MIN_int32;
+		int32 BestTeam = -1;
+		int32 NumBestTeams = 1;
+
+		for (int32 i = 0; i < MyGameState->TeamScores.Num(); i++)
+		{
+			const int32 TeamScore = MyGameState->TeamScores[i];
+			if (BestScore < TeamScore)
+			{
+				BestScore = TeamScore;
+				BestTeam = i;
+				NumBestTeams = 1;
+			}
+			else if (BestScore == TeamScore)
+			{
+				NumBestTeams++;
+			}
+		}
+
+		WinnerTeam = (NumBestTeams == 1) ? BestTeam : Rules.NumTeams;
+	}
 }
 
 bool AShooterGameMode::IsWinner(class AShooterPlayerState* PlayerState) const
 {
-	return false;
+	if (PlayerState == NULL || PlayerState->IsQuitter())
+	{
+		return false;
+	}
+
+	switch (Rules.WinCondition)
+	{
+	case EShooterWinCondition::BestPlayer:
+		return PlayerState == WinnerPlayerState;
+	case EShooterWinCondition::BestTeam:
+		return PlayerState->GetTeamNum() == WinnerTeam;
+	default:
+		return false;
+	}
 }
 
 void AShooterGameMode::PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage)
@@ -280,6 +405,13 @@ void AShooterGameMode::PreLogin(const FString& Options, const FString& Address,
 
 void AShooterGameMode::PostLogin(APlayerController* NewPlayer)
 {
+	// Place player on a team before Super (VoIP team based init, findplayerstart, etc)
+	if (IsTeamGame())
+	{
+		AShooterPlayerState* NewPlayerState = CastChecked<AShooterPlayerState>(NewPlayer->PlayerState);
+		NewPlayerState->SetTeamNum(ChooseTeam(NewPlayerState));
+	}
+
 	Super::PostLogin(NewPlayer);
 
 	// update spectator location for client
@@ -302,48 +434,75 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 	AShooterPlayerState* KillerPlayerState = Killer ? Cast<AShooterPlayerState>(Killer->PlayerState) : NULL;
 	AShooterPlayerState* VictimPlayerState = KilledPlayer ? Cast<AShooterPlayerState>(KilledPlayer->PlayerState) : NULL;
 
+	const bool bKillFeedBatched = AShooterGameState::IsKillFeedBatched();
+
+	// no killer scores as a death by an enemy
+	const EShooterRuleRelation::Type Relation = (KillerPlayerState && VictimPlayerState) ? GetRelation(KillerPlayerState, VictimPlayerState) : EShooterRuleRelation::Enemy;
+
 	if (KillerPlayerState && KillerPlayerState != VictimPlayerState)
 	{
-		KillerPlayerState->ScoreKill(VictimPlayerState, KillScore);
-		KillerPlayerState->InformAboutKill(KillerPlayerState, DamageType, VictimPlayerState);
+		KillerPlayerState->ScoreKill(VictimPlayerState, Rules.KillerScore[Relation]);
+		if (!bKillFeedBatched)
+		{
+			KillerPlayerState->InformAboutKill(KillerPlayerState, DamageType, VictimPlayerState);
+		}
 	}
 
 	if (VictimPlayerState)
 	{
-		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
-		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
+		VictimPlayerState->ScoreDeath(KillerPlayerState, Rules.VictimScore[Relation]);
+		if (!bKillFeedBatched)
+		{
+			VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
+		}
 	}
-}
 
-float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const
-{
-	float ActualDamage = Damage;
+	AShooterGameState* const MyGameState = GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->NotifyKill(KillerPlayerState, VictimPlayerState, DamageType);
+	}
 
-	AShooterCharacter* DamagedPawn = Cast<AShooterCharacter>(DamagedActor);
-	if (DamagedPawn && EventInstigator)
+	if (KilledPawn)
 	{
-		AShooterPlayerState* DamagedPlayerState = Cast<AShooterPlayerState>(DamagedPawn->GetPlayerState());
-		AShooterPlayerState* InstigatorPlayerState = Cast<AShooterPlayerState>(EventInstigator->PlayerState);
+		GetWorld()->GetSubsystem<UShooterSpawnScorer>()->AddKill(KilledPawn->GetActorLocation());
+	}
 
-		// disable friendly fire
-		if (!CanDealDamage(InstigatorPlayerState, DamagedPlayerState))
-		{
-			ActualDamage = 0.0f;
-		}
+	if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+	{
+		const APawn* KillerPawn = Killer ? Killer->GetPawn() : NULL;
+		const FVector KilledLocation = KilledPawn ? KilledPawn->GetActorLocation() : FVector::ZeroVector;
+		Telemetry->Record(EShooterTelemetryEvent::Kill, 0, KillerPlayerState, VictimPlayerState, (KillerPawn && KilledPawn) ? FVector::Dist(KillerPawn->GetActorLocation(), KilledLocation) : 0.0f, KilledLocation);
+	}
+}
 
-		// scale self instigated damage
-		if (InstigatorPlayerState == DamagedPlayerState)
-		{
-			ActualDamage *= DamageSelfScale;
-		}
+float AShooterGameMode::ModifyDamage(float Damage, const AShooterCharacter* DamagedPawn, AController* EventInstigator) const
+{
+	const AShooterPlayerState* DamagedPlayerState = EventInstigator ? DamagedPawn->GetPlayerState<AShooterPlayerState>() : NULL;
+	const AShooterPlayerState* InstigatorPlayerState = EventInstigator ? EventInstigator->GetPlayerState<AShooterPlayerState>() : NULL;
+	if (DamagedPlayerState && InstigatorPlayerState)
+	{
+		// scales self instigated damage and friendly fire
+		return Damage * Rules.DamageScale[GetRelation(InstigatorPlayerState, DamagedPlayerState)];
 	}
 
-	return ActualDamage;
+	// team of either side is unknown, team games don't risk friendly fire
+	if (EventInstigator && IsTeamGame())
+	{
+		return 0.0f;
+	}
+
+	return Damage;
 }
 
-bool AShooterGameMode::CanDealDamage(class AShooterPlayerState* DamageInstigator, class AShooterPlayerState* DamagedPlayer) const
+EShooterRuleRelation::Type AShooterGameMode::GetRelation(const AShooterPlayerState* DamageInstigator, const AShooterPlayerState* DamagedPlayer) const
 {
-	return true;
+	return Rules.GetRelation(DamageInstigator == DamagedPlayer, DamageInstigator->GetTeamNum(), DamagedPlayer->GetTeamNum());
+}
+
+bool AShooterGameMode::CanDealDamage(const AShooterPlayerState* DamageInstigator, const AShooterPlayerState* DamagedPlayer) const
+{
+	return DamageInstigator && DamagedPlayer && Rules.DamageScale[GetRelation(DamageInstigator, DamagedPlayer)] > 0.0f;
 }
 
 bool AShooterGameMode::AllowCheats(APlayerController* P)
@@ -368,8 +527,22 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController_Implementation(AContr
 
 void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 {
+	const double StartTime = FPlatformTime::Seconds();
+
 	Super::RestartPlayer(NewPlayer);
 
+	if (NewPlayer && NewPlayer->GetPawn())
+	{
+		UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+		if (PawnPool)
+		{
+			PawnPool->RecordRespawn(FPlatformTime::Seconds() - StartTime);
+		}
+
+		// pawns spawned this frame aren't in occupancy grid yet
+		GetWorld()->GetSubsystem<UShooterSpawnService>()->MarkOccupied(NewPlayer->GetPawn());
+	}
+
 	AShooterPlayerController* PC = Cast<AShooterPlayerController>(NewPlayer);
 	if (PC)
 	{
@@ -384,22 +557,44 @@ void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 	}
 }
 
+APawn* AShooterGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+	APawn* PooledPawn = PawnPool ? PawnPool->Acquire(GetDefaultPawnClassForController(NewPlayer), SpawnTransform) : NULL;
+	return PooledPawn ? PooledPawn : Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
 AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
 {
-	TArray<APlayerStart*> PreferredSpawns;
-	TArray<APlayerStart*> FallbackSpawns;
+	UShooterSpawnService* SpawnService = GetWorld()->GetSubsystem<UShooterSpawnService>();
+
+	// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
+	APlayerStart* BestStart = SpawnService->GetPlayInEditorStart();
 
-	APlayerStart* BestStart = NULL;
-	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	// safest start first, usually the first one is allowed and free
+	const AShooterPlayerState* PlayerState = Player ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+	const int32 FriendlyTeam = (PlayerState && IsTeamGame()) ? PlayerState->GetTeamNum() : INDEX_NONE;
+	const TArray<uint16>* RankedStarts = BestStart ? NULL : GetWorld()->GetSubsystem<UShooterSpawnScorer>()->GetRankedStarts(FriendlyTeam);
+	if (RankedStarts)
 	{
-		APlayerStart* TestSpawn = *It;
-		if (TestSpawn->IsA<APlayerStartPIE>())
+		const TArray<AShooterTeamStart*>& AllStarts = SpawnService->GetAllStarts();
+		for (const uint16 StartIdx : *RankedStarts)
 		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
+			AShooterTeamStart* TestSpawn = AllStarts.IsValidIndex(StartIdx) ? AllStarts[StartIdx] : NULL;
+			if (TestSpawn && IsSpawnpointAllowed(TestSpawn, Player) && IsSpawnpointPreferred(TestSpawn, Player))
+			{
+				BestStart = TestSpawn;
+				break;
+			}
 		}
-		else
+	}
+
+	if (BestStart == NULL)
+	{
+		TArray<APlayerStart*, TInlineAllocator<64>> PreferredSpawns;
+		TArray<APlayerStart*, TInlineAllocator<64>> FallbackSpawns;
+
+		for (AShooterTeamStart* TestSpawn : SpawnService->GetStarts(Cast<AShooterAIController>(Player) != NULL))
 		{
 			if (IsSpawnpointAllowed(TestSpawn, Player))
 			{
@@ -413,11 +608,7 @@ AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
 				}
 			}
 		}
-	}
 
-	
-	if (BestStart == NULL)
-	{
 		if (PreferredSpawns.Num() > 0)
 		{
 			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
@@ -436,6 +627,13 @@ bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController
 	AShooterTeamStart* ShooterSpawnPoint = Cast<AShooterTeamStart>(SpawnPoint);
 	if (ShooterSpawnPoint)
 	{
+		// check team constraints
+		const AShooterPlayerState* PlayerState = (Player && IsTeamGame()) ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+		if (PlayerState && ShooterSpawnPoint->SpawnTeam != PlayerState->GetTeamNum())
+		{
+			return false;
+		}
+
 		AShooterAIController* AIController = Cast<AShooterAIController>(Player);
 		if (ShooterSpawnPoint->bNotForBots && AIController)
 		{
@@ -454,38 +652,16 @@ bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController
 
 bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AController* Player) const
 {
-	ACharacter* MyPawn = Cast<ACharacter>((*DefaultPawnClass)->GetDefaultObject<ACharacter>());	
-	AShooterAIController* AIController = Cast<AShooterAIController>(Player);
-	if( AIController != nullptr )
-	{
-		MyPawn = Cast<ACharacter>(BotPawnClass->GetDefaultObject<ACharacter>());
-	}
-	
-	if (MyPawn)
-	{
-		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
-		for (ACharacter* OtherPawn : TActorRange<ACharacter>(GetWorld()))
-		{
-			if (OtherPawn != MyPawn)
-			{
-				const float CombinedHeight = (MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
-				const float CombinedRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
-				const FVector OtherLocation = OtherPawn->GetActorLocation();
-
-				// check if player start overlaps this pawn
-				if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
-				{
-					return false;
-				}
-			}
-		}
-	}
-	else
+	const TSubclassOf<APawn> PawnClass = Cast<AShooterAIController>(Player) ? BotPawnClass : DefaultPawnClass;
+	const ACharacter* MyPawn = PawnClass ? Cast<ACharacter>(PawnClass->GetDefaultObject()) : NULL;
+	if (MyPawn == NULL)
 	{
 		return false;
 	}
-	
-	return true;
+
+	// check if player start overlaps any pawn
+	const UCapsuleComponent* Capsule = MyPawn->GetCapsuleComponent();
+	return !GetWorld()->GetSubsystem<UShooterSpawnService>()->IsOccupied(SpawnPoint->GetActorLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
 }
 
 void AShooterGameMode::CreateBotControllers()
@@ -541,6 +717,12 @@ void AShooterGameMode::InitBot(AShooterAIController* AIController, int32 BotNum)
 {	
 	if (AIController)
 	{
+		if (IsTeamGame())
+		{
+			AShooterPlayerState* BotPlayerState = CastChecked<AShooterPlayerState>(AIController->PlayerState);
+			BotPlayerState->SetTeamNum(ChooseTeam(BotPlayerState));
+		}
+
 		if (AIController->PlayerState)
 		{
 			FString BotName = FString::Printf(TEXT("Bot %d"), BotNum);
@@ -549,6 +731,46 @@ void AShooterGameMode::InitBot(AShooterAIController* AIController, int32 BotNum)
 	}
 }
 
+int32 AShooterGameMode::ChooseTeam(AShooterPlayerState* ForPlayerState) const
+{
+	TArray<int32> TeamBalance;
+	TeamBalance.AddZeroed(Rules.NumTeams);
+
+	// get current team balance
+	for (int32 i = 0; i < GameState->PlayerArray.Num(); i++)
+	{
+		AShooterPlayerState const* const TestPlayerState = Cast<AShooterPlayerState>(GameState->PlayerArray[i]);
+		if (TestPlayerState && TestPlayerState != ForPlayerState && TeamBalance.IsValidIndex(TestPlayerState->GetTeamNum()))
+		{
+			TeamBalance[TestPlayerState->GetTeamNum()]++;
+		}
+	}
+
+	// find least populated one
+	int32 BestTeamScore = TeamBalance[0];
+	for (int32 i = 1; i < TeamBalance.Num(); i++)
+	{
+		if (BestTeamScore > TeamBalance[i])
+		{
+			BestTeamScore = TeamBalance[i];
+		}
+	}
+
+	// there could be more than one...
+	TArray<int32> BestTeams;
+	for (int32 i = 0; i < TeamBalance.Num(); i++)
+	{
+		if (TeamBalance[i] == BestTeamScore)
+		{
+			BestTeams.Add(i);
+		}
+	}
+
+	// get random from best list
+	const int32 RandomBestTeam = BestTeams[FMath::RandHelper(BestTeams.Num())];
+	return RandomBestTeam;
+}
+
 void AShooterGameMode::RestartGame()
 {
 	// Hide the scoreboard too !
@@ -566,6 +788,31 @@ void AShooterGameMode::RestartGame()
 		}
 	}
 
+	GMatchRestartTime = FPlatformTime::Seconds();
+
+	// dedicated servers keep connections and loaded assets, clients skip the loading screen
+	if (CVar_ShooterGame_SoftReset > 0 && GetNetMode() == NM_DedicatedServer)
+	{
+		ResetMatch();
+		return;
+	}
+
 	Super::RestartGame();
 }
 
+void AShooterGameMode::ResetMatch()
+{
+	if (GetMatchState() != MatchState::WaitingPostMatch)
+	{
+		return;
+	}
+
+	// resets controllers first, then every other actor: game state, player states, pawns, pickups and projectiles
+	ResetLevel();
+
+	// warmup timer starts again, StartBots brings bots back with the match
+	SetMatchState(MatchState::WaitingToStart);
+
+	UE_LOG(LogShooter, Log, TEXT("Match reset in place in %.2f ms"), 1000.0 * (FPlatformTime::Seconds() - GMatchRestartTime));
+}
+
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterGameRules.h"
+
+void FShooterRuleTables::Compile(const FShooterGameRuleSet& RuleSet)
+{
+	Name = RuleSet.Name;
+	NumTeams = FMath::Max(RuleSet.NumTeams, 0);
+	WinCondition = (NumTeams == 0 && RuleSet.WinCondition == EShooterWinCondition::BestTeam) ? EShooterWinCondition::BestPlayer : RuleSet.WinCondition;
+
+	DamageScale[EShooterRuleRelation::Self] = FMath::Max(RuleSet.SelfDamageScale, 0.0f);
+	DamageScale[EShooterRuleRelation::Team] = FMath::Max(RuleSet.TeamDamageScale, 0.0f);
+	DamageScale[EShooterRuleRelation::Enemy] = 1.0f;
+
+	// suicide isn't a kill
+	KillerScore[EShooterRuleRelation::Self] = 0;
+	KillerScore[EShooterRuleRelation::Team] = RuleSet.TeamKillScore;
+	KillerScore[EShooterRuleRelation::Enemy] = RuleSet.KillScore;
+
+	VictimScore[EShooterRuleRelation::Self] = RuleSet.SuicideScore;
+	VictimScore[EShooterRuleRelation::Team] = RuleSet.DeathScore;
+	VictimScore[EShooterRuleRelation::Enemy] = RuleSet.DeathScore;
+}
+
+void FShooterRuleTables::Dump() const
+{
+	static const TCHAR* RelationNames[EShooterRuleRelation::MAX] = { TEXT("self"), TEXT("team"), TEXT("enemy") };
+
+	UE_LOG(LogShooter, Log, TEXT("Game rules %s: %d teams, win condition %s"), *Name.ToString(), NumTeams, *UEnum::GetValueAsString(WinCondition));
+	for (int32 Relation = 0; Relation < EShooterRuleRelation::MAX; Relation++)
+	{
+		UE_LOG(LogShooter, Log, TEXT("  %-5s damage x%.2f, killer %d, victim %d"), RelationNames[Relation], DamageScale[Relation], KillerScore[Relation], VictimScore[Relation]);
+	}
+}
+
+UShooterGameRules::UShooterGameRules(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+}
+
+const FShooterGameRuleSet* UShooterGameRules::FindRuleSet(FName Name)
+{
+	return GetDefault<UShooterGameRules>()->RuleSets.FindByPredicate([Name](const FShooterGameRuleSet& RuleSet) { return RuleSet.Name == Name; });
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterGameRulesDumpCmd(TEXT("ShooterGameRules.Dump"), TEXT("[server] Prints compiled rule tables of current game mode."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		const AShooterGameMode* GameMode = (World && World->GetNetMode() != NM_Client) ? World->GetAuthGameMode<AShooterGameMode>() : NULL;
+		if (GameMode)
+		{
+			GameMode->GetRules().Dump();
+		}
+	})
+);
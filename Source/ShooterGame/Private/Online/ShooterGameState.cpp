@@ -6,11 +6,23 @@
 #include "OnlineSubsystemUtils.h"
 #include "OnlineGameMatchesInterface.h"
 
+int32 CVar_ShooterKillFeed_Batched = 1;
+static FAutoConsoleVariableRef CVarShooterKillFeedBatched(TEXT("ShooterKillFeed.Batched"), CVar_ShooterKillFeed_Batched, TEXT("Replicate kills through the game state kill feed instead of two RPCs per kill"), ECVF_Default );
+
+float CVar_ShooterKillFeed_Retention = 2.0f;
+static FAutoConsoleVariableRef CVarShooterKillFeedRetention(TEXT("ShooterKillFeed.Retention"), CVar_ShooterKillFeed_Retention, TEXT("Seconds a kill stays in the replicated kill feed"), ECVF_Default );
+
 AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	RankingRevision = 1;
+	NextKillId = 1;
+	NumKills = 0;
+	NumKillFrames = 0;
+	NumKillRPCs = 0;
+	LastKillFrame = 0;
 
 	UShooterGameInstance* GameInstance = GetWorld() != nullptr ? Cast<UShooterGameInstance>(GetWorld()->GetGameInstance()) : nullptr;
 
@@ -25,38 +37,177 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, RemainingTime );
 	DOREPLIFETIME( AShooterGameState, bTimerPaused );
 	DOREPLIFETIME( AShooterGameState, TeamScores );
+	DOREPLIFETIME( AShooterGameState, KillFeed );
 }
 
-void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+bool AShooterGameState::IsKillFeedBatched()
 {
-	OutRankedMap.Empty();
+	return CVar_ShooterKillFeed_Batched > 0;
+}
+
+void AShooterGameState::NotifyKill(AShooterPlayerState* KillerPlayerState, AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType)
+{
+	// what per kill RPCs cost: InformAboutKill to the killer and BroadcastDeath to every connection
+	const UNetDriver* NetDriver = GetNetDriver();
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	NumKillRPCs += (KillerPlayerState && KillerPlayerState != VictimPlayerState ? 1 : 0) + (VictimPlayerState ? NumConnections : 0);
+	NumKills++;
+	if (LastKillFrame != GFrameCounter)
+	{
+		LastKillFrame = GFrameCounter;
+		NumKillFrames++;
+	}
+
+	if (!IsKillFeedBatched())
+	{
+		return;
+	}
+
+	FShooterKillEvent& Event = KillFeed.Items.AddDefaulted_GetRef();
+	Event.KillId = NextKillId++;
+	Event.Killer = KillerPlayerState;
+	Event.Victim = VictimPlayerState;
+	Event.bHasKiller = KillerPlayerState != NULL;
+	Event.bHasVictim = VictimPlayerState != NULL;
+	Event.DamageType = const_cast<UDamageType*>(KillerDamageType);
+	Event.AddTime = GetWorld()->GetTimeSeconds();
+	KillFeed.MarkItemDirty(Event);
+
+	// kills of this frame share the next update instead of waiting for NetUpdateFrequency
+	ForceNetUpdate();
+
+	if (!GetWorldTimerManager().IsTimerActive(TimerHandle_PruneKillFeed))
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_PruneKillFeed, this, &AShooterGameState::PruneKillFeed, FMath::Max(CVar_ShooterKillFeed_Retention, 0.1f), false);
+	}
+}
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+void AShooterGameState::PruneKillFeed()
+{
+	const float Retention = FMath::Max(CVar_ShooterKillFeed_Retention, 0.1f);
+	const float ExpireTime = GetWorld()->GetTimeSeconds() - Retention;
+
+	float OldestTime = 0.0f;
+	const int32 NumRemoved = KillFeed.Items.RemoveAll([&](const FShooterKillEvent& Event)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		if (Event.AddTime <= ExpireTime)
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->GetScore()), CurPlayerState);
+			return true;
 		}
+		OldestTime = (OldestTime > 0.0f) ? FMath::Min(OldestTime, Event.AddTime) : Event.AddTime;
+		return false;
+	});
+
+	if (NumRemoved > 0)
+	{
+		KillFeed.MarkArrayDirty();
 	}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+	if (KillFeed.Items.Num() > 0)
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_PruneKillFeed, this, &AShooterGameState::PruneKillFeed, FMath::Max(OldestTime + Retention - GetWorld()->GetTimeSeconds(), 0.01f), false);
+	}
+}
+
+void AShooterGameState::DumpKillFeedStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Kill feed: %s, %d kills in %d frames, %d kept for %.1f s. Per kill RPCs: %d calls, batched: %d game state updates per connection"),
+		IsKillFeedBatched() ? TEXT("batched") : TEXT("RPCs"), NumKills, NumKillFrames, KillFeed.Items.Num(), CVar_ShooterKillFeed_Retention, NumKillRPCs, NumKillFrames);
+}
 
-	//now, add them back to the ranked map
+void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+{
 	OutRankedMap.Empty();
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	const TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers = GetRankedPlayers(TeamIndex);
+	for (int32 Rank = 0; Rank < TeamPlayers.Num(); Rank++)
+	{
+		OutRankedMap.Add(Rank, TeamPlayers[Rank]);
+	}
+}
+
+const TArray<TWeakObjectPtr<AShooterPlayerState>>& AShooterGameState::GetRankedPlayers(int32 TeamIndex) const
+{
+	static const TArray<TWeakObjectPtr<AShooterPlayerState>> NoPlayers;
+	return RankedPlayers.IsValidIndex(TeamIndex) ? RankedPlayers[TeamIndex] : NoPlayers;
+}
+
+int32 AShooterGameState::GetPlayerRank(const AShooterPlayerState* PlayerState) const
+{
+	return PlayerState ? GetRankedPlayers(PlayerState->GetTeamNum()).IndexOfByKey(PlayerState) : INDEX_NONE;
+}
+
+void AShooterGameState::UpdatePlayerRank(AShooterPlayerState* PlayerState)
+{
+	// team may have changed, so look everywhere
+	for (TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers : RankedPlayers)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		TeamPlayers.RemoveAll([PlayerState](const TWeakObjectPtr<AShooterPlayerState>& Ranked) { return !Ranked.IsValid() || Ranked.Get() == PlayerState; });
+	}
+
+	const int32 TeamNum = PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE;
+	if (TeamNum >= 0 && !PlayerState->IsPendingKill() && PlayerArray.Contains(PlayerState))
+	{
+		if (TeamNum >= RankedPlayers.Num())
+		{
+			RankedPlayers.SetNum(TeamNum + 1);
+		}
+
+		// after everyone with a higher score, or same score and lower id
+		const int32 Score = FMath::TruncToInt(PlayerState->GetScore());
+		const int32 PlayerId = PlayerState->GetPlayerId();
+		TArray<TWeakObjectPtr<AShooterPlayerState>>& TeamPlayers = RankedPlayers[TeamNum];
+		int32 InsertIdx = 0;
+		while (InsertIdx < TeamPlayers.Num())
+		{
+			const AShooterPlayerState* Other = TeamPlayers[InsertIdx].Get();
+			const int32 OtherScore = FMath::TruncToInt(Other->GetScore());
+			if (OtherScore < Score || (OtherScore == Score && Other->GetPlayerId() > PlayerId))
+			{
+				break;
+			}
+			InsertIdx++;
+		}
+		TeamPlayers.Insert(PlayerState, InsertIdx);
 	}
-	
+
+	RankingRevision++;
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	UpdatePlayerRank(Cast<AShooterPlayerState>(PlayerState));
 }
 
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+
+	UpdatePlayerRank(Cast<AShooterPlayerState>(PlayerState));
+}
+
+void AShooterGameState::Reset()
+{
+	Super::Reset();
+
+	// teams stay, player states reset their own scores
+	for (int32& TeamScore : TeamScores)
+	{
+		TeamScore = 0;
+	}
+
+	RemainingTime = 0;
+	bTimerPaused = false;
+	ElapsedTime = 0;
+
+	// ids keep counting, remote clients aren't reset along with the server and would skip kills of the new match
+	// if they started over, anything already shown is gone from the feed
+	KillFeed.Items.Empty();
+	KillFeed.MarkArrayDirty();
+	GetWorldTimerManager().ClearTimer(TimerHandle_PruneKillFeed);
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
@@ -96,4 +247,15 @@ void AShooterGameState::HandleMatchHasEnded()
 {
 	Super::HandleMatchHasEnded();
 	GameMatches.HandleMatchHasEnded(bEnableGameFeedback, NumTeams, MakeArrayView(TeamScores));
-}
\ No newline at end of file
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterKillFeedStatsCmd(TEXT("ShooterKillFeed.Stats"), TEXT("[server] Prints kills and frames with kills, RPCs sent per kill vs batched kill feed updates."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		AShooterGameState* MyGameState = (World && World->GetNetMode() != NM_Client) ? World->GetGameState<AShooterGameState>() : NULL;
+		if (MyGameState)
+		{
+			MyGameState->DumpKillFeedStats();
+		}
+	})
+);
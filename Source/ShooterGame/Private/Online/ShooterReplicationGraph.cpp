@@ -95,6 +95,7 @@
 #include "Engine/LevelScriptActor.h"
 #include "Player/ShooterCharacter.h"
 #include "Online/ShooterPlayerState.h"
+#include "Online/ShooterTickRateController.h"
 #include "Weapons/ShooterWeapon.h"
 #include "Pickups/ShooterPickup.h"
 
@@ -131,6 +132,19 @@ UShooterReplicationGraph::UShooterReplicationGraph()
 {
 }
 
+void UShooterReplicationGraph::BeginDestroy()
+{
+	// tick rate controller outlives graphs of previous net drivers
+	UShooterTickRateController::NotifyServerTickRateChanged.RemoveAll(this);
+
+	Super::BeginDestroy();
+}
+
+static uint32 GetReplicationPeriodFrame(UClass* Class, float ServerMaxTickRate)
+{
+	return FMath::Max<uint32>( (uint32)FMath::RoundToFloat(ServerMaxTickRate / Class->GetDefaultObject<AActor>()->NetUpdateFrequency), 1);
+}
+
 void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize, float ServerMaxTickRate)
 {
 	AActor* CDO = Class->GetDefaultObject<AActor>();
@@ -140,7 +154,7 @@ void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool b
 		UE_LOG(LogShooterReplicationGraph, Log, TEXT("Setting cull distance for %s to %f (%f)"), *Class->GetName(), Info.GetCullDistanceSquared(), Info.GetCullDistance());
 	}
 
-	Info.ReplicationPeriodFrame = FMath::Max<uint32>( (uint32)FMath::RoundToFloat(ServerMaxTickRate / CDO->NetUpdateFrequency), 1);
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrame(Class, ServerMaxTickRate);
 
 	UClass* NativeClass = Class;
 	while(!NativeClass->IsNative() && NativeClass->GetSuperClass() && NativeClass->GetSuperClass() != AActor::StaticClass())
@@ -304,6 +318,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 		FClassReplicationInfo ClassInfo;
 		InitClassReplicationInfo(ClassInfo, ReplicatedClass, bClassIsSpatialized, NetDriver->NetServerMaxTickRate);
 		GlobalActorReplicationInfoMap.SetClassInfo( ReplicatedClass, ClassInfo );
+		TickRatePeriodClasses.Add(ReplicatedClass);
 	}
 
 
@@ -350,6 +365,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	
 	AShooterCharacter::NotifyEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterEquipWeapon);
 	AShooterCharacter::NotifyUnEquipWeapon.AddUObject(this, &UShooterReplicationGraph::OnCharacterUnEquipWeapon);
+	UShooterTickRateController::NotifyServerTickRateChanged.AddUObject(this, &UShooterReplicationGraph::OnServerTickRateChanged);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UShooterReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -524,6 +540,68 @@ void UShooterReplicationGraph::OnCharacterUnEquipWeapon(AShooterCharacter* Chara
 	}
 }
 
+void UShooterReplicationGraph::OnServerTickRateChanged(UNetDriver* InNetDriver, int32 NewTickRate)
+{
+	if (InNetDriver != NetDriver)
+	{
+		return;
+	}
+
+	// keep NetUpdateFrequency in Hz rather than in frames
+	TSet<UClass*> UpdatedClasses;
+	for (UClass* Class : TickRatePeriodClasses)
+	{
+		GlobalActorReplicationInfoMap.GetClassInfo(Class).ReplicationPeriodFrame = GetReplicationPeriodFrame(Class, NewTickRate);
+		UpdatedClasses.Add(Class);
+	}
+
+	// actors copied their class settings when they were added, remember old period for connections
+	TMap<AActor*, TPair<uint32, uint32>> UpdatedActors;
+	for (auto ActorIt = GlobalActorReplicationInfoMap.CreateActorMapIterator(); ActorIt; ++ActorIt)
+	{
+		AActor* Actor = ActorIt.Key();
+		if (Actor && UpdatedClasses.Contains(Actor->GetClass()))
+		{
+			FGlobalActorReplicationInfo& GlobalInfo = *ActorIt.Value();
+			const uint32 OldPeriod = GlobalInfo.Settings.ReplicationPeriodFrame;
+			GlobalInfo.Settings.ReplicationPeriodFrame = GlobalActorReplicationInfoMap.GetClassInfo(Actor->GetClass()).ReplicationPeriodFrame;
+			if (GlobalInfo.Settings.ReplicationPeriodFrame != OldPeriod)
+			{
+				UpdatedActors.Add(Actor, TPair<uint32, uint32>(OldPeriod, GlobalInfo.Settings.ReplicationPeriodFrame));
+			}
+		}
+	}
+
+	// and connections copied actor settings when they first considered the actor, periods set explicitly per connection are left alone
+	int32 NumUpdatedConnectionActors = 0;
+	auto UpdateConnection = [&UpdatedActors, &NumUpdatedConnectionActors](UNetReplicationGraphConnection* ConnManager)
+	{
+		for (const TPair<AActor*, TPair<uint32, uint32>>& UpdatedActor : UpdatedActors)
+		{
+			FConnectionReplicationActorInfo* ConnectionActorInfo = ConnManager->ActorInfoMap.Find(UpdatedActor.Key);
+			if (ConnectionActorInfo && ConnectionActorInfo->ReplicationPeriodFrame == UpdatedActor.Value.Key)
+			{
+				ConnectionActorInfo->ReplicationPeriodFrame = UpdatedActor.Value.Value;
+				NumUpdatedConnectionActors++;
+			}
+		}
+	};
+
+	if (UpdatedActors.Num() > 0)
+	{
+		for (UNetReplicationGraphConnection* ConnManager : Connections)
+		{
+			UpdateConnection(ConnManager);
+		}
+		for (UNetReplicationGraphConnection* ConnManager : PendingConnections)
+		{
+			UpdateConnection(ConnManager);
+		}
+	}
+
+	UE_LOG(LogShooterReplicationGraph, Log, TEXT("Server tick rate %d Hz: replication period updated for %d classes, %d actors and %d connection actors"), NewTickRate, UpdatedClasses.Num(), UpdatedActors.Num(), NumUpdatedConnectionActors);
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -37,6 +37,8 @@ public:
 
 	UShooterReplicationGraph();
 
+	virtual void BeginDestroy() override;
+
 	virtual void ResetGameWorldState() override;
 
 	virtual void InitGlobalActorClassSettings() override;
@@ -64,6 +66,7 @@ public:
 
 	void OnCharacterEquipWeapon(AShooterCharacter* Character, AShooterWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AShooterCharacter* Character, AShooterWeapon* OldWeapon);
+	void OnServerTickRateChanged(UNetDriver* InNetDriver, int32 NewTickRate);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
@@ -78,6 +81,10 @@ private:
 	bool IsSpatialized(EClassRepNodeMapping Mapping) const { return Mapping >= EClassRepNodeMapping::Spatialize_Static; }
 
 	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** classes whose ReplicationPeriodFrame comes from NetUpdateFrequency and the server tick rate */
+	UPROPERTY()
+	TArray<UClass*> TickRatePeriodClasses;
 };
 
 UCLASS()
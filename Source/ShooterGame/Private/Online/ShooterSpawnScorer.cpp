@@ -0,0 +1,333 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSpawnScorer.h"
+#include "Online/ShooterSpawnService.h"
+#include "Online/ShooterPlayerState.h"
+#include "Player/ShooterPawnIndex.h"
+#include "Bots/ShooterTacticalPointService.h"
+#include "Bots/ShooterTacticalPointData.h"
+#include "ShooterTeamStart.h"
+#include "Async/Async.h"
+
+int32 CVar_ShooterSpawnScore_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreEnable(TEXT("ShooterSpawnScore.Enable"), CVar_ShooterSpawnScore_Enable, TEXT("Pick safest free spawn point instead of a random free one"), ECVF_Default );
+
+float CVar_ShooterSpawnScore_Interval = 1.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreInterval(TEXT("ShooterSpawnScore.Interval"), CVar_ShooterSpawnScore_Interval, TEXT("Time between spawn point danger updates"), ECVF_Default );
+
+float CVar_ShooterSpawnScore_DangerRadius = 3000.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreDangerRadius(TEXT("ShooterSpawnScore.DangerRadius"), CVar_ShooterSpawnScore_DangerRadius, TEXT("Distance at which an enemy stops adding danger to a spawn point"), ECVF_Default );
+
+float CVar_ShooterSpawnScore_VisibleWeight = 2.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreVisibleWeight(TEXT("ShooterSpawnScore.VisibleWeight"), CVar_ShooterSpawnScore_VisibleWeight, TEXT("Danger added by an enemy that can see the spawn point, needs baked tactical points"), ECVF_Default );
+
+float CVar_ShooterSpawnScore_KillRadius = 1500.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreKillRadius(TEXT("ShooterSpawnScore.KillRadius"), CVar_ShooterSpawnScore_KillRadius, TEXT("Distance at which a recent kill stops adding danger to a spawn point"), ECVF_Default );
+
+float CVar_ShooterSpawnScore_KillHalfLife = 10.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnScoreKillHalfLife(TEXT("ShooterSpawnScore.KillHalfLife"), CVar_ShooterSpawnScore_KillHalfLife, TEXT("Seconds for danger of a kill to halve"), ECVF_Default );
+
+/** largest random offset added to danger, so equally safe starts don't always come in the same order */
+static const float ShooterSpawnScoreTieJitter = 0.01f;
+
+void FShooterSpawnScoreTable::Update(const FShooterSpawnStaticData& StaticData, const FShooterSpawnScoreInput& Input)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumStarts = FMath::Min(StaticData.StartLocations.Num(), (int32)MAX_uint16);
+	const float InvDangerRadius = 1.0f / FMath::Max(Input.DangerRadius, 1.0f);
+	const float InvKillRadius = 1.0f / FMath::Max(Input.KillRadius, 1.0f);
+	const float InvKillHalfLife = 1.0f / FMath::Max(Input.KillHalfLife, 0.1f);
+
+	// kills and tie breaking are the same for every team
+	FRandomStream Random(Input.RandomSeed);
+	TArray<float> BaseDanger;
+	BaseDanger.SetNumUninitialized(NumStarts);
+	for (int32 StartIdx = 0; StartIdx < NumStarts; StartIdx++)
+	{
+		const FVector& StartLocation = StaticData.StartLocations[StartIdx];
+		float Danger = Random.FRand() * ShooterSpawnScoreTieJitter;
+		for (const FShooterSpawnScoreInput::FKillSample& Kill : Input.Kills)
+		{
+			const float Falloff = 1.0f - FVector::Dist(StartLocation, Kill.Location) * InvKillRadius;
+			if (Falloff > 0.0f)
+			{
+				Danger += Falloff * FMath::Exp2(-Kill.Age * InvKillHalfLife);
+			}
+		}
+		BaseDanger[StartIdx] = Danger;
+	}
+
+	LayerTeams = Input.LayerTeams;
+	Danger.SetNum(LayerTeams.Num());
+	RankedStarts.SetNum(LayerTeams.Num());
+
+	for (int32 LayerIdx = 0; LayerIdx < LayerTeams.Num(); LayerIdx++)
+	{
+		const int32 FriendlyTeam = LayerTeams[LayerIdx];
+		TArray<float>& LayerDanger = Danger[LayerIdx];
+		LayerDanger = BaseDanger;
+
+		for (const FShooterSpawnScoreInput::FPawnSample& Pawn : Input.Pawns)
+		{
+			if (FriendlyTeam != INDEX_NONE && Pawn.Team == FriendlyTeam)
+			{
+				continue;
+			}
+
+			for (int32 StartIdx = 0; StartIdx < NumStarts; StartIdx++)
+			{
+				const float Proximity = 1.0f - FVector::Dist(StaticData.StartLocations[StartIdx], Pawn.Location) * InvDangerRadius;
+				LayerDanger[StartIdx] += FMath::Max(Proximity, 0.0f) + (StaticData.IsVisible(StartIdx, Pawn.PointIdx) ? Input.VisibleWeight : 0.0f);
+			}
+		}
+
+		TArray<uint16>& Ranked = RankedStarts[LayerIdx];
+		Ranked.SetNumUninitialized(NumStarts);
+		for (int32 StartIdx = 0; StartIdx < NumStarts; StartIdx++)
+		{
+			Ranked[StartIdx] = (uint16)StartIdx;
+		}
+		Ranked.Sort([&LayerDanger](uint16 A, uint16 B) { return LayerDanger[A] < LayerDanger[B]; });
+	}
+
+	UpdateTime = FPlatformTime::Seconds() - StartTime;
+}
+
+void UShooterSpawnScorer::AddKill(const FVector& Location)
+{
+	// nothing would consume kills while scoring is off
+	if (!CVar_ShooterSpawnScore_Enable)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	PruneKills(Now);
+	Kills.Add(TPair<FVector, float>(Location, Now));
+}
+
+void UShooterSpawnScorer::PruneKills(float Now)
+{
+	const float MaxKillAge = CVar_ShooterSpawnScore_KillHalfLife * 4.0f;
+	Kills.RemoveAllSwap([Now, MaxKillAge](const TPair<FVector, float>& Kill) { return Now - Kill.Value > MaxKillAge; }, false);
+}
+
+const TArray<uint16>* UShooterSpawnScorer::GetRankedStarts(int32 FriendlyTeam) const
+{
+	if (!CVar_ShooterSpawnScore_Enable || !FrontTable.IsValid())
+	{
+		return NULL;
+	}
+
+	int32 LayerIdx = FrontTable->LayerTeams.Find(FriendlyTeam);
+	if (LayerIdx == INDEX_NONE)
+	{
+		LayerIdx = FrontTable->LayerTeams.Find(INDEX_NONE);
+	}
+
+	return FrontTable->RankedStarts.IsValidIndex(LayerIdx) ? &FrontTable->RankedStarts[LayerIdx] : NULL;
+}
+
+void UShooterSpawnScorer::UpdateStaticData()
+{
+	const TArray<AShooterTeamStart*>& Starts = GetWorld()->GetSubsystem<UShooterSpawnService>()->GetAllStarts();
+	UShooterTacticalPointService* TacticalService = GetWorld()->GetSubsystem<UShooterTacticalPointService>();
+	UShooterTacticalPointData* TacticalData = (TacticalService && TacticalService->HasData()) ? TacticalService->GetData() : NULL;
+
+	if (StaticData.IsValid() && StaticDataSource.Get() == TacticalData && StaticData->StartLocations.Num() == Starts.Num())
+	{
+		return;
+	}
+
+	FShooterSpawnStaticData* NewData = new FShooterSpawnStaticData();
+	for (const AShooterTeamStart* Start : Starts)
+	{
+		NewData->StartLocations.Add(Start->GetActorLocation());
+	}
+
+	// copy rows of tactical visibility, so worker never touches the asset
+	if (TacticalData)
+	{
+		const int32 NumPoints = TacticalData->Points.Num();
+		NewData->WordsPerRow = (NumPoints + 31) / 32;
+		NewData->VisibilityRows.SetNumZeroed(NewData->WordsPerRow * Starts.Num());
+
+		for (int32 StartIdx = 0; StartIdx < Starts.Num(); StartIdx++)
+		{
+			const int32 StartPointIdx = TacticalService->FindNearestPoint(NewData->StartLocations[StartIdx]);
+			if (StartPointIdx == INDEX_NONE)
+			{
+				continue;
+			}
+
+			uint32* Row = &NewData->VisibilityRows[StartIdx * NewData->WordsPerRow];
+			for (int32 PointIdx = 0; PointIdx < NumPoints; PointIdx++)
+			{
+				if (TacticalData->IsVisible(StartPointIdx, PointIdx))
+				{
+					Row[PointIdx >> 5] |= 1u << (PointIdx & 31);
+				}
+			}
+		}
+	}
+
+	StaticData = MakeShareable(NewData);
+	StaticDataSource = TacticalData;
+}
+
+void UShooterSpawnScorer::GatherInput(FShooterSpawnScoreInput& Input)
+{
+	UWorld* World = GetWorld();
+	UShooterTacticalPointService* TacticalService = StaticData->WordsPerRow > 0 ? World->GetSubsystem<UShooterTacticalPointService>() : NULL;
+
+	TArray<AShooterCharacter*> Pawns;
+	World->GetSubsystem<UShooterPawnIndex>()->GetAlivePawns(Pawns);
+	for (AShooterCharacter* Pawn : Pawns)
+	{
+		const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Pawn->GetPlayerState());
+		const FVector Location = Pawn->GetActorLocation();
+		Input.Pawns.Add({ Location, PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE, TacticalService ? TacticalService->FindNearestPoint(Location) : INDEX_NONE });
+	}
+
+	const float Now = World->GetTimeSeconds();
+	PruneKills(Now);
+	for (const TPair<FVector, float>& Kill : Kills)
+	{
+		Input.Kills.Add({ Kill.Key, Now - Kill.Value });
+	}
+
+	// everyone is a threat in free for all, in team games only the other teams are
+	Input.LayerTeams.Add(INDEX_NONE);
+	const AShooterGameMode* GameMode = World->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode && GameMode->IsTeamGame() && World->GetGameState())
+	{
+		for (const APlayerState* PlayerState : World->GetGameState()->PlayerArray)
+		{
+			const AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+			if (ShooterPlayerState)
+			{
+				Input.LayerTeams.AddUnique(ShooterPlayerState->GetTeamNum());
+			}
+		}
+	}
+
+	Input.DangerRadius = CVar_ShooterSpawnScore_DangerRadius;
+	Input.VisibleWeight = CVar_ShooterSpawnScore_VisibleWeight;
+	Input.KillRadius = CVar_ShooterSpawnScore_KillRadius;
+	Input.KillHalfLife = CVar_ShooterSpawnScore_KillHalfLife;
+	Input.RandomSeed = FMath::Rand();
+}
+
+void UShooterSpawnScorer::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+
+	if (PendingUpdate.IsValid())
+	{
+		if (!PendingUpdate.IsReady())
+		{
+			return;
+		}
+
+		// worker is done, publish
+		PendingUpdate = TFuture<void>();
+		Swap(FrontTable, BackTable);
+		NumUpdates++;
+		TotalUpdateTime += FrontTable->UpdateTime;
+	}
+
+	if (TimeSinceUpdate < CVar_ShooterSpawnScore_Interval)
+	{
+		return;
+	}
+
+	UpdateStaticData();
+	if (StaticData->StartLocations.Num() == 0)
+	{
+		return;
+	}
+
+	if (!BackTable.IsValid())
+	{
+		BackTable = MakeShared<FShooterSpawnScoreTable, ESPMode::ThreadSafe>();
+	}
+
+	FShooterSpawnScoreInput Input;
+	GatherInput(Input);
+	TimeSinceUpdate = 0.0f;
+
+	TSharedPtr<FShooterSpawnScoreTable, ESPMode::ThreadSafe> Table = BackTable;
+	TSharedPtr<const FShooterSpawnStaticData, ESPMode::ThreadSafe> Static = StaticData;
+	PendingUpdate = Async(EAsyncExecution::ThreadPool, [Table, Static, Input = MoveTemp(Input)]()
+	{
+		Table->Update(*Static, Input);
+	});
+}
+
+void UShooterSpawnScorer::DumpStats() const
+{
+	UE_LOG(LogShooter, Log, TEXT("Spawn scores: %d updates, worker %.3f ms avg, %d starts, %s visibility"),
+		NumUpdates, NumUpdates > 0 ? 1000.0 * TotalUpdateTime / NumUpdates : 0.0, StaticData.IsValid() ? StaticData->StartLocations.Num() : 0,
+		(StaticData.IsValid() && StaticData->WordsPerRow > 0) ? TEXT("baked") : TEXT("no"));
+
+	if (FrontTable.IsValid())
+	{
+		for (int32 LayerIdx = 0; LayerIdx < FrontTable->LayerTeams.Num(); LayerIdx++)
+		{
+			const TArray<uint16>& Ranked = FrontTable->RankedStarts[LayerIdx];
+			const TArray<float>& LayerDanger = FrontTable->Danger[LayerIdx];
+			if (Ranked.Num() > 0)
+			{
+				UE_LOG(LogShooter, Log, TEXT("  team %d: safest start %d danger %.2f, most dangerous start %d danger %.2f"),
+					FrontTable->LayerTeams[LayerIdx], Ranked[0], LayerDanger[Ranked[0]], Ranked.Last(), LayerDanger[Ranked.Last()]);
+			}
+		}
+	}
+}
+
+ETickableTickType UShooterSpawnScorer::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterSpawnScorer::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return CVar_ShooterSpawnScore_Enable && World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+TStatId UShooterSpawnScorer::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterSpawnScorer, STATGROUP_Tickables);
+}
+
+UWorld* UShooterSpawnScorer::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterSpawnScorer::Deinitialize()
+{
+	if (PendingUpdate.IsValid())
+	{
+		PendingUpdate.Wait();
+	}
+	FrontTable.Reset();
+	BackTable.Reset();
+	StaticData.Reset();
+	Kills.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterSpawnScoreStatsCmd(TEXT("ShooterSpawnScore.Stats"), TEXT("[server] Prints spawn scoring worker time and safest start per team."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterSpawnScorer* SpawnScorer = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterSpawnScorer>() : NULL;
+		if (SpawnScorer)
+		{
+			SpawnScorer->DumpStats();
+		}
+	})
+);
@@ -0,0 +1,271 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSpawnService.h"
+#include "ShooterTeamStart.h"
+#include "Player/ShooterPawnIndex.h"
+#include "GameFramework/PlayerStartPIE.h"
+
+float CVar_ShooterSpawn_CellSize = 400.0f;
+static FAutoConsoleVariableRef CVarShooterSpawnCellSize(TEXT("ShooterSpawn.CellSize"), CVar_ShooterSpawn_CellSize, TEXT("Size of spawn occupancy grid cell in world units"), ECVF_Default );
+
+void FShooterSpawnOccupancy::Reset(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 100.0f);
+	for (TPair<FIntPoint, TArray<FShooterSpawnOccupant>>& It : Cells)
+	{
+		It.Value.Reset();
+	}
+}
+
+void FShooterSpawnOccupancy::Add(const FShooterSpawnOccupant& Occupant)
+{
+	const int32 MinX = FMath::FloorToInt((Occupant.Location.X - Occupant.Radius) / CellSize);
+	const int32 MaxX = FMath::FloorToInt((Occupant.Location.X + Occupant.Radius) / CellSize);
+	const int32 MinY = FMath::FloorToInt((Occupant.Location.Y - Occupant.Radius) / CellSize);
+	const int32 MaxY = FMath::FloorToInt((Occupant.Location.Y + Occupant.Radius) / CellSize);
+
+	for (int32 X = MinX; X <= MaxX; X++)
+	{
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(Occupant);
+		}
+	}
+}
+
+bool FShooterSpawnOccupancy::IsOccupied(const FVector& Location, float Radius, float HalfHeight) const
+{
+	// occupants are in every cell they touch, so only cells touched by the query capsule need checking
+	const int32 MinX = FMath::FloorToInt((Location.X - Radius) / CellSize);
+	const int32 MaxX = FMath::FloorToInt((Location.X + Radius) / CellSize);
+	const int32 MinY = FMath::FloorToInt((Location.Y - Radius) / CellSize);
+	const int32 MaxY = FMath::FloorToInt((Location.Y + Radius) / CellSize);
+
+	for (int32 X = MinX; X <= MaxX; X++)
+	{
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			const TArray<FShooterSpawnOccupant>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (Cell == NULL)
+			{
+				continue;
+			}
+
+			for (const FShooterSpawnOccupant& Occupant : *Cell)
+			{
+				const float CombinedHeight = (HalfHeight + Occupant.HalfHeight) * 2.0f;
+				const float CombinedRadius = Radius + Occupant.Radius;
+				if (FMath::Abs(Location.Z - Occupant.Location.Z) < CombinedHeight && (Location - Occupant.Location).SizeSquared2D() < FMath::Square(CombinedRadius))
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void UShooterSpawnService::CacheStarts()
+{
+	if (bStartsCached)
+	{
+		return;
+	}
+
+	bStartsCached = true;
+	for (TActorIterator<AShooterTeamStart> It(GetWorld()); It; ++It)
+	{
+		AllStarts.Add(*It);
+		if (!It->bNotForBots)
+		{
+			BotStarts.Add(*It);
+		}
+		if (!It->bNotForPlayers)
+		{
+			PlayerStarts.Add(*It);
+		}
+	}
+
+	if (GetWorld()->IsPlayInEditor())
+	{
+		TActorIterator<APlayerStartPIE> It(GetWorld());
+		PlayInEditorStart = It ? *It : NULL;
+	}
+}
+
+const TArray<AShooterTeamStart*>& UShooterSpawnService::GetStarts(bool bForBots)
+{
+	CacheStarts();
+	return bForBots ? BotStarts : PlayerStarts;
+}
+
+const TArray<AShooterTeamStart*>& UShooterSpawnService::GetAllStarts()
+{
+	CacheStarts();
+	return AllStarts;
+}
+
+APlayerStartPIE* UShooterSpawnService::GetPlayInEditorStart()
+{
+	CacheStarts();
+	return PlayInEditorStart;
+}
+
+void UShooterSpawnService::UpdateOccupancy()
+{
+	if (OccupancyFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	OccupancyFrame = GFrameCounter;
+	Occupancy.Reset(CVar_ShooterSpawn_CellSize);
+
+	TArray<AShooterCharacter*> Pawns;
+	GetWorld()->GetSubsystem<UShooterPawnIndex>()->GetAlivePawns(Pawns);
+	for (AShooterCharacter* Pawn : Pawns)
+	{
+		const UCapsuleComponent* Capsule = Pawn->GetCapsuleComponent();
+		Occupancy.Add({ Pawn->GetActorLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight() });
+	}
+}
+
+bool UShooterSpawnService::IsOccupied(const FVector& Location, float Radius, float HalfHeight)
+{
+	UpdateOccupancy();
+	return Occupancy.IsOccupied(Location, Radius, HalfHeight);
+}
+
+void UShooterSpawnService::MarkOccupied(APawn* Pawn)
+{
+	const ACharacter* Character = Cast<ACharacter>(Pawn);
+	if (Character)
+	{
+		UpdateOccupancy();
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		Occupancy.Add({ Character->GetActorLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight() });
+	}
+}
+
+void UShooterSpawnService::RunBenchmark(int32 NumSpawns, int32 NumIterations)
+{
+	const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	const ACharacter* PawnCDO = (GameMode && GameMode->DefaultPawnClass) ? Cast<ACharacter>(GameMode->DefaultPawnClass->GetDefaultObject()) : NULL;
+	const float Radius = PawnCDO ? PawnCDO->GetCapsuleComponent()->GetScaledCapsuleRadius() : 42.0f;
+	const float HalfHeight = PawnCDO ? PawnCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 96.0f;
+
+	TArray<AShooterCharacter*> Pawns;
+	GetWorld()->GetSubsystem<UShooterPawnIndex>()->GetAlivePawns(Pawns);
+
+	TArray<FShooterSpawnOccupant> AlivePawns;
+	for (AShooterCharacter* Pawn : Pawns)
+	{
+		const UCapsuleComponent* Capsule = Pawn->GetCapsuleComponent();
+		AlivePawns.Add({ Pawn->GetActorLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight() });
+	}
+
+	// every start and every pawn per spawn, like ChoosePlayerStart used to do
+	int32 NumScanFallbacks = 0;
+	FRandomStream Random(1234);
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		TArray<FShooterSpawnOccupant> Occupants = AlivePawns;
+		for (int32 SpawnIdx = 0; SpawnIdx < NumSpawns; SpawnIdx++)
+		{
+			TArray<APlayerStart*> PreferredSpawns;
+			TArray<APlayerStart*> FallbackSpawns;
+			for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+			{
+				const AShooterTeamStart* TeamStart = Cast<AShooterTeamStart>(*It);
+				if (TeamStart == NULL || TeamStart->bNotForPlayers)
+				{
+					continue;
+				}
+
+				const FVector SpawnLocation = It->GetActorLocation();
+				const bool bOccupied = Occupants.ContainsByPredicate([&](const FShooterSpawnOccupant& Occupant)
+				{
+					return FMath::Abs(SpawnLocation.Z - Occupant.Location.Z) < (HalfHeight + Occupant.HalfHeight) * 2.0f
+						&& (SpawnLocation - Occupant.Location).Size2D() < Radius + Occupant.Radius;
+				});
+				(bOccupied ? FallbackSpawns : PreferredSpawns).Add(*It);
+			}
+
+			NumScanFallbacks += (PreferredSpawns.Num() == 0) ? 1 : 0;
+			TArray<APlayerStart*>& Candidates = PreferredSpawns.Num() > 0 ? PreferredSpawns : FallbackSpawns;
+			if (Candidates.Num() > 0)
+			{
+				Occupants.Add({ Candidates[Random.RandHelper(Candidates.Num())]->GetActorLocation(), Radius, HalfHeight });
+			}
+		}
+	}
+	const double ScanTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumGridFallbacks = 0;
+	Random.Reset();
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		FShooterSpawnOccupancy TestOccupancy;
+		TestOccupancy.Reset(CVar_ShooterSpawn_CellSize);
+		for (const FShooterSpawnOccupant& Occupant : AlivePawns)
+		{
+			TestOccupancy.Add(Occupant);
+		}
+
+		for (int32 SpawnIdx = 0; SpawnIdx < NumSpawns; SpawnIdx++)
+		{
+			TArray<AShooterTeamStart*, TInlineAllocator<64>> PreferredSpawns;
+			TArray<AShooterTeamStart*, TInlineAllocator<64>> FallbackSpawns;
+			for (AShooterTeamStart* TestSpawn : GetStarts(false))
+			{
+				(TestOccupancy.IsOccupied(TestSpawn->GetActorLocation(), Radius, HalfHeight) ? FallbackSpawns : PreferredSpawns).Add(TestSpawn);
+			}
+
+			NumGridFallbacks += (PreferredSpawns.Num() == 0) ? 1 : 0;
+			TArray<AShooterTeamStart*, TInlineAllocator<64>>& Candidates = PreferredSpawns.Num() > 0 ? PreferredSpawns : FallbackSpawns;
+			if (Candidates.Num() > 0)
+			{
+				TestOccupancy.Add({ Candidates[Random.RandHelper(Candidates.Num())]->GetActorLocation(), Radius, HalfHeight });
+			}
+		}
+	}
+	const double GridTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogShooter, Log, TEXT("Spawn benchmark: %d starts, %d alive pawns, %d spawns: scan %.3f ms (%d without free start), grid %.3f ms (%d without free start)"),
+		GetStarts(false).Num(), AlivePawns.Num(), NumSpawns, 1000.0 * ScanTime / NumIterations, NumScanFallbacks / NumIterations,
+		1000.0 * GridTime / NumIterations, NumGridFallbacks / NumIterations);
+}
+
+void UShooterSpawnService::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	CacheStarts();
+}
+
+void UShooterSpawnService::Deinitialize()
+{
+	AllStarts.Empty();
+	BotStarts.Empty();
+	PlayerStarts.Empty();
+	PlayInEditorStart = NULL;
+	Occupancy.Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterSpawnBenchmarkCmd(TEXT("ShooterSpawn.Benchmark"), TEXT("[server] Times picking starts for a mass respawn, full scan vs occupancy grid. Optional number of spawns and iterations, default 64 and 100."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterSpawnService* SpawnService = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterSpawnService>() : NULL;
+		if (SpawnService)
+		{
+			SpawnService->RunBenchmark(Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 64, Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100);
+		}
+	})
+);
@@ -0,0 +1,503 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterTelemetry.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Async/Async.h"
+
+int32 CVar_ShooterTelemetry_Enable = 0;
+static FAutoConsoleVariableRef CVarShooterTelemetryEnable(TEXT("ShooterTelemetry.Enable"), CVar_ShooterTelemetry_Enable, TEXT("Record match events to Saved/Telemetry, checked when a map starts"), ECVF_Default );
+
+float CVar_ShooterTelemetry_FlushInterval = 1.0f;
+static FAutoConsoleVariableRef CVarShooterTelemetryFlushInterval(TEXT("ShooterTelemetry.FlushInterval"), CVar_ShooterTelemetry_FlushInterval, TEXT("Time between telemetry writes"), ECVF_Default );
+
+float CVar_ShooterTelemetry_BudgetMs = 0.05f;
+static FAutoConsoleVariableRef CVarShooterTelemetryBudgetMs(TEXT("ShooterTelemetry.BudgetMs"), CVar_ShooterTelemetry_BudgetMs, TEXT("Average game thread time per frame telemetry may use before it warns"), ECVF_Default );
+
+int32 CVar_ShooterTelemetry_MaxPendingChunks = 1024;
+static FAutoConsoleVariableRef CVarShooterTelemetryMaxPendingChunks(TEXT("ShooterTelemetry.MaxPendingChunks"), CVar_ShooterTelemetry_MaxPendingChunks, TEXT("Chunks of 256 events that may wait for writer, events are dropped past that"), ECVF_Default );
+
+int32 CVar_ShooterTelemetry_MaxFiles = 20;
+static FAutoConsoleVariableRef CVarShooterTelemetryMaxFiles(TEXT("ShooterTelemetry.MaxFiles"), CVar_ShooterTelemetry_MaxFiles, TEXT("Telemetry files kept in Saved/Telemetry, oldest are deleted when a map starts"), ECVF_Default );
+
+int32 CVar_ShooterTelemetry_MaxFileMB = 256;
+static FAutoConsoleVariableRef CVarShooterTelemetryMaxFileMB(TEXT("ShooterTelemetry.MaxFileMB"), CVar_ShooterTelemetry_MaxFileMB, TEXT("Size limit of a single telemetry file, events are dropped past that"), ECVF_Default );
+
+/** "SGTL" */
+static const uint32 ShooterTelemetryMagic = 0x4C544753;
+
+/** bump when FShooterTelemetryEvent or FShooterTelemetryHeader change */
+static const uint32 ShooterTelemetryVersion = 1;
+
+static const TCHAR* ShooterTelemetryEventNames[] =
+{
+	TEXT("Kill"),
+	TEXT("Damage"),
+	TEXT("Shot"),
+	TEXT("Pickup"),
+	TEXT("WallRun"),
+	TEXT("Teleport"),
+	TEXT("MatchStart"),
+	TEXT("MatchEnd"),
+};
+static_assert(UE_ARRAY_COUNT(ShooterTelemetryEventNames) == EShooterTelemetryEvent::MAX, "Missing telemetry event name");
+
+UShooterTelemetry* UShooterTelemetry::Get(const UWorld* World)
+{
+	UShooterTelemetry* Telemetry = (World && CVar_ShooterTelemetry_Enable) ? World->GetSubsystem<UShooterTelemetry>() : NULL;
+	return (Telemetry && Telemetry->bRecording) ? Telemetry : NULL;
+}
+
+FShooterTelemetryThreadBuffer* UShooterTelemetry::GetThreadBuffer()
+{
+	FShooterTelemetryThreadBuffer* Buffer = (FShooterTelemetryThreadBuffer*)FPlatformTLS::GetTlsValue(TlsSlot);
+	if (Buffer == NULL)
+	{
+		Buffer = new FShooterTelemetryThreadBuffer();
+		FPlatformTLS::SetTlsValue(TlsSlot, Buffer);
+
+		// once per thread, recording itself never locks
+		FScopeLock Lock(&ThreadBuffersLock);
+		ThreadBuffers.Add(Buffer);
+	}
+	return Buffer;
+}
+
+bool UShooterTelemetry::TryReservePendingChunk()
+{
+	// any thread can seal, count must not go past the limit between check and increment
+	int32 Current = FPlatformAtomics::AtomicRead(&NumPendingChunks);
+	while (Current < CVar_ShooterTelemetry_MaxPendingChunks)
+	{
+		const int32 Previous = FPlatformAtomics::InterlockedCompareExchange(&NumPendingChunks, Current + 1, Current);
+		if (Previous == Current)
+		{
+			return true;
+		}
+		Current = Previous;
+	}
+	return false;
+}
+
+void UShooterTelemetry::SealChunk(FShooterTelemetryThreadBuffer* Buffer)
+{
+	FShooterTelemetryChunk* Chunk = Buffer->Chunk;
+	if (Chunk && Chunk->Num > 0)
+	{
+		if (TryReservePendingChunk())
+		{
+			PendingChunks.Enqueue(Chunk);
+			Chunk = NULL;
+		}
+		else
+		{
+			// writer fell behind, keep memory bounded
+			NumDroppedEvents.Add(Chunk->Num);
+			Chunk->Num = 0;
+		}
+	}
+
+	if (Chunk == NULL)
+	{
+		Chunk = FreeChunks.Pop();
+		if (Chunk == NULL)
+		{
+			Chunk = new FShooterTelemetryChunk();
+		}
+		Chunk->Num = 0;
+	}
+
+	Buffer->Chunk = Chunk;
+	Buffer->Generation = FPlatformAtomics::AtomicRead(&FlushGeneration);
+}
+
+void UShooterTelemetry::Record(EShooterTelemetryEvent::Type Type, uint8 Detail, const APlayerState* Player, const APlayerState* Other, float Value, const FVector& Location)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	FShooterTelemetryThreadBuffer* Buffer = GetThreadBuffer();
+	if (Buffer->Chunk == NULL || Buffer->Chunk->Num == FShooterTelemetryChunk::Capacity || Buffer->Generation != FPlatformAtomics::AtomicRead(&FlushGeneration))
+	{
+		SealChunk(Buffer);
+	}
+
+	FShooterTelemetryEvent& Event = Buffer->Chunk->Events[Buffer->Chunk->Num++];
+	Event.Time = GetWorld()->GetTimeSeconds();
+	Event.Type = Type;
+	Event.Detail = Detail;
+	Event.Reserved = 0;
+	Event.PlayerId = Player ? Player->GetPlayerId() : INDEX_NONE;
+	Event.OtherId = Other ? Other->GetPlayerId() : INDEX_NONE;
+	Event.Value = Value;
+	Event.X = Location.X;
+	Event.Y = Location.Y;
+	Event.Z = Location.Z;
+
+	Buffer->NumEvents++;
+	Buffer->Cycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void UShooterTelemetry::WritePendingChunks()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FShooterTelemetryChunk* Chunk = NULL;
+	while (PendingChunks.Dequeue(Chunk))
+	{
+		FPlatformAtomics::InterlockedDecrement(&NumPendingChunks);
+
+		// events are written as in memory, file is little endian like every platform we ship
+		const int64 Size = Chunk->Num * sizeof(FShooterTelemetryEvent);
+		if (BytesWritten + Size > MaxFileBytes)
+		{
+			if (!bFileFull)
+			{
+				bFileFull = true;
+				UE_LOG(LogShooter, Warning, TEXT("Telemetry file %s reached %d MB, dropping further events"), *FilePath, (int32)(MaxFileBytes >> 20));
+			}
+			NumDroppedEvents.Add(Chunk->Num);
+		}
+		else if (FileHandle->Write((const uint8*)Chunk->Events, Size))
+		{
+			BytesWritten += Size;
+		}
+		else
+		{
+			NumDroppedEvents.Add(Chunk->Num);
+		}
+
+		Chunk->Num = 0;
+		FreeChunks.Push(Chunk);
+	}
+	FileHandle->Flush();
+
+	NumWrites++;
+	TotalWriteTime += FPlatformTime::Seconds() - StartTime;
+}
+
+void UShooterTelemetry::Flush()
+{
+	// game thread hands over its chunk right away, other threads do on their next event
+	FPlatformAtomics::InterlockedIncrement(&FlushGeneration);
+	SealChunk(GameThreadBuffer);
+	TimeSinceFlush = 0.0f;
+
+	PendingWrite = Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		WritePendingChunks();
+	});
+}
+
+void UShooterTelemetry::CheckBudget()
+{
+	const double AvgFrameMs = WindowFrames > 0 ? FPlatformTime::ToMilliseconds64(WindowGameThreadCycles) / WindowFrames : 0.0;
+	const bool bWasOverBudget = bOverBudget;
+	bOverBudget = AvgFrameMs > CVar_ShooterTelemetry_BudgetMs;
+
+	if (bOverBudget && !bWasOverBudget)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Telemetry over budget: %.4f ms per frame on game thread, budget %.4f ms"), AvgFrameMs, CVar_ShooterTelemetry_BudgetMs);
+	}
+	else if (!bOverBudget && bWasOverBudget)
+	{
+		UE_LOG(LogShooter, Log, TEXT("Telemetry back under budget: %.4f ms per frame on game thread"), AvgFrameMs);
+	}
+
+	WindowGameThreadCycles = 0;
+	WindowFrames = 0;
+}
+
+void UShooterTelemetry::Tick(float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	bool bFlushed = false;
+	TimeSinceFlush += DeltaTime;
+	if (TimeSinceFlush >= CVar_ShooterTelemetry_FlushInterval && (!PendingWrite.IsValid() || PendingWrite.IsReady()))
+	{
+		Flush();
+		bFlushed = true;
+	}
+
+	GameThreadBuffer->Cycles += FPlatformTime::Cycles64() - StartCycles;
+
+	// everything game thread spent recording since last tick
+	const uint64 FrameCycles = GameThreadBuffer->Cycles - LastGameThreadCycles;
+	LastGameThreadCycles = GameThreadBuffer->Cycles;
+	TotalGameThreadCycles += FrameCycles;
+	WindowGameThreadCycles += FrameCycles;
+	TotalFrames++;
+	WindowFrames++;
+	MaxFrameMs = FMath::Max(MaxFrameMs, FPlatformTime::ToMilliseconds64(FrameCycles));
+
+	if (bFlushed)
+	{
+		CheckBudget();
+	}
+}
+
+void UShooterTelemetry::DumpStats() const
+{
+	uint64 NumEvents = 0;
+	uint64 OtherThreadCycles = 0;
+	int32 NumThreads = 0;
+	{
+		FScopeLock Lock(const_cast<FCriticalSection*>(&ThreadBuffersLock));
+		for (const FShooterTelemetryThreadBuffer* Buffer : ThreadBuffers)
+		{
+			NumEvents += Buffer->NumEvents;
+			OtherThreadCycles += (Buffer != GameThreadBuffer) ? Buffer->Cycles : 0;
+		}
+		NumThreads = ThreadBuffers.Num();
+	}
+
+	const double AvgFrameMs = TotalFrames > 0 ? FPlatformTime::ToMilliseconds64(TotalGameThreadCycles) / TotalFrames : 0.0;
+
+	UE_LOG(LogShooter, Log, TEXT("Telemetry: %s, %llu events (%d dropped) from %d threads, %lld KB written in %d flushes, writer %.3f ms avg"),
+		bRecording ? *FilePath : TEXT("not recording"), NumEvents, NumDroppedEvents.GetValue(), NumThreads, BytesWritten / 1024, NumWrites,
+		NumWrites > 0 ? 1000.0 * TotalWriteTime / NumWrites : 0.0);
+	UE_LOG(LogShooter, Log, TEXT("  game thread %.4f ms per frame avg, %.4f ms max, budget %.4f ms (%s), other threads %.3f ms total"),
+		AvgFrameMs, MaxFrameMs, CVar_ShooterTelemetry_BudgetMs, AvgFrameMs > CVar_ShooterTelemetry_BudgetMs ? TEXT("over") : TEXT("ok"),
+		FPlatformTime::ToMilliseconds64(OtherThreadCycles));
+}
+
+bool UShooterTelemetry::ConvertToCSV(const FString& InFile, const FString& OutFile)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFile))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Can't read telemetry file %s"), *InFile);
+		return false;
+	}
+
+	FShooterTelemetryHeader Header;
+	if (Data.Num() < sizeof(Header))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Telemetry file %s is too short"), *InFile);
+		return false;
+	}
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+
+	if (Header.Magic != ShooterTelemetryMagic || Header.Version != ShooterTelemetryVersion || Header.EventSize != sizeof(FShooterTelemetryEvent))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Telemetry file %s has unsupported version %u, expected %u"), *InFile, Header.Version, ShooterTelemetryVersion);
+		return false;
+	}
+
+	Header.MapName[UE_ARRAY_COUNT(Header.MapName) - 1] = 0;
+	const int32 NumEvents = (Data.Num() - sizeof(Header)) / sizeof(FShooterTelemetryEvent);
+
+	FString CSV;
+	CSV.Reserve(64 * (NumEvents + 1));
+	CSV += TEXT("Time,Type,Detail,PlayerId,OtherId,Value,X,Y,Z\n");
+
+	for (int32 EventIdx = 0; EventIdx < NumEvents; EventIdx++)
+	{
+		FShooterTelemetryEvent Event;
+		FMemory::Memcpy(&Event, Data.GetData() + sizeof(Header) + EventIdx * sizeof(FShooterTelemetryEvent), sizeof(Event));
+
+		CSV += FString::Printf(TEXT("%.3f,%s,%d,%d,%d,%.2f,%.1f,%.1f,%.1f\n"), Event.Time,
+			Event.Type < EShooterTelemetryEvent::MAX ? ShooterTelemetryEventNames[Event.Type] : TEXT("Unknown"),
+			Event.Detail, Event.PlayerId, Event.OtherId, Event.Value, Event.X, Event.Y, Event.Z);
+	}
+
+	if (!FFileHelper::SaveStringToFile(CSV, *OutFile))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Can't write %s"), *OutFile);
+		return false;
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Converted %d events of %s recorded %s UTC to %s"), NumEvents, ANSI_TO_TCHAR(Header.MapName), *FDateTime(Header.StartTicks).ToString(), *OutFile);
+	return true;
+}
+
+void UShooterTelemetry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bRecording = false;
+	TlsSlot = FPlatformTLS::AllocTlsSlot();
+	GameThreadBuffer = NULL;
+	FlushGeneration = 0;
+	FileHandle = NULL;
+	TimeSinceFlush = 0.0f;
+	NumPendingChunks = 0;
+	BytesWritten = 0;
+	MaxFileBytes = 0;
+	bFileFull = false;
+	NumWrites = 0;
+	TotalWriteTime = 0.0;
+	LastGameThreadCycles = 0;
+	TotalGameThreadCycles = 0;
+	WindowGameThreadCycles = 0;
+	TotalFrames = 0;
+	WindowFrames = 0;
+	MaxFrameMs = 0.0;
+	bOverBudget = false;
+}
+
+void UShooterTelemetry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!CVar_ShooterTelemetry_Enable || !InWorld.IsGameWorld() || InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const FDateTime StartTime = FDateTime::UtcNow();
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("Telemetry");
+	FilePath = Directory / FString::Printf(TEXT("%s_%s.sgtl"), *InWorld.GetMapName(), *StartTime.ToString());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Directory);
+	DeleteOldFiles(Directory);
+
+	MaxFileBytes = (int64)FMath::Max(CVar_ShooterTelemetry_MaxFileMB, 1) << 20;
+	FileHandle = PlatformFile.OpenWrite(*FilePath);
+	if (FileHandle == NULL)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Can't open telemetry file %s"), *FilePath);
+		return;
+	}
+
+	FShooterTelemetryHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = ShooterTelemetryMagic;
+	Header.Version = ShooterTelemetryVersion;
+	Header.EventSize = sizeof(FShooterTelemetryEvent);
+	Header.StartTicks = StartTime.GetTicks();
+	FCStringAnsi::Strncpy(Header.MapName, TCHAR_TO_ANSI(*InWorld.GetMapName()), UE_ARRAY_COUNT(Header.MapName));
+	FileHandle->Write((const uint8*)&Header, sizeof(Header));
+
+	GameThreadBuffer = GetThreadBuffer();
+	bRecording = true;
+
+	UE_LOG(LogShooter, Log, TEXT("Recording telemetry to %s"), *FilePath);
+}
+
+void UShooterTelemetry::DeleteOldFiles(const FString& Directory) const
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	TArray<FString> Files;
+	FileManager.FindFiles(Files, *(Directory / TEXT("*.sgtl")), true, false);
+	for (FString& File : Files)
+	{
+		File = Directory / File;
+	}
+
+	// oldest first, leave room for the file about to be opened
+	Files.Sort([&FileManager](const FString& A, const FString& B) { return FileManager.GetTimeStamp(*A) < FileManager.GetTimeStamp(*B); });
+	const int32 NumToDelete = Files.Num() - FMath::Max(CVar_ShooterTelemetry_MaxFiles - 1, 0);
+	for (int32 Idx = 0; Idx < NumToDelete; Idx++)
+	{
+		FileManager.Delete(*Files[Idx]);
+	}
+}
+
+ETickableTickType UShooterTelemetry::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterTelemetry::IsTickable() const
+{
+	return bRecording;
+}
+
+TStatId UShooterTelemetry::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterTelemetry, STATGROUP_Tickables);
+}
+
+UWorld* UShooterTelemetry::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterTelemetry::Deinitialize()
+{
+	if (PendingWrite.IsValid())
+	{
+		PendingWrite.Wait();
+	}
+
+	if (bRecording)
+	{
+		// world is going away, write what every thread has left
+		bRecording = false;
+		for (FShooterTelemetryThreadBuffer* Buffer : ThreadBuffers)
+		{
+			if (Buffer->Chunk && Buffer->Chunk->Num > 0)
+			{
+				PendingChunks.Enqueue(Buffer->Chunk);
+				FPlatformAtomics::InterlockedIncrement(&NumPendingChunks);
+				Buffer->Chunk = NULL;
+			}
+		}
+		WritePendingChunks();
+		DumpStats();
+	}
+
+	delete FileHandle;
+	FileHandle = NULL;
+
+	FShooterTelemetryChunk* Chunk = NULL;
+	while (PendingChunks.Dequeue(Chunk))
+	{
+		delete Chunk;
+	}
+	while ((Chunk = FreeChunks.Pop()) != NULL)
+	{
+		delete Chunk;
+	}
+	for (FShooterTelemetryThreadBuffer* Buffer : ThreadBuffers)
+	{
+		delete Buffer->Chunk;
+		delete Buffer;
+	}
+	ThreadBuffers.Empty();
+	GameThreadBuffer = NULL;
+	FPlatformTLS::FreeTlsSlot(TlsSlot);
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterTelemetryStatsCmd(TEXT("ShooterTelemetry.Stats"), TEXT("[server] Prints recorded events, bytes written and game thread cost against ShooterTelemetry.BudgetMs."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterTelemetry* Telemetry = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterTelemetry>() : NULL;
+		if (Telemetry)
+		{
+			Telemetry->DumpStats();
+		}
+	})
+);
+
+UShooterTelemetryCommandlet::UShooterTelemetryCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UShooterTelemetryCommandlet::Main(const FString& Params)
+{
+	FString InFile;
+	if (!FParse::Value(*Params, TEXT("In="), InFile))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Usage: -run=ShooterTelemetry -In=<file.sgtl> [-Out=<file.csv>]"));
+		return 1;
+	}
+
+	FString OutFile;
+	if (!FParse::Value(*Params, TEXT("Out="), OutFile))
+	{
+		OutFile = FPaths::ChangeExtension(InFile, TEXT("csv"));
+	}
+
+	return UShooterTelemetry::ConvertToCSV(InFile, OutFile) ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterTickRateController.h"
+
+int32 CVar_ShooterTickRate_Adaptive = 1;
+static FAutoConsoleVariableRef CVarShooterTickRateAdaptive(TEXT("ShooterTickRate.Adaptive"), CVar_ShooterTickRate_Adaptive, TEXT("Adjust dedicated server tick rate to load and number of connections"), ECVF_Default );
+
+int32 CVar_ShooterTickRate_Min = 20;
+static FAutoConsoleVariableRef CVarShooterTickRateMin(TEXT("ShooterTickRate.Min"), CVar_ShooterTickRate_Min, TEXT("Lowest tick rate the server drops to"), ECVF_Default );
+
+int32 CVar_ShooterTickRate_Max = 0;
+static FAutoConsoleVariableRef CVarShooterTickRateMax(TEXT("ShooterTickRate.Max"), CVar_ShooterTickRate_Max, TEXT("Highest tick rate the server goes up to, 0 uses NetServerMaxTickRate from config"), ECVF_Default );
+
+int32 CVar_ShooterTickRate_Step = 5;
+static FAutoConsoleVariableRef CVarShooterTickRateStep(TEXT("ShooterTickRate.Step"), CVar_ShooterTickRate_Step, TEXT("Tick rate change per adjustment"), ECVF_Default );
+
+float CVar_ShooterTickRate_Interval = 2.0f;
+static FAutoConsoleVariableRef CVarShooterTickRateInterval(TEXT("ShooterTickRate.Interval"), CVar_ShooterTickRate_Interval, TEXT("Seconds of frames averaged before each adjustment"), ECVF_Default );
+
+float CVar_ShooterTickRate_HighLoad = 0.8f;
+static FAutoConsoleVariableRef CVarShooterTickRateHighLoad(TEXT("ShooterTickRate.HighLoad"), CVar_ShooterTickRate_HighLoad, TEXT("Fraction of frame time above which tick rate steps down"), ECVF_Default );
+
+float CVar_ShooterTickRate_LowLoad = 0.6f;
+static FAutoConsoleVariableRef CVarShooterTickRateLowLoad(TEXT("ShooterTickRate.LowLoad"), CVar_ShooterTickRate_LowLoad, TEXT("Fraction of frame time at the next rate up below which tick rate steps up"), ECVF_Default );
+
+int32 CVar_ShooterTickRate_FullRateConnections = 16;
+static FAutoConsoleVariableRef CVarShooterTickRateFullRateConnections(TEXT("ShooterTickRate.FullRateConnections"), CVar_ShooterTickRate_FullRateConnections, TEXT("Client connections up to which Max is allowed"), ECVF_Default );
+
+int32 CVar_ShooterTickRate_MinRateConnections = 64;
+static FAutoConsoleVariableRef CVarShooterTickRateMinRateConnections(TEXT("ShooterTickRate.MinRateConnections"), CVar_ShooterTickRate_MinRateConnections, TEXT("Client connections at which upper bound reaches Min"), ECVF_Default );
+
+FOnShooterServerTickRateChanged UShooterTickRateController::NotifyServerTickRateChanged;
+
+int32 UShooterTickRateController::GetMaxTickRate(int32 NumConnections) const
+{
+	const int32 MaxTickRate = CVar_ShooterTickRate_Max > 0 ? CVar_ShooterTickRate_Max : ConfiguredTickRate;
+	const int32 MinTickRate = FMath::Clamp(CVar_ShooterTickRate_Min, 1, MaxTickRate);
+	if (NumConnections <= CVar_ShooterTickRate_FullRateConnections)
+	{
+		return MaxTickRate;
+	}
+
+	const float Alpha = FMath::Clamp((float)(NumConnections - CVar_ShooterTickRate_FullRateConnections) / FMath::Max(CVar_ShooterTickRate_MinRateConnections - CVar_ShooterTickRate_FullRateConnections, 1), 0.0f, 1.0f);
+	return FMath::RoundToInt(FMath::Lerp((float)MaxTickRate, (float)MinTickRate, Alpha));
+}
+
+void UShooterTickRateController::SetTickRate(UNetDriver* NetDriver, int32 NewTickRate)
+{
+	TickRate = NewTickRate;
+	NetDriver->NetServerMaxTickRate = NewTickRate;
+	NotifyServerTickRateChanged.Broadcast(NetDriver, NewTickRate);
+}
+
+void UShooterTickRateController::Tick(float DeltaTime)
+{
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == NULL)
+	{
+		return;
+	}
+
+	if (TickRate == 0)
+	{
+		ConfiguredTickRate = NetDriver->NetServerMaxTickRate;
+		TickRate = ConfiguredTickRate;
+	}
+
+	if (!CVar_ShooterTickRate_Adaptive)
+	{
+		if (TickRate != ConfiguredTickRate)
+		{
+			UE_LOG(LogShooter, Log, TEXT("Server tick rate %d -> %d Hz: adaptive tick rate turned off"), TickRate, ConfiguredTickRate);
+			SetTickRate(NetDriver, ConfiguredTickRate);
+		}
+		return;
+	}
+
+	// GGameThreadTime is work of last frame, without the wait for next tick
+	WindowGameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	WindowFrames++;
+	WindowTime += DeltaTime;
+	if (WindowTime < CVar_ShooterTickRate_Interval)
+	{
+		return;
+	}
+
+	LastGameThreadMs = WindowGameThreadMs / WindowFrames;
+	WindowGameThreadMs = 0.0;
+	WindowFrames = 0;
+	WindowTime = 0.0f;
+
+	const int32 NumConnections = NetDriver->ClientConnections.Num();
+	const int32 MaxTickRate = GetMaxTickRate(NumConnections);
+	const int32 MinTickRate = FMath::Clamp(CVar_ShooterTickRate_Min, 1, MaxTickRate);
+	const int32 Step = FMath::Max(CVar_ShooterTickRate_Step, 1);
+
+	// step up only with room to spare at the higher rate, so it doesn't bounce back down on the next window
+	int32 NewTickRate = TickRate;
+	if (LastGameThreadMs > CVar_ShooterTickRate_HighLoad * 1000.0f / TickRate)
+	{
+		NewTickRate = TickRate - Step;
+	}
+	else if (LastGameThreadMs < CVar_ShooterTickRate_LowLoad * 1000.0f / (TickRate + Step))
+	{
+		NewTickRate = TickRate + Step;
+	}
+	NewTickRate = FMath::Clamp(NewTickRate, MinTickRate, MaxTickRate);
+
+	if (NewTickRate != TickRate)
+	{
+		UE_LOG(LogShooter, Log, TEXT("Server tick rate %d -> %d Hz: game thread %.2f ms of %.2f ms, %d connections, bounds %d-%d Hz"),
+			TickRate, NewTickRate, LastGameThreadMs, 1000.0f / TickRate, NumConnections, MinTickRate, MaxTickRate);
+
+		NumRateChanges++;
+		SetTickRate(NetDriver, NewTickRate);
+	}
+}
+
+void UShooterTickRateController::DumpStats() const
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+
+	UE_LOG(LogShooter, Log, TEXT("Server tick rate: %d Hz (%s, configured %d Hz, bounds %d-%d Hz for %d connections), game thread %.2f ms avg, %d changes"),
+		TickRate, CVar_ShooterTickRate_Adaptive ? TEXT("adaptive") : TEXT("fixed"), ConfiguredTickRate, FMath::Clamp(CVar_ShooterTickRate_Min, 1, GetMaxTickRate(NumConnections)),
+		GetMaxTickRate(NumConnections), NumConnections, LastGameThreadMs, NumRateChanges);
+}
+
+void UShooterTickRateController::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ConfiguredTickRate = 0;
+	TickRate = 0;
+	WindowGameThreadMs = 0.0;
+	WindowFrames = 0;
+	WindowTime = 0.0f;
+	LastGameThreadMs = 0.0f;
+	NumRateChanges = 0;
+}
+
+ETickableTickType UShooterTickRateController::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UShooterTickRateController::IsTickable() const
+{
+	// listen servers and standalone are limited by the client frame rate instead
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && World->GetNetMode() == NM_DedicatedServer;
+}
+
+TStatId UShooterTickRateController::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterTickRateController, STATGROUP_Tickables);
+}
+
+UWorld* UShooterTickRateController::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UShooterTickRateController::Deinitialize()
+{
+	// net driver is kept on seamless travel, next map starts from config again
+	UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : NULL;
+	if (NetDriver && TickRate > 0 && TickRate != ConfiguredTickRate)
+	{
+		SetTickRate(NetDriver, ConfiguredTickRate);
+	}
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterTickRateStatsCmd(TEXT("ShooterTickRate.Stats"), TEXT("[server] Prints current server tick rate, its bounds and game thread time."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterTickRateController* TickRateController = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterTickRateController>() : NULL;
+		if (TickRateController)
+		{
+			TickRateController->DumpStats();
+		}
+	})
+);
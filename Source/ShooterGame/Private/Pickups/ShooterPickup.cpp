@@ -2,6 +2,8 @@
 
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Online/ShooterTelemetry.h"
 #include "Particles/ParticleSystemComponent.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -38,6 +40,18 @@ void AShooterPickup::BeginPlay()
 	if (GameMode)
 	{
 		GameMode->LevelPickups.Add(this);
+		GetWorld()->GetSubsystem<UShooterPickupRegistry>()->RegisterPickup(this, bIsActive);
+	}
+}
+
+void AShooterPickup::Reset()
+{
+	Super::Reset();
+
+	GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+	if (!bIsActive)
+	{
+		RespawnPickup();
 	}
 }
 
@@ -65,6 +79,11 @@ void AShooterPickup::PickupOnTouch(class AShooterCharacter* Pawn)
 			GivePickupTo(Pawn);
 			PickedUpBy = Pawn;
 
+			if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+			{
+				Telemetry->Record(EShooterTelemetryEvent::Pickup, 0, Pawn->GetPlayerState(), NULL, 0.0f, GetActorLocation());
+			}
+
 			if (!IsPendingKill())
 			{
 				bIsActive = false;
@@ -96,6 +115,8 @@ void AShooterPickup::RespawnPickup()
 
 void AShooterPickup::OnPickedUp()
 {
+	GetWorld()->GetSubsystem<UShooterPickupRegistry>()->SetPickupActive(this, false);
+
 	if (RespawningFX)
 	{
 		PickupPSC->SetTemplate(RespawningFX);
@@ -116,6 +137,8 @@ void AShooterPickup::OnPickedUp()
 
 void AShooterPickup::OnRespawned()
 {
+	GetWorld()->GetSubsystem<UShooterPickupRegistry>()->SetPickupActive(this, true);
+
 	if (ActiveFX)
 	{
 		PickupPSC->SetTemplate(ActiveFX);
@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickup_Health.h"
+#include "NavigationSystem.h"
+#include "Algo/BinarySearch.h"
+
+int32 CVar_ShooterPickups_UsePathCost = 1;
+static FAutoConsoleVariableRef CVarShooterPickupsUsePathCost(TEXT("ShooterPickups.UsePathCost"), CVar_ShooterPickups_UsePathCost, TEXT("Rank closest pickups by navmesh path cost instead of straight distance"), ECVF_Default );
+
+int32 CVar_ShooterPickups_PathCandidates = 3;
+static FAutoConsoleVariableRef CVarShooterPickupsPathCandidates(TEXT("ShooterPickups.PathCandidates"), CVar_ShooterPickups_PathCandidates, TEXT("Number of closest pickups ranked by path cost"), ECVF_Default );
+
+float CVar_ShooterPickups_PathCacheCellSize = 500.0f;
+static FAutoConsoleVariableRef CVarShooterPickupsPathCacheCellSize(TEXT("ShooterPickups.PathCacheCellSize"), CVar_ShooterPickups_PathCacheCellSize, TEXT("Start locations closer than this share cached path costs"), ECVF_Default );
+
+/** path cost cache is flushed when it grows past this */
+static const int32 ShooterPickupsMaxCachedPaths = 4096;
+
+EShooterPickupKind::Type UShooterPickupRegistry::GetPickupKind(const AShooterPickup* Pickup)
+{
+	if (Pickup->IsA(AShooterPickup_Ammo::StaticClass()))
+	{
+		return EShooterPickupKind::Ammo;
+	}
+	if (Pickup->IsA(AShooterPickup_Health::StaticClass()))
+	{
+		return EShooterPickupKind::Health;
+	}
+	return EShooterPickupKind::Other;
+}
+
+void UShooterPickupRegistry::RegisterPickup(AShooterPickup* Pickup, bool bActive)
+{
+	if (Pickup == NULL || PickupIndices.Contains(Pickup))
+	{
+		return;
+	}
+
+	const int32 PickupIndex = Pickups.Add(Pickup);
+	ActiveBits.Add(bActive);
+	PickupIndices.Add(Pickup, PickupIndex);
+
+	const EShooterPickupKind::Type Kind = GetPickupKind(Pickup);
+	const AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(Pickup);
+	UClass* WeaponType = AmmoPickup ? AmmoPickup->GetWeaponType() : NULL;
+
+	FShooterPickupGroup* Group = Groups.FindByPredicate([Kind, WeaponType](const FShooterPickupGroup& TestGroup)
+	{
+		return TestGroup.Kind == Kind && TestGroup.WeaponType == WeaponType;
+	});
+	if (Group == NULL)
+	{
+		Group = &Groups.AddDefaulted_GetRef();
+		Group->Kind = Kind;
+		Group->WeaponType = WeaponType;
+	}
+
+	// pickups don't move, keep group sorted on insert
+	const float X = Pickup->GetActorLocation().X;
+	const int32 InsertAt = Algo::UpperBound(Group->SortedX, X);
+	Group->SortedX.Insert(X, InsertAt);
+	Group->Indices.Insert(PickupIndex, InsertAt);
+}
+
+void UShooterPickupRegistry::SetPickupActive(AShooterPickup* Pickup, bool bActive)
+{
+	const int32* PickupIndex = PickupIndices.Find(Pickup);
+	if (PickupIndex)
+	{
+		ActiveBits[*PickupIndex] = bActive;
+	}
+}
+
+AShooterPickup* UShooterPickupRegistry::FindNearestPickup(EShooterPickupKind::Type Kind, UClass* WeaponClass, const FVector& Location, TFunctionRef<bool(AShooterPickup*)> Filter, APawn* Querier)
+{
+	struct FCandidate
+	{
+		int32 PickupIndex;
+		float DistSq;
+	};
+	TArray<FCandidate, TInlineAllocator<8>> Candidates;
+
+	const bool bUsePathCost = Querier && CVar_ShooterPickups_UsePathCost;
+	const int32 MaxCandidates = bUsePathCost ? FMath::Max(CVar_ShooterPickups_PathCandidates, 1) : 1;
+
+	// distance of worst kept candidate, nothing further can make the list
+	auto GetCutoffDistSq = [&Candidates, MaxCandidates]()
+	{
+		return Candidates.Num() < MaxCandidates ? MAX_FLT : Candidates.Last().DistSq;
+	};
+
+	auto TryAdd = [&](int32 PickupIndex)
+	{
+		if (!ActiveBits[PickupIndex])
+		{
+			return;
+		}
+
+		AShooterPickup* Pickup = Pickups[PickupIndex];
+		const float DistSq = FVector::DistSquared(Pickup->GetActorLocation(), Location);
+		if (DistSq < GetCutoffDistSq() && Filter(Pickup))
+		{
+			const int32 InsertAt = Algo::UpperBoundBy(Candidates, DistSq, &FCandidate::DistSq);
+			Candidates.Insert({ PickupIndex, DistSq }, InsertAt);
+			if (Candidates.Num() > MaxCandidates)
+			{
+				Candidates.Pop(false);
+			}
+		}
+	};
+
+	for (const FShooterPickupGroup& Group : Groups)
+	{
+		if (Group.Kind != Kind || (WeaponClass && (Group.WeaponType == NULL || !Group.WeaponType->IsChildOf(WeaponClass))))
+		{
+			continue;
+		}
+
+		// sweep outwards from query X in both directions
+		const int32 Split = Algo::LowerBound(Group.SortedX, Location.X);
+		for (int32 Idx = Split; Idx < Group.SortedX.Num() && FMath::Square(Group.SortedX[Idx] - Location.X) < GetCutoffDistSq(); Idx++)
+		{
+			TryAdd(Group.Indices[Idx]);
+		}
+		for (int32 Idx = Split - 1; Idx >= 0 && FMath::Square(Group.SortedX[Idx] - Location.X) < GetCutoffDistSq(); Idx--)
+		{
+			TryAdd(Group.Indices[Idx]);
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return NULL;
+	}
+
+	int32 BestIndex = Candidates[0].PickupIndex;
+	if (bUsePathCost && Candidates.Num() > 1)
+	{
+		float BestCost = MAX_FLT;
+		for (const FCandidate& Candidate : Candidates)
+		{
+			const float Cost = GetPathCost(Querier, Location, Candidate.PickupIndex);
+			if (Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestIndex = Candidate.PickupIndex;
+			}
+		}
+	}
+
+	return Pickups[BestIndex];
+}
+
+float UShooterPickupRegistry::GetPathCost(APawn* Querier, const FVector& Location, int32 PickupIndex)
+{
+	const float CellSize = FMath::Max(CVar_ShooterPickups_PathCacheCellSize, 1.0f);
+	const TPair<FIntVector, int32> Key(FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize)), PickupIndex);
+
+	const float* CachedCost = PathCostCache.Find(Key);
+	if (CachedCost)
+	{
+		return *CachedCost;
+	}
+
+	// fall back to straight distance when there's no navmesh, unreachable pickups go last
+	float Cost = FVector::Dist(Pickups[PickupIndex]->GetActorLocation(), Location);
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(Querier->GetNavAgentPropertiesRef()) : NULL;
+	if (NavData)
+	{
+		float PathCost = 0.0f;
+		const ENavigationQueryResult::Type Result = NavSys->GetPathCost(Location, Pickups[PickupIndex]->GetActorLocation(), PathCost, NavData);
+		Cost = (Result == ENavigationQueryResult::Success) ? PathCost : MAX_FLT;
+	}
+
+	if (PathCostCache.Num() >= ShooterPickupsMaxCachedPaths)
+	{
+		PathCostCache.Reset();
+	}
+	PathCostCache.Add(Key, Cost);
+
+	return Cost;
+}
+
+int32 UShooterPickupRegistry::GetNumActivePickups() const
+{
+	return ActiveBits.CountSetBits();
+}
+
+void UShooterPickupRegistry::Deinitialize()
+{
+	Pickups.Empty();
+	ActiveBits.Empty();
+	PickupIndices.Empty();
+	Groups.Empty();
+	PathCostCache.Empty();
+
+	Super::Deinitialize();
+}
@@ -3,8 +3,13 @@
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon.h"
 #include "Weapons/ShooterDamageType.h"
+#include "Weapons/ShooterDamageGrid.h"
+#include "Player/ShooterPawnIndex.h"
+#include "Player/ShooterPawnPool.h"
+#include "Bots/ShooterInfluenceMap.h"
 #include "UI/ShooterHUD.h"
 #include "Online/ShooterPlayerState.h"
+#include "Online/ShooterTelemetry.h"
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimInstance.h"
 #include "Sound/SoundNodeLocalPlayer.h"
@@ -67,6 +72,8 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	LowHealthPercentage = 0.5f;
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
+	PoolGeneration = 0;
+	bReturnToPool = false;
 }
 
 void AShooterCharacter::PostInitializeComponents()
@@ -77,6 +84,18 @@ void AShooterCharacter::PostInitializeComponents()
 	{
 		Health = GetMaxHealth();
 
+		UShooterDamageGrid* DamageGrid = GetWorld()->GetSubsystem<UShooterDamageGrid>();
+		if (DamageGrid)
+		{
+			DamageGrid->RegisterActor(this);
+		}
+
+		UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+		if (PawnIndex)
+		{
+			PawnIndex->RegisterPawn(this);
+		}
+
 		// Needs to happen after character is added to repgraph
 		GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
 	}
@@ -90,7 +109,11 @@ void AShooterCharacter::PostInitializeComponents()
 		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
 	}
 
-	// play respawn effects
+	PlayRespawnEffects();
+}
+
+void AShooterCharacter::PlayRespawnEffects()
+{
 	if (GetNetMode() != NM_DedicatedServer)
 	{
 		if (RespawnFX)
@@ -109,6 +132,46 @@ void AShooterCharacter::Destroyed()
 {
 	Super::Destroyed();
 	DestroyInventory();
+
+	UShooterDamageGrid* DamageGrid = GetWorld()->GetSubsystem<UShooterDamageGrid>();
+	if (DamageGrid)
+	{
+		DamageGrid->UnregisterActor(this);
+	}
+
+	UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+	if (PawnIndex)
+	{
+		PawnIndex->UnregisterPawn(this);
+	}
+}
+
+void AShooterCharacter::Reset()
+{
+	// parked pawns wait for next match
+	if (IsInPool())
+	{
+		return;
+	}
+
+	if (UShooterPawnPool::IsEnabled(GetWorld()))
+	{
+		GetWorldTimerManager().ClearTimer(TimerHandle_ReturnToPool);
+		DetachFromControllerPendingDestroy();
+		SetCurrentWeapon(NULL);
+		Health = FMath::Min(0.0f, Health);
+
+		UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+		if (PawnIndex)
+		{
+			PawnIndex->UnregisterPawn(this);
+		}
+
+		ReturnToPool();
+		return;
+	}
+
+	Super::Reset();
 }
 
 void AShooterCharacter::PawnClientRestart()
@@ -167,10 +230,12 @@ bool AShooterCharacter::IsEnemyFor(AController* TestPC) const
 	bool bIsEnemy = true;
 	if (GetWorld()->GetGameState())
 	{
-		const AShooterGameMode* DefGame = GetWorld()->GetGameState()->GetDefaultGameMode<AShooterGameMode>();
+		// rules can be picked by URL, default object only knows the ones of its class
+		const AShooterGameMode* Game = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		const AShooterGameMode* DefGame = Game ? Game : GetWorld()->GetGameState()->GetDefaultGameMode<AShooterGameMode>();
 		if (DefGame && MyPlayerState && TestPlayerState)
 		{
-			bIsEnemy = DefGame->CanDealDamage(TestPlayerState, MyPlayerState);
+			bIsEnemy = DefGame->GetRelation(TestPlayerState, MyPlayerState) == EShooterRuleRelation::Enemy;
 		}
 	}
 
@@ -269,12 +334,18 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 
 	// Modify based on game rules.
 	AShooterGameMode* const Game = GetWorld()->GetAuthGameMode<AShooterGameMode>();
-	Damage = Game ? Game->ModifyDamage(Damage, this, DamageEvent, EventInstigator, DamageCauser) : 0.f;
+	Damage = Game ? Game->ModifyDamage(Damage, this, EventInstigator) : 0.f;
 
 	const float ActualDamage = Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
 	if (ActualDamage > 0.f)
 	{
 		Health -= ActualDamage;
+
+		if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+		{
+			Telemetry->Record(EShooterTelemetryEvent::Damage, 0, EventInstigator ? EventInstigator->PlayerState : NULL, GetPlayerState(), ActualDamage, GetActorLocation());
+		}
+
 		if (Health <= 0)
 		{
 			Die(ActualDamage, DamageEvent, EventInstigator, DamageCauser);
@@ -338,13 +409,30 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	}
 
 	SetReplicatingMovement(false);
-	TearOff();
 	bIsDying = true;
 
+	// pooled pawns keep their channel, clients play death from LastTakeHitInfo and learn about reuse from PoolGeneration
+	bReturnToPool = GetLocalRole() == ROLE_Authority && UShooterPawnPool::IsEnabled(GetWorld());
+	if (bReturnToPool)
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_ReturnToPool, this, &AShooterCharacter::ReturnToPool, UShooterPawnPool::GetCorpseTime(), false);
+	}
+	else
+	{
+		TearOff();
+	}
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		ReplicateHit(KillingDamage, DamageEvent, PawnInstigator, DamageCauser, true);
 
+		// no longer a target
+		UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+		if (PawnIndex)
+		{
+			PawnIndex->UnregisterPawn(this);
+		}
+
 		// play the force feedback effect on the client player controller
 		AShooterPlayerController* PC = Cast<AShooterPlayerController>(Controller);
 		if (PC && DamageEvent.DamageTypeClass)
@@ -365,8 +453,15 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 		UGameplayStatics::PlaySoundAtLocation(this, DeathSound, GetActorLocation());
 	}
 
-	// remove all weapons
-	DestroyInventory();
+	// remove all weapons, pooled pawns only holster them for next life
+	if (bReturnToPool)
+	{
+		SetCurrentWeapon(NULL);
+	}
+	else
+	{
+		DestroyInventory();
+	}
 
 	// switch back to 3rd person view
 	UpdatePawnMeshes();
@@ -493,20 +588,133 @@ void AShooterCharacter::SetRagdollPhysics()
 		// hide and set short lifespan
 		TurnOff();
 		SetActorHiddenInGame(true);
-		SetLifeSpan(1.0f);
+	}
+
+	// pooled pawns are parked by TimerHandle_ReturnToPool instead
+	if (!bReturnToPool)
+	{
+		SetLifeSpan(bInRagdoll ? 10.0f : 1.0f);
+	}
+}
+
+void AShooterCharacter::ReturnToPool()
+{
+	UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+	if (PawnPool)
+	{
+		PawnPool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AShooterCharacter::EnterPool()
+{
+	PoolGeneration++;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetMesh()->SetSimulatePhysics(false);
+
+	// nothing changes while parked
+	NetUpdateFrequency = 1.0f;
+	ForceNetUpdate();
+}
+
+void AShooterCharacter::LeavePool(const FTransform& SpawnTransform)
+{
+	PoolGeneration++;
+	bReturnToPool = false;
+	Health = GetMaxHealth();
+
+	NetUpdateFrequency = GetDefault<AShooterCharacter>()->NetUpdateFrequency;
+	SetReplicatingMovement(true);
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, NULL, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	ResetForRespawn();
+
+	UShooterPawnIndex* PawnIndex = GetWorld()->GetSubsystem<UShooterPawnIndex>();
+	if (PawnIndex)
+	{
+		PawnIndex->RegisterPawn(this);
+	}
+
+	// same as new pawns, after pawn is possessed
+	GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::RestoreInventory);
+	ForceNetUpdate();
+}
+
+void AShooterCharacter::OnRep_PoolGeneration()
+{
+	if (IsInPool())
+	{
+		SetActorTickEnabled(false);
+		GetMesh()->SetSimulatePhysics(false);
 	}
 	else
 	{
-		SetLifeSpan(10.0f);
+		ResetForRespawn();
 	}
 }
 
+void AShooterCharacter::ResetForRespawn()
+{
+	const AShooterCharacter* DefaultCharacter = GetClass()->GetDefaultObject<AShooterCharacter>();
+
+	bIsDying = false;
+	bIsTargeting = false;
+	bWantsToRun = false;
+	bWantsToRunToggled = false;
+	bWantsToFire = false;
+	LastTakeHitTimeTimeout = 0.0f;
+	StopAllAnimMontages();
+
+	// simulating detached mesh from capsule, put it back
+	USkeletalMeshComponent* PawnMesh = GetMesh();
+	const USkeletalMeshComponent* DefaultMesh = DefaultCharacter->GetMesh();
+	PawnMesh->SetSimulatePhysics(false);
+	PawnMesh->bBlendPhysics = DefaultMesh->bBlendPhysics;
+	PawnMesh->bPauseAnims = false;
+	PawnMesh->KinematicBonesUpdateToPhysics = DefaultMesh->KinematicBonesUpdateToPhysics;
+	PawnMesh->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	PawnMesh->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+
+	// death switched mesh to ragdoll profile and turned off capsule
+	auto RestoreCollision = [](UPrimitiveComponent* Component, const UPrimitiveComponent* DefaultComponent)
+	{
+		Component->SetCollisionObjectType(DefaultComponent->GetCollisionObjectType());
+		Component->SetCollisionResponseToChannels(DefaultComponent->GetCollisionResponseToChannels());
+		Component->SetCollisionEnabled(DefaultComponent->GetCollisionEnabled());
+	};
+	RestoreCollision(PawnMesh, DefaultMesh);
+	RestoreCollision(GetCapsuleComponent(), DefaultCharacter->GetCapsuleComponent());
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	UpdatePawnMeshes();
+	PlayRespawnEffects();
+}
+
 
 
 void AShooterCharacter::ReplicateHit(float Damage, struct FDamageEvent const& DamageEvent, class APawn* PawnInstigator, class AActor* DamageCauser, bool bKilled)
 {
 	const float TimeoutTime = GetWorld()->GetTimeSeconds() + 0.5f;
 
+	// let bots know this spot is dangerous
+	UShooterInfluenceMap* InfluenceMap = GetWorld()->GetSubsystem<UShooterInfluenceMap>();
+	if (InfluenceMap)
+	{
+		InfluenceMap->AddDamageEvent(GetActorLocation(), Damage);
+	}
+
 	FDamageEvent const& LastDamageEvent = LastTakeHitInfo.GetDamageEvent();
 	if ((PawnInstigator == LastTakeHitInfo.PawnInstigator.Get()) && (LastDamageEvent.DamageTypeClass == LastTakeHitInfo.DamageTypeClass) && (LastTakeHitTimeTimeout == TimeoutTime))
 	{
@@ -564,6 +772,8 @@ void AShooterCharacter::SpawnDefaultInventory()
 		return;
 	}
 
+	const double StartTime = FPlatformTime::Seconds();
+
 	int32 NumWeaponClasses = DefaultInventoryClasses.Num();
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
@@ -581,6 +791,42 @@ void AShooterCharacter::SpawnDefaultInventory()
 	{
 		EquipWeapon(Inventory[0]);
 	}
+
+	UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+	if (PawnPool)
+	{
+		PawnPool->RecordInventory(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void AShooterCharacter::RestoreInventory()
+{
+	if (GetLocalRole() < ROLE_Authority || !IsAlive())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (AShooterWeapon* Weapon : Inventory)
+	{
+		if (Weapon)
+		{
+			Weapon->ResetAmmo();
+		}
+	}
+
+	// equip first weapon in inventory
+	if (Inventory.Num() > 0)
+	{
+		EquipWeapon(Inventory[0]);
+	}
+
+	UShooterPawnPool* PawnPool = GetWorld()->GetSubsystem<UShooterPawnPool>();
+	if (PawnPool)
+	{
+		PawnPool->RecordInventory(FPlatformTime::Seconds() - StartTime);
+	}
 }
 
 void AShooterCharacter::DestroyInventory()
@@ -1212,6 +1458,7 @@ void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > &
 	// everyone
 	DOREPLIFETIME(AShooterCharacter, CurrentWeapon);
 	DOREPLIFETIME(AShooterCharacter, Health);
+	DOREPLIFETIME(AShooterCharacter, PoolGeneration);
 }
 
 bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer)
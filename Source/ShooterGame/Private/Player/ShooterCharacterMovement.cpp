@@ -4,6 +4,9 @@
 #include "ECustomMovementMode.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Player/ShooterCharacterMovement.h"
+#include "Online/ShooterTelemetry.h"
+
+double UShooterCharacterMovement::TotalTickTime = 0.0;
 
 //----------------------------------------------------------------------//
 // UPawnMovementComponent
@@ -20,6 +23,11 @@ bool UShooterCharacterMovement::BeginWallRun()
 	{
 		GetWorld()->GetTimerManager().SetTimer(WallRunTimerHandle, this, &UShooterCharacterMovement::EndWallRun, WallRunTimeMax);
 		SetMovementMode(EMovementMode::MOVE_Custom, ECustomMovementMode::CMOVE_WallRunning);
+
+		if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+		{
+			Telemetry->Record(EShooterTelemetryEvent::WallRun, (uint8)WallSide, CharacterOwner->GetPlayerState(), NULL, 0.0f, CharacterOwner->GetActorLocation());
+		}
 		return true;
 	}
 
@@ -192,7 +200,13 @@ void UShooterCharacterMovement::Teleport()
 	const bool bLimitRotation = (CharacterOwner->GetCharacterMovement()->IsMovingOnGround() || CharacterOwner->GetCharacterMovement()->IsFalling());
 	const FRotator Rotation = bLimitRotation ? CharacterOwner->GetActorRotation() : CharacterOwner->Controller->GetControlRotation();
 	const FVector Direction = FRotationMatrix(Rotation).GetScaledAxis(EAxis::X);
+	const FVector StartLocation = CharacterOwner->GetActorLocation();
 	CharacterOwner->AddActorWorldOffset(Direction * TeleportDistance, true, nullptr, ETeleportType::TeleportPhysics);
+
+	if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+	{
+		Telemetry->Record(EShooterTelemetryEvent::Teleport, 0, CharacterOwner->GetPlayerState(), NULL, FVector::Dist(StartLocation, CharacterOwner->GetActorLocation()), CharacterOwner->GetActorLocation());
+	}
 }
 
 bool UShooterCharacterMovement::CanTeleport()
@@ -243,6 +257,10 @@ FNetworkPredictionData_Client* UShooterCharacterMovement::GetPredictionData_Clie
 void UShooterCharacterMovement::TickComponent(float DeltaTime, ELevelTick TickType,
 	FActorComponentTickFunction* ThisTickFunction)
 {
+#if !UE_BUILD_SHIPPING
+	const double StartTime = FPlatformTime::Seconds();
+#endif
+
 	if (GetPawnOwner()->IsLocallyControlled())
 	{
 		CameraTick();
@@ -268,6 +286,10 @@ void UShooterCharacterMovement::TickComponent(float DeltaTime, ELevelTick TickTy
 		WallRunKeyDown = CanWallRun();
 	}
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+#if !UE_BUILD_SHIPPING
+	TotalTickTime += FPlatformTime::Seconds() - StartTime;
+#endif
 }
 
 void UShooterCharacterMovement::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
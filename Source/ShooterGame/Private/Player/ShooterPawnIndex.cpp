@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPawnIndex.h"
+#include "Online/ShooterPlayerState.h"
+#include "Bots/ShooterAIController.h"
+
+float CVar_ShooterPawnIndex_CellSize = 1000.0f;
+static FAutoConsoleVariableRef CVarShooterPawnIndexCellSize(TEXT("ShooterPawnIndex.CellSize"), CVar_ShooterPawnIndex_CellSize, TEXT("Size of pawn index cell in world units"), ECVF_Default );
+
+void UShooterPawnIndex::RegisterPawn(AShooterCharacter* Pawn)
+{
+	if (Pawn)
+	{
+		RegisteredPawns.AddUnique(Pawn);
+		BuiltFrame = 0;
+	}
+}
+
+void UShooterPawnIndex::UnregisterPawn(AShooterCharacter* Pawn)
+{
+	if (RegisteredPawns.RemoveSingleSwap(Pawn, false) > 0)
+	{
+		BuiltFrame = 0;
+	}
+}
+
+FIntPoint UShooterPawnIndex::GetCellCoords(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(CVar_ShooterPawnIndex_CellSize, 100.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UShooterPawnIndex::UpdateIndex()
+{
+	if (BuiltFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	BuiltFrame = GFrameCounter;
+	MaxPawnRadius = 0.0f;
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+
+	for (TPair<int32, FShooterPawnIndexTeam>& It : Teams)
+	{
+		It.Value.Pawns.Reset();
+		for (TPair<FIntPoint, TArray<AShooterCharacter*>>& CellIt : It.Value.Cells)
+		{
+			CellIt.Value.Reset();
+		}
+	}
+
+	for (AShooterCharacter* Pawn : RegisteredPawns)
+	{
+		if (Pawn == NULL || Pawn->IsPendingKill() || !Pawn->IsAlive())
+		{
+			continue;
+		}
+
+		const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Pawn->GetPlayerState());
+		const int32 TeamNum = PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE;
+		const FIntPoint Cell = GetCellCoords(Pawn->GetActorLocation());
+
+		FShooterPawnIndexTeam& Team = Teams.FindOrAdd(TeamNum);
+		Team.Pawns.Add(Pawn);
+		Team.Cells.FindOrAdd(Cell).Add(Pawn);
+
+		MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+		MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+		MaxPawnRadius = FMath::Max(MaxPawnRadius, Pawn->GetCapsuleComponent()->GetScaledCapsuleRadius());
+	}
+}
+
+void UShooterPawnIndex::FindNearestPawns(const FVector& Location, int32 MaxCount, TArray<AShooterCharacter*>& OutPawns, TFunctionRef<bool(AShooterCharacter*)> Filter, int32 ExcludeTeam)
+{
+	UpdateIndex();
+	if (MaxCount <= 0 || MinCell.X > MaxCell.X)
+	{
+		return;
+	}
+
+	struct FCandidate
+	{
+		AShooterCharacter* Pawn;
+		float DistSq;
+	};
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+
+	const float CellSize = FMath::Max(CVar_ShooterPawnIndex_CellSize, 100.0f);
+	const FIntPoint Center = GetCellCoords(Location);
+	const int32 MaxRing = FMath::Max(FMath::Max(FMath::Abs(Center.X - MinCell.X), FMath::Abs(Center.X - MaxCell.X)),
+		FMath::Max(FMath::Abs(Center.Y - MinCell.Y), FMath::Abs(Center.Y - MaxCell.Y)));
+
+	// walk rings of cells outwards, until nothing closer than current Nth best can be found
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		for (int32 X = Center.X - Ring; X <= Center.X + Ring; X++)
+		{
+			const bool bEdgeColumn = (X == Center.X - Ring || X == Center.X + Ring);
+			const int32 StepY = bEdgeColumn ? 1 : FMath::Max(Ring * 2, 1);
+			for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; Y += StepY)
+			{
+				for (const TPair<int32, FShooterPawnIndexTeam>& TeamIt : Teams)
+				{
+					const TArray<AShooterCharacter*>* Cell = (TeamIt.Key != ExcludeTeam || ExcludeTeam == INDEX_NONE) ? TeamIt.Value.Cells.Find(FIntPoint(X, Y)) : NULL;
+					if (Cell)
+					{
+						for (AShooterCharacter* Pawn : *Cell)
+						{
+							if (Filter(Pawn))
+							{
+								Candidates.Add({ Pawn, FVector::DistSquared(Pawn->GetActorLocation(), Location) });
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (Candidates.Num() >= MaxCount)
+		{
+			Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+
+			// next ring is at least this far away
+			if (Candidates[MaxCount - 1].DistSq <= FMath::Square(Ring * CellSize))
+			{
+				break;
+			}
+		}
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+	for (int32 Idx = 0; Idx < Candidates.Num() && Idx < MaxCount; Idx++)
+	{
+		OutPawns.Add(Candidates[Idx].Pawn);
+	}
+}
+
+void UShooterPawnIndex::FindPawnsInRadius(const FVector& Location, float Radius, TArray<AShooterCharacter*>& OutPawns, int32 ExcludeTeam)
+{
+	UpdateIndex();
+
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint QueryMin = GetCellCoords(Location - FVector(Radius));
+	const FIntPoint QueryMax = GetCellCoords(Location + FVector(Radius));
+
+	for (const TPair<int32, FShooterPawnIndexTeam>& TeamIt : Teams)
+	{
+		if (ExcludeTeam != INDEX_NONE && TeamIt.Key == ExcludeTeam)
+		{
+			continue;
+		}
+
+		for (int32 X = QueryMin.X; X <= QueryMax.X; X++)
+		{
+			for (int32 Y = QueryMin.Y; Y <= QueryMax.Y; Y++)
+			{
+				const TArray<AShooterCharacter*>* Cell = TeamIt.Value.Cells.Find(FIntPoint(X, Y));
+				if (Cell)
+				{
+					for (AShooterCharacter* Pawn : *Cell)
+					{
+						if (FVector::DistSquared(Pawn->GetActorLocation(), Location) <= RadiusSq)
+						{
+							OutPawns.Add(Pawn);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+float UShooterPawnIndex::GetMaxPawnRadius()
+{
+	UpdateIndex();
+	return MaxPawnRadius;
+}
+
+int32 UShooterPawnIndex::GetNumPawns()
+{
+	UpdateIndex();
+
+	int32 NumPawns = 0;
+	for (const TPair<int32, FShooterPawnIndexTeam>& It : Teams)
+	{
+		NumPawns += It.Value.Pawns.Num();
+	}
+	return NumPawns;
+}
+
+void UShooterPawnIndex::GetAlivePawns(TArray<AShooterCharacter*>& OutPawns)
+{
+	UpdateIndex();
+
+	for (const TPair<int32, FShooterPawnIndexTeam>& It : Teams)
+	{
+		OutPawns.Append(It.Value.Pawns);
+	}
+}
+
+void UShooterPawnIndex::Deinitialize()
+{
+	RegisteredPawns.Empty();
+	Teams.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterPawnIndexBenchmarkCmd(TEXT("ShooterPawnIndex.Benchmark"), TEXT("[server] Times closest enemy search for every bot, world iteration vs pawn index. Optional number of iterations. Use SetAllowBots to change bot count."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterPawnIndex* PawnIndex = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterPawnIndex>() : NULL;
+		if (PawnIndex == NULL)
+		{
+			return;
+		}
+
+		const int32 NumIterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+
+		TArray<AShooterAIController*> Bots;
+		for (AShooterAIController* Bot : TActorRange<AShooterAIController>(World))
+		{
+			if (Bot->GetPawn())
+			{
+				Bots.Add(Bot);
+			}
+		}
+
+		int32 NumFoundScan = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (AShooterAIController* Bot : Bots)
+			{
+				const FVector MyLoc = Bot->GetPawn()->GetActorLocation();
+				float BestDistSq = MAX_FLT;
+				AShooterCharacter* BestPawn = NULL;
+				for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(World))
+				{
+					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
+					if (TestPawn->IsAlive() && TestPawn->IsEnemyFor(Bot) && DistSq < BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestPawn = TestPawn;
+					}
+				}
+				NumFoundScan += BestPawn ? 1 : 0;
+			}
+		}
+		const double ScanTime = FPlatformTime::Seconds() - StartTime;
+
+		int32 NumFoundIndex = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (AShooterAIController* Bot : Bots)
+			{
+				TArray<AShooterCharacter*> Found;
+				PawnIndex->FindNearestPawns(Bot->GetPawn()->GetActorLocation(), 1, Found, [Bot](AShooterCharacter* TestPawn) { return TestPawn->IsEnemyFor(Bot); });
+				NumFoundIndex += Found.Num();
+			}
+		}
+		const double IndexTime = FPlatformTime::Seconds() - StartTime;
+
+		const int32 NumQueries = FMath::Max(Bots.Num() * NumIterations, 1);
+		UE_LOG(LogShooter, Log, TEXT("Pawn index benchmark: %d bots, %d pawns, %d iterations: world iteration %.2f us/query (%d found), pawn index %.2f us/query (%d found)"),
+			Bots.Num(), PawnIndex->GetNumPawns(), NumIterations, 1000000.0 * ScanTime / NumQueries, NumFoundScan, 1000000.0 * IndexTime / NumQueries, NumFoundIndex);
+	})
+);
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPawnPool.h"
+
+int32 CVar_ShooterPawnPool_Enable = 0;
+static FAutoConsoleVariableRef CVarShooterPawnPoolEnable(TEXT("ShooterPawnPool.Enable"), CVar_ShooterPawnPool_Enable, TEXT("Park dead pawns and reuse them on respawn instead of destroying and spawning new ones"), ECVF_Default );
+
+int32 CVar_ShooterPawnPool_MaxSize = 64;
+static FAutoConsoleVariableRef CVarShooterPawnPoolMaxSize(TEXT("ShooterPawnPool.MaxSize"), CVar_ShooterPawnPool_MaxSize, TEXT("Max number of parked pawns, extra dead pawns are destroyed"), ECVF_Default );
+
+float CVar_ShooterPawnPool_CorpseTime = 3.0f;
+static FAutoConsoleVariableRef CVarShooterPawnPoolCorpseTime(TEXT("ShooterPawnPool.CorpseTime"), CVar_ShooterPawnPool_CorpseTime, TEXT("Time dead pawn stays visible before it's parked"), ECVF_Default );
+
+bool UShooterPawnPool::IsEnabled(const UWorld* World)
+{
+	return CVar_ShooterPawnPool_Enable > 0 && World && World->GetNetMode() != NM_Client;
+}
+
+float UShooterPawnPool::GetCorpseTime()
+{
+	return FMath::Max(CVar_ShooterPawnPool_CorpseTime, 0.1f);
+}
+
+AShooterCharacter* UShooterPawnPool::Acquire(UClass* PawnClass, const FTransform& SpawnTransform)
+{
+	for (int32 Idx = PooledPawns.Num() - 1; Idx >= 0; Idx--)
+	{
+		AShooterCharacter* Pawn = PooledPawns[Idx];
+		if (Pawn == NULL || Pawn->IsPendingKill())
+		{
+			PooledPawns.RemoveAtSwap(Idx);
+			continue;
+		}
+
+		if (Pawn->GetClass() == PawnClass)
+		{
+			PooledPawns.RemoveAtSwap(Idx);
+			Pawn->LeavePool(SpawnTransform);
+			NumReused++;
+			return Pawn;
+		}
+	}
+
+	return NULL;
+}
+
+void UShooterPawnPool::Release(AShooterCharacter* Pawn)
+{
+	if (Pawn == NULL || Pawn->IsPendingKill())
+	{
+		return;
+	}
+
+	if (PooledPawns.Num() >= CVar_ShooterPawnPool_MaxSize)
+	{
+		Pawn->Destroy();
+		return;
+	}
+
+	Pawn->EnterPool();
+	PooledPawns.Add(Pawn);
+}
+
+void UShooterPawnPool::RecordRespawn(double Seconds)
+{
+	NumRespawns++;
+	TotalRespawnTime += Seconds;
+	MaxRespawnTime = FMath::Max(MaxRespawnTime, Seconds);
+}
+
+void UShooterPawnPool::RecordInventory(double Seconds)
+{
+	TotalRespawnTime += Seconds;
+}
+
+void UShooterPawnPool::DumpStats() const
+{
+	const double Minutes = FMath::Max(FPlatformTime::Seconds() - StartTime, 1.0) / 60.0;
+
+	UE_LOG(LogShooter, Log, TEXT("Pawn pool: %s, %d parked, %d respawns (%d reused), respawn %.3f ms avg %.3f ms max, %d garbage collections (%.2f per minute)"),
+		CVar_ShooterPawnPool_Enable > 0 ? TEXT("enabled") : TEXT("disabled"), PooledPawns.Num(), NumRespawns, NumReused,
+		NumRespawns > 0 ? 1000.0 * TotalRespawnTime / NumRespawns : 0.0, 1000.0 * MaxRespawnTime, NumGarbageCollections, NumGarbageCollections / Minutes);
+}
+
+void UShooterPawnPool::OnPostGarbageCollect()
+{
+	NumGarbageCollections++;
+}
+
+void UShooterPawnPool::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	NumRespawns = 0;
+	NumReused = 0;
+	TotalRespawnTime = 0.0;
+	MaxRespawnTime = 0.0;
+	NumGarbageCollections = 0;
+	StartTime = FPlatformTime::Seconds();
+
+	OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UShooterPawnPool::OnPostGarbageCollect);
+}
+
+void UShooterPawnPool::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+	PooledPawns.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterPawnPoolStatsCmd(TEXT("ShooterPawnPool.Stats"), TEXT("[server] Prints respawn cost, reused pawns and garbage collections per minute."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterPawnPool* PawnPool = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterPawnPool>() : NULL;
+		if (PawnPool)
+		{
+			PawnPool->DumpStats();
+		}
+	})
+);
@@ -59,6 +59,7 @@ AShooterPlayerController::AShooterPlayerController(const FObjectInitializer& Obj
 	bAllowGameActions = true;
 	bGameEndedFrame = false;
 	LastDeathLocation = FVector::ZeroVector;
+	LastKillId = 0;
 
 	ServerSayString = TEXT("Say");
 	ShooterFriendUpdateTimer = 0.0f;
@@ -119,6 +120,11 @@ void AShooterPlayerController::TickActor(float DeltaTime, enum ELevelTick TickTy
 {
 	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
 
+	if (IsLocalController())
+	{
+		UpdateKillFeed();
+	}
+
 	if (IsGameMenuVisible())
 	{
 		if (ShooterFriendUpdateTimer > 0)
@@ -465,6 +471,75 @@ void AShooterPlayerController::OnDeathMessage(class AShooterPlayerState* KillerP
 		ShooterHUD->ShowDeathMessage(KillerPlayerState, KilledPlayerState, KillerDamageType);		
 	}
 
+	UpdateDeathStat(KilledPlayerState);
+}
+
+void AShooterPlayerController::UpdateKillFeed()
+{
+	const AShooterGameState* MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState == NULL)
+	{
+		return;
+	}
+
+	// controller survives seamless travel, new game state counts from 1 again
+	if (KillFeedGameState.Get() != MyGameState)
+	{
+		KillFeedGameState = MyGameState;
+		LastKillId = 0;
+	}
+
+	TArray<const FShooterKillEvent*> NewKills;
+	for (const FShooterKillEvent& Event : MyGameState->GetKillEvents())
+	{
+		if (Event.KillId > LastKillId)
+		{
+			NewKills.Add(&Event);
+		}
+	}
+
+	// replicated items don't keep their order
+	NewKills.Sort([](const FShooterKillEvent& A, const FShooterKillEvent& B) { return A.KillId < B.KillId; });
+
+	// player states can arrive after the kill, stop there and pick it up again on next update
+	for (int32 Idx = 0; Idx < NewKills.Num(); Idx++)
+	{
+		if (!NewKills[Idx]->IsResolved())
+		{
+			NewKills.SetNum(Idx);
+			break;
+		}
+	}
+
+	if (NewKills.Num() == 0)
+	{
+		return;
+	}
+
+	LastKillId = NewKills.Last()->KillId;
+
+	AShooterHUD* ShooterHUD = GetShooterHUD();
+	if (ShooterHUD)
+	{
+		ShooterHUD->ShowDeathMessages(NewKills);
+	}
+
+	for (const FShooterKillEvent* Event : NewKills)
+	{
+		if (Event->Killer && Event->Killer == PlayerState && Event->Victim != PlayerState)
+		{
+			OnKill();
+		}
+
+		if (Event->Victim)
+		{
+			UpdateDeathStat(Event->Victim);
+		}
+	}
+}
+
+void AShooterPlayerController::UpdateDeathStat(class AShooterPlayerState* KilledPlayerState)
+{
 	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
 	if (LocalPlayer && LocalPlayer->GetCachedUniqueNetId().IsValid() && KilledPlayerState->GetUniqueId().IsValid())
 	{
@@ -845,6 +920,18 @@ void AShooterPlayerController::ClientGameEnded_Implementation(class AActor* EndG
 	bGameEndedFrame = true;
 }
 
+void AShooterPlayerController::ClientReset_Implementation()
+{
+	Super::ClientReset_Implementation();
+
+	AShooterHUD* ShooterHUD = GetShooterHUD();
+	if (ShooterHUD)
+	{
+		ShooterHUD->SetMatchState(EShooterMatchState::Warmup);
+		ShooterHUD->ShowScoreboard(false, true);
+	}
+}
+
 void AShooterPlayerController::ClientSendRoundEndEvent_Implementation(bool bIsWinner, int32 ExpendedTimeInSeconds)
 {
 	const UWorld* World = GetWorld();
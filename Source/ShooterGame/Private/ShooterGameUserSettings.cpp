@@ -16,6 +16,8 @@ void UShooterGameUserSettings::SetToDefaults()
 	Super::SetToDefaults();
 
 	GraphicsQuality = 1;	
+	DecalBudgetLow = 32;
+	DecalBudgetHigh = 128;
 	bIsLanMatch = true;
 	bIsDedicatedServer = false;
 	bIsForceSystemResolution = false;
@@ -3,6 +3,23 @@
 #include "ShooterGame.h"
 #include "ShooterTypes.h"
 #include "ShooterCharacter.h"
+#include "Weapons/ShooterDamageTypeRegistry.h"
+
+/** event kinds on the wire, 2 bits */
+namespace ETakeHitInfoEvent
+{
+	enum Type : uint8
+	{
+		General,
+		Point,
+		Radial,
+	};
+}
+
+/** sizes of written updates, counts every connection and replay */
+static int32 NumNetWrites[3] = { 0, 0, 0 };
+static int64 TotalNetWriteBits = 0;
+static int64 MaxNetWriteBits = 0;
 
 FTakeHitInfo::FTakeHitInfo()
 	: ActualDamage(0)
@@ -62,4 +79,147 @@ void FTakeHitInfo::SetDamageEvent(const FDamageEvent& DamageEvent)
 void FTakeHitInfo::EnsureReplication()
 {
 	EnsureReplicationByte++;
-}
\ No newline at end of file
+}
+
+bool FTakeHitInfo::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	// only ever net serialized into bit writers
+	const int64 StartBits = Ar.IsSaving() ? static_cast<FBitWriter&>(Ar).GetNumBits() : 0;
+
+	uint8 EventKind = ETakeHitInfoEvent::General;
+	if (DamageEventClassID == FPointDamageEvent::ClassID)
+	{
+		EventKind = ETakeHitInfoEvent::Point;
+	}
+	else if (DamageEventClassID == FRadialDamageEvent::ClassID)
+	{
+		EventKind = ETakeHitInfoEvent::Radial;
+	}
+	Ar.SerializeBits(&EventKind, 2);
+
+	uint8 bKilledBit = bKilled;
+	Ar.SerializeBits(&bKilledBit, 1);
+	bKilled = bKilledBit;
+
+	Ar << EnsureReplicationByte;
+
+	// quarter point precision is more than damage numbers and kill logic need
+	uint32 QuantizedDamage = FMath::Max(FMath::RoundToInt(ActualDamage * 4.0f), 0);
+	Ar.SerializeIntPacked(QuantizedDamage);
+	if (Ar.IsLoading())
+	{
+		ActualDamage = QuantizedDamage / 4.0f;
+	}
+
+	// 0 is none, 1..Num is registry index + 1, past that an object reference follows
+	const int32 NumDamageTypes = UShooterDamageTypeRegistry::Num();
+	uint32 DamageTypeCode = 0;
+	if (Ar.IsSaving() && DamageTypeClass)
+	{
+		const int32 Index = UShooterDamageTypeRegistry::GetIndex(DamageTypeClass);
+		DamageTypeCode = (Index != INDEX_NONE) ? Index + 1 : NumDamageTypes + 1;
+	}
+	Ar.SerializeIntPacked(DamageTypeCode);
+	if (DamageTypeCode > (uint32)NumDamageTypes)
+	{
+		UObject* DamageTypeObject = DamageTypeClass;
+		bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), DamageTypeObject);
+		DamageTypeClass = Cast<UClass>(DamageTypeObject);
+	}
+	else if (Ar.IsLoading())
+	{
+		DamageTypeClass = DamageTypeCode > 0 ? UShooterDamageTypeRegistry::GetDamageType(DamageTypeCode - 1) : NULL;
+	}
+
+	UObject* InstigatorObject = PawnInstigator.Get();
+	bOutSuccess &= Map->SerializeObject(Ar, AShooterCharacter::StaticClass(), InstigatorObject);
+	UObject* CauserObject = DamageCauser.Get();
+	bOutSuccess &= Map->SerializeObject(Ar, AActor::StaticClass(), CauserObject);
+	if (Ar.IsLoading())
+	{
+		PawnInstigator = Cast<AShooterCharacter>(InstigatorObject);
+		DamageCauser = Cast<AActor>(CauserObject);
+	}
+
+	// clients only need the impulse direction out of the event, for momentum and hit indicators
+	switch (EventKind)
+	{
+	case ETakeHitInfoEvent::Point:
+		PointDamageEvent.ShotDirection.NetSerialize(Ar, Map, bOutSuccess);
+		if (Ar.IsLoading())
+		{
+			DamageEventClassID = FPointDamageEvent::ClassID;
+			PointDamageEvent.Damage = ActualDamage;
+			PointDamageEvent.HitInfo = FHitResult();
+			PointDamageEvent.DamageTypeClass = DamageTypeClass;
+		}
+		break;
+
+	case ETakeHitInfoEvent::Radial:
+		{
+			FVector_NetQuantize Origin = RadialDamageEvent.Origin;
+			FVector_NetQuantizeNormal HitDirection = FVector::ZeroVector;
+			if (Ar.IsSaving() && RadialDamageEvent.ComponentHits.Num() > 0)
+			{
+				HitDirection = (RadialDamageEvent.ComponentHits[0].ImpactPoint - RadialDamageEvent.Origin).GetSafeNormal();
+			}
+			Origin.NetSerialize(Ar, Map, bOutSuccess);
+			HitDirection.NetSerialize(Ar, Map, bOutSuccess);
+
+			if (Ar.IsLoading())
+			{
+				DamageEventClassID = FRadialDamageEvent::ClassID;
+				RadialDamageEvent.Params = FRadialDamageParams(ActualDamage, 0.0f);
+				RadialDamageEvent.Origin = Origin;
+				RadialDamageEvent.DamageTypeClass = DamageTypeClass;
+
+				// one hit in the same direction from origin, GetBestHitInfo reads ComponentHits[0] and derives impulse from it
+				// hit at origin has no direction, push upwards then
+				const FVector Direction = HitDirection.IsNearlyZero() ? FVector::UpVector : FVector(HitDirection);
+				RadialDamageEvent.ComponentHits.Reset();
+				FHitResult& Hit = RadialDamageEvent.ComponentHits.AddDefaulted_GetRef();
+				Hit.ImpactPoint = Origin + Direction;
+				Hit.Location = Hit.ImpactPoint;
+				Hit.ImpactNormal = -Direction;
+				Hit.Normal = Hit.ImpactNormal;
+			}
+		}
+		break;
+
+	default:
+		if (Ar.IsLoading())
+		{
+			DamageEventClassID = FDamageEvent::ClassID;
+			GeneralDamageEvent.DamageTypeClass = DamageTypeClass;
+		}
+		break;
+	}
+
+	if (Ar.IsSaving())
+	{
+		const int64 NumBits = static_cast<FBitWriter&>(Ar).GetNumBits() - StartBits;
+		NumNetWrites[EventKind]++;
+		TotalNetWriteBits += NumBits;
+		MaxNetWriteBits = FMath::Max(MaxNetWriteBits, NumBits);
+	}
+
+	return true;
+}
+
+void FTakeHitInfo::DumpNetStats()
+{
+	const int32 NumWrites = NumNetWrites[ETakeHitInfoEvent::General] + NumNetWrites[ETakeHitInfoEvent::Point] + NumNetWrites[ETakeHitInfoEvent::Radial];
+
+	UE_LOG(LogShooter, Log, TEXT("LastTakeHitInfo: %d updates written (%d general, %d point, %d radial), %.2f bytes avg, %.2f bytes max, %d damage types registered"),
+		NumWrites, NumNetWrites[ETakeHitInfoEvent::General], NumNetWrites[ETakeHitInfoEvent::Point], NumNetWrites[ETakeHitInfoEvent::Radial],
+		NumWrites > 0 ? TotalNetWriteBits / (8.0 * NumWrites) : 0.0, MaxNetWriteBits / 8.0, UShooterDamageTypeRegistry::Num());
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterHitInfoStatsCmd(TEXT("ShooterHitInfo.Stats"), TEXT("[both] Prints number and size of LastTakeHitInfo updates written, including replay recording."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		FTakeHitInfo::DumpNetStats();
+	})
+);
@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerBotSoak.h"
+#include "ShooterGame.h"
+#include "Bots/ShooterAIController.h"
+#include "Bots/ShooterAIScheduler.h"
+#include "Player/ShooterCharacterMovement.h"
+#include "Player/ShooterPawnPool.h"
+#include "Online/ShooterGameMode.h"
+#include "Online/ShooterTickRateController.h"
+#include "Misc/FileHelper.h"
+
+void FShooterSoakPhysicsMarker::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	LastTime = FPlatformTime::Seconds();
+}
+
+FString FShooterSoakPhysicsMarker::DiagnosticMessage()
+{
+	return TEXT("FShooterSoakPhysicsMarker");
+}
+
+void UShooterTestControllerBotSoak::OnInit()
+{
+	Super::OnInit();
+
+	NumBots = 32;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakBots="), NumBots);
+
+	float SoakMinutes = 5.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakMinutes="), SoakMinutes);
+	SoakTime = SoakMinutes * 60.0f;
+
+	MaxFrameMs = 33.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakMaxFrameMs="), MaxFrameMs);
+
+	MaxMemoryMB = 4096.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakMaxMemoryMB="), MaxMemoryMB);
+
+	MaxTickRateChanges = 4.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakMaxTickRateChanges="), MaxTickRateChanges);
+
+	CSVFilename = FPaths::ProjectSavedDir() / TEXT("Profiling/BotSoak.csv");
+	FParse::Value(FCommandLine::Get(), TEXT("SoakCSV="), CSVFilename);
+
+	// compare respawn cost and garbage collections with and without pawn pool
+	if (FParse::Param(FCommandLine::Get(), TEXT("SoakPawnPool")))
+	{
+		IConsoleVariable* PawnPoolCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ShooterPawnPool.Enable"));
+		if (PawnPoolCVar)
+		{
+			PawnPoolCVar->Set(1);
+		}
+	}
+
+	// per hit bytes of LastTakeHitInfo, replay is the only connection of a bot match
+	bRecordReplay = FParse::Param(FCommandLine::Get(), TEXT("SoakReplay"));
+	bReplayStarted = false;
+
+	ElapsedSoakTime = 0.0f;
+	NumSpawnedBots = 0;
+	PeakMemoryMB = 0.0f;
+	bSampling = false;
+	bFinished = false;
+
+	StartPhysicsMarker.TickGroup = TG_StartPhysics;
+	StartPhysicsMarker.bCanEverTick = true;
+	StartPhysicsMarker.bTickEvenWhenPaused = true;
+	EndPhysicsMarker.TickGroup = TG_EndPhysics;
+	EndPhysicsMarker.bCanEverTick = true;
+	EndPhysicsMarker.bTickEvenWhenPaused = true;
+
+	OnWorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UShooterTestControllerBotSoak::OnWorldTickStart);
+	OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UShooterTestControllerBotSoak::OnWorldPostActorTick);
+
+	UE_LOG(LogGauntlet, Display, TEXT("Bot soak: %d bots for %.1f minutes, max frame %.1f ms, max memory %.0f MB"), NumBots, SoakMinutes, MaxFrameMs, MaxMemoryMB);
+}
+
+void UShooterTestControllerBotSoak::BeginDestroy()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(OnWorldTickStartHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+
+	UWorld* World = MarkerWorld.Get();
+	if (World)
+	{
+		World->OnPostTickFlush().Remove(OnPostTickFlushHandle);
+	}
+
+	StartPhysicsMarker.UnRegisterTickFunction();
+	EndPhysicsMarker.UnRegisterTickFunction();
+
+	Super::BeginDestroy();
+}
+
+void UShooterTestControllerBotSoak::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	UWorld* World = GetWorld();
+	AShooterGameMode* GameMode = World ? World->GetAuthGameMode<AShooterGameMode>() : NULL;
+	if (GameMode == NULL || bFinished)
+	{
+		return;
+	}
+
+	BindWorld(World);
+	UpdateBots(World);
+
+	bSampling = GameMode->IsMatchInProgress();
+	if (bSampling)
+	{
+		if (bRecordReplay && !bReplayStarted)
+		{
+			bReplayStarted = true;
+			World->GetGameInstance()->StartRecordingReplay(TEXT("BotSoak"), TEXT("BotSoak"));
+		}
+
+		ElapsedSoakTime += TimeDelta;
+		if (ElapsedSoakTime >= SoakTime)
+		{
+			FinishSoak();
+		}
+	}
+}
+
+void UShooterTestControllerBotSoak::BindWorld(UWorld* World)
+{
+	if (MarkerWorld == World)
+	{
+		return;
+	}
+
+	UWorld* OldWorld = MarkerWorld.Get();
+	if (OldWorld)
+	{
+		OldWorld->OnPostTickFlush().Remove(OnPostTickFlushHandle);
+	}
+
+	StartPhysicsMarker.UnRegisterTickFunction();
+	EndPhysicsMarker.UnRegisterTickFunction();
+	StartPhysicsMarker.RegisterTickFunction(World->PersistentLevel);
+	EndPhysicsMarker.RegisterTickFunction(World->PersistentLevel);
+
+	OnPostTickFlushHandle = World->OnPostTickFlush().AddUObject(this, &UShooterTestControllerBotSoak::OnPostTickFlush);
+	MarkerWorld = World;
+}
+
+void UShooterTestControllerBotSoak::UpdateBots(UWorld* World)
+{
+	AShooterGameMode* GameMode = World->GetAuthGameMode<AShooterGameMode>();
+
+	TArray<AShooterAIController*> Bots;
+	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+	{
+		AShooterAIController* AIC = Cast<AShooterAIController>(*It);
+		if (AIC)
+		{
+			Bots.Add(AIC);
+		}
+	}
+
+	if (Bots.Num() < NumBots)
+	{
+		GameMode->SetAllowBots(true, NumBots);
+		GameMode->CreateBotControllers();
+
+		// bots created after match start missed StartBots, dead ones respawn on their own
+		if (GameMode->IsMatchInProgress())
+		{
+			for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+			{
+				AShooterAIController* AIC = Cast<AShooterAIController>(*It);
+				if (AIC && !Bots.Contains(AIC) && AIC->GetPawn() == NULL)
+				{
+					GameMode->RestartPlayer(AIC);
+				}
+			}
+		}
+	}
+
+	NumSpawnedBots = 0;
+	for (AShooterAIController* AIC : Bots)
+	{
+		NumSpawnedBots += AIC->GetPawn() ? 1 : 0;
+	}
+}
+
+void UShooterTestControllerBotSoak::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	UShooterAIScheduler* Scheduler = World->GetSubsystem<UShooterAIScheduler>();
+	const double TreeTime = Scheduler ? Scheduler->GetTotalTreeTime() : 0.0;
+	// not measured in shipping, movement column stays at 0 there
+	const double MovementTime = UShooterCharacterMovement::TotalTickTime;
+
+	// GGameThreadTime is still from the frame that just ended
+	if (bSampling && !IsPendingKill())
+	{
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+		FShooterSoakFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.Time = ElapsedSoakTime;
+		Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+		Frame.AIMs = FMath::Max(0.0, TreeTime - FrameStartTreeTime) * 1000.0f;
+		Frame.MovementMs = (MovementTime - FrameStartMovementTime) * 1000.0f;
+		Frame.ReplicationMs = ReplicationTime * 1000.0f;
+		Frame.PhysicsMs = FMath::Max(0.0, EndPhysicsMarker.LastTime - StartPhysicsMarker.LastTime) * 1000.0f;
+		Frame.UsedMemoryMB = MemoryStats.UsedPhysical / (1024.0f * 1024.0f);
+		Frame.NumBots = NumSpawnedBots;
+
+		const UShooterTickRateController* TickRateController = World->GetSubsystem<UShooterTickRateController>();
+		Frame.TickRate = TickRateController ? TickRateController->GetTickRate() : 0;
+
+		PeakMemoryMB = FMath::Max(PeakMemoryMB, Frame.UsedMemoryMB);
+	}
+
+	FrameStartTreeTime = TreeTime;
+	FrameStartMovementTime = MovementTime;
+	PostActorTickTime = 0.0;
+	ReplicationTime = 0.0;
+}
+
+void UShooterTestControllerBotSoak::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		PostActorTickTime = FPlatformTime::Seconds();
+	}
+}
+
+void UShooterTestControllerBotSoak::OnPostTickFlush()
+{
+	if (PostActorTickTime > 0.0)
+	{
+		ReplicationTime = FPlatformTime::Seconds() - PostActorTickTime;
+	}
+}
+
+void UShooterTestControllerBotSoak::FinishSoak()
+{
+	bSampling = false;
+	bFinished = true;
+
+	if (Frames.Num() == 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Bot soak recorded no frames."));
+		EndTest(-1);
+		return;
+	}
+
+	FString CSV = TEXT("Frame,Time,GameThreadMs,AIMs,MovementMs,ReplicationMs,PhysicsMs,UsedMemoryMB,NumBots,TickRate\n");
+	float TotalGameThreadMs = 0.0f, TotalAIMs = 0.0f, TotalMovementMs = 0.0f, TotalReplicationMs = 0.0f, TotalPhysicsMs = 0.0f;
+	TArray<float> SortedGameThreadMs;
+	SortedGameThreadMs.Reserve(Frames.Num());
+
+	for (int32 Idx = 0; Idx < Frames.Num(); Idx++)
+	{
+		const FShooterSoakFrame& Frame = Frames[Idx];
+		CSV += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%d,%d\n"), Idx, Frame.Time, Frame.GameThreadMs, Frame.AIMs,
+			Frame.MovementMs, Frame.ReplicationMs, Frame.PhysicsMs, Frame.UsedMemoryMB, Frame.NumBots, Frame.TickRate);
+
+		TotalGameThreadMs += Frame.GameThreadMs;
+		TotalAIMs += Frame.AIMs;
+		TotalMovementMs += Frame.MovementMs;
+		TotalReplicationMs += Frame.ReplicationMs;
+		TotalPhysicsMs += Frame.PhysicsMs;
+		SortedGameThreadMs.Add(Frame.GameThreadMs);
+	}
+
+	if (FFileHelper::SaveStringToFile(CSV, *CSVFilename))
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Bot soak: wrote %d frames to %s"), Frames.Num(), *CSVFilename);
+	}
+	else
+	{
+		UE_LOG(LogGauntlet, Warning, TEXT("Bot soak: can't write %s"), *CSVFilename);
+	}
+
+	SortedGameThreadMs.Sort();
+	const float P95GameThreadMs = SortedGameThreadMs[FMath::Min(FMath::FloorToInt(SortedGameThreadMs.Num() * 0.95f), SortedGameThreadMs.Num() - 1)];
+	const float InvNumFrames = 1.0f / Frames.Num();
+
+	UE_LOG(LogGauntlet, Display, TEXT("Bot soak: %d frames, game thread avg %.2f ms p95 %.2f ms, AI %.2f ms, movement %.2f ms, replication %.2f ms, physics %.2f ms, peak memory %.0f MB"),
+		Frames.Num(), TotalGameThreadMs * InvNumFrames, P95GameThreadMs, TotalAIMs * InvNumFrames, TotalMovementMs * InvNumFrames,
+		TotalReplicationMs * InvNumFrames, TotalPhysicsMs * InvNumFrames, PeakMemoryMB);
+
+	const UShooterPawnPool* PawnPool = GetWorld() ? GetWorld()->GetSubsystem<UShooterPawnPool>() : NULL;
+	if (PawnPool)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Bot soak: pawn pool %s, %d respawns (%d reused) %.3f ms avg, %d garbage collections (%.2f per minute)"),
+			UShooterPawnPool::IsEnabled(GetWorld()) ? TEXT("enabled") : TEXT("disabled"), PawnPool->GetNumRespawns(), PawnPool->GetNumReused(),
+			PawnPool->GetNumRespawns() > 0 ? 1000.0 * PawnPool->GetTotalRespawnTime() / PawnPool->GetNumRespawns() : 0.0,
+			PawnPool->GetNumGarbageCollections(), PawnPool->GetNumGarbageCollections() * 60.0f / FMath::Max(ElapsedSoakTime, 1.0f));
+	}
+
+	// tick rate changes are counted from the recorded frames, so warmup doesn't count
+	int32 NumTickRateChanges = 0;
+	int32 MinTickRate = Frames[0].TickRate;
+	int32 MaxTickRate = Frames[0].TickRate;
+	for (int32 Idx = 1; Idx < Frames.Num(); Idx++)
+	{
+		NumTickRateChanges += (Frames[Idx].TickRate != Frames[Idx - 1].TickRate) ? 1 : 0;
+		MinTickRate = FMath::Min(MinTickRate, Frames[Idx].TickRate);
+		MaxTickRate = FMath::Max(MaxTickRate, Frames[Idx].TickRate);
+	}
+	const float TickRateChangesPerMinute = NumTickRateChanges * 60.0f / FMath::Max(ElapsedSoakTime, 1.0f);
+
+	if (MaxTickRate > 0)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Bot soak: tick rate %d-%d Hz, ended at %d Hz, %d changes (%.2f per minute)"),
+			MinTickRate, MaxTickRate, Frames.Last().TickRate, NumTickRateChanges, TickRateChangesPerMinute);
+	}
+
+	if (bReplayStarted)
+	{
+		GetWorld()->GetGameInstance()->StopRecordingReplay();
+		FTakeHitInfo::DumpNetStats();
+	}
+
+	bool bPassed = true;
+	if (TickRateChangesPerMinute > MaxTickRateChanges)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Tick rate changed %.2f times per minute, more than %.2f."), TickRateChangesPerMinute, MaxTickRateChanges);
+		bPassed = false;
+	}
+
+	if (P95GameThreadMs > MaxFrameMs)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  95th percentile game thread time %.2f ms is above %.2f ms."), P95GameThreadMs, MaxFrameMs);
+		bPassed = false;
+	}
+
+	if (PeakMemoryMB > MaxMemoryMB)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Peak memory %.0f MB is above %.0f MB."), PeakMemoryMB, MaxMemoryMB);
+		bPassed = false;
+	}
+
+	EndTest(bPassed ? 0 : -1);
+}
@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "ShooterTestControllerDecalStress.h"
+#include "ShooterGame.h"
+#include "ShooterGameUserSettings.h"
+#include "Effects/ShooterDecalManager.h"
+
+void UShooterTestControllerDecalStress::OnInit()
+{
+	Super::OnInit();
+
+	bIsFiring        = false;
+	FiringTime       = 0.0f;
+	SampleTime       = 0.0f;
+	SampleFrameTime  = 0.0f;
+	SampleFrames     = 0;
+	MaxVisibleDecals = 0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("DecalStressDuration="), StressDuration))
+	{
+		StressDuration = 60.0f;
+	}
+}
+
+void UShooterTestControllerDecalStress::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+void UShooterTestControllerDecalStress::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!IsInGame())
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	AShooterPlayerController* PC = LocalPlayer ? Cast<AShooterPlayerController>(LocalPlayer->PlayerController) : NULL;
+	AShooterCharacter* MyPawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+	if (MyPawn == NULL)
+	{
+		if (!bIsFiring && GetTimeInCurrentState() > 120.0f)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No pawn to fire with after %.0f seconds."), GetTimeInCurrentState());
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (!bIsFiring)
+	{
+		StartFiring(PC);
+		return;
+	}
+
+	// keep the trigger held, weapon may have been swapped or pawn respawned
+	MyPawn->StartWeaponFire();
+
+	FiringTime += TimeDelta;
+	SampleTime += TimeDelta;
+	SampleFrameTime += TimeDelta;
+	SampleFrames++;
+
+	if (SampleTime >= 1.0f)
+	{
+		ReportSample();
+	}
+
+	if (FiringTime >= StressDuration)
+	{
+		MyPawn->StopWeaponFire();
+
+		const UShooterGameUserSettings* UserSettings = CastChecked<UShooterGameUserSettings>(GEngine->GetGameUserSettings());
+		const UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>();
+		const int32 NumComponents = DecalManager ? DecalManager->GetNumDecalComponents() : 0;
+
+		// impact and explosion decals use separate materials, each with its own budget
+		if (MaxVisibleDecals > UserSettings->GetDecalBudget() * 2 || NumComponents > UserSettings->GetDecalBudget() * 2)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Decals over budget: %d visible max, %d components, budget %d per material."), MaxVisibleDecals, NumComponents, UserSettings->GetDecalBudget());
+			EndTest(-1);
+		}
+		else
+		{
+			UE_LOG(LogGauntlet, Display, TEXT("Decal stress passed: %d visible max, %d components, budget %d per material."), MaxVisibleDecals, NumComponents, UserSettings->GetDecalBudget());
+			EndTest(0);
+		}
+	}
+}
+
+void UShooterTestControllerDecalStress::StartFiring(AShooterPlayerController* PC)
+{
+	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(PC->GetPawn());
+	const FVector EyeLocation = MyPawn->GetPawnViewLocation();
+
+	// look for the closest wall around the player
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(DecalStressTrace), true, MyPawn);
+	FRotator BestRotation = PC->GetControlRotation();
+	float BestDistance = MAX_FLT;
+	for (int32 Idx = 0; Idx < 16; Idx++)
+	{
+		const FRotator TestRotation(-5.0f, Idx * 22.5f, 0.0f);
+		FHitResult Hit;
+		if (GetWorld()->LineTraceSingleByChannel(Hit, EyeLocation, EyeLocation + TestRotation.Vector() * 5000.0f, COLLISION_WEAPON, TraceParams) &&
+			Hit.Distance < BestDistance && Cast<APawn>(Hit.GetActor()) == NULL)
+		{
+			BestDistance = Hit.Distance;
+			BestRotation = TestRotation;
+		}
+	}
+
+	PC->SetControlRotation(BestRotation);
+	PC->SetGodMode(true);
+	PC->SetInfiniteAmmo(true);
+	PC->SetInfiniteClip(true);
+	PC->SetIgnoreLookInput(true);
+	MyPawn->StartWeaponFire();
+
+	UE_LOG(LogGauntlet, Display, TEXT("Decal stress: firing at wall %.0f units away for %.0f seconds."), BestDistance, StressDuration);
+	bIsFiring = true;
+}
+
+void UShooterTestControllerDecalStress::ReportSample()
+{
+	const UShooterDecalManager* DecalManager = GetWorld()->GetSubsystem<UShooterDecalManager>();
+	const int32 NumVisible = DecalManager ? DecalManager->GetNumVisibleDecals() : 0;
+	const int32 NumComponents = DecalManager ? DecalManager->GetNumDecalComponents() : 0;
+	MaxVisibleDecals = FMath::Max(MaxVisibleDecals, NumVisible);
+
+	UE_LOG(LogGauntlet, Display, TEXT("Decal stress: %.0fs, %d visible decals, %d components, %d merged, avg frame %.2f ms"),
+		FiringTime, NumVisible, NumComponents, DecalManager ? DecalManager->GetNumMergedDecals() : 0,
+		SampleFrames > 0 ? 1000.0f * SampleFrameTime / SampleFrames : 0.0f);
+
+	SampleTime = 0.0f;
+	SampleFrameTime = 0.0f;
+	SampleFrames = 0;
+}
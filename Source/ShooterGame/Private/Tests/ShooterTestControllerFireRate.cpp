@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerFireRate.h"
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeapon.h"
+#include "Online/ShooterPlayerState.h"
+
+static const float FireRateTestTickRates[] = { 20.0f, 60.0f, 240.0f };
+
+void UShooterTestControllerFireRate::OnInit()
+{
+	Super::OnInit();
+
+	RateIdx = 0;
+	NumFiringFrames = INDEX_NONE;
+	IdleTime = 0.0f;
+	StartShots = 0;
+	bPassed = true;
+}
+
+void UShooterTestControllerFireRate::BeginDestroy()
+{
+	FApp::SetUseFixedTimeStep(false);
+
+	Super::BeginDestroy();
+}
+
+void UShooterTestControllerFireRate::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+int32 UShooterTestControllerFireRate::GetNumShotsFired(const AShooterPlayerController* PC) const
+{
+	const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(PC->PlayerState);
+	return PlayerState ? PlayerState->GetNumBulletsFired() + PlayerState->GetNumRocketsFired() : 0;
+}
+
+void UShooterTestControllerFireRate::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!IsInGame())
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	AShooterPlayerController* PC = LocalPlayer ? Cast<AShooterPlayerController>(LocalPlayer->PlayerController) : NULL;
+	AShooterCharacter* MyPawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+	AShooterWeapon* Weapon = MyPawn ? MyPawn->GetWeapon() : NULL;
+	if (Weapon == NULL)
+	{
+		if (GetTimeInCurrentState() > 120.0f)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No weapon to fire after %.0f seconds."), GetTimeInCurrentState());
+			FApp::SetUseFixedTimeStep(false);
+			EndTest(-1);
+		}
+		return;
+	}
+
+	// half an interval past the last shot, so a frame early or late can't change the count
+	const float TimeBetweenShots = Weapon->GetWeaponConfig().TimeBetweenShots;
+	const float Duration = 10.5f * TimeBetweenShots;
+
+	if (NumFiringFrames == INDEX_NONE)
+	{
+		// refire delay of previous burst has to run out first
+		IdleTime += TimeDelta;
+		if (IdleTime < FMath::Max(2.0f * TimeBetweenShots, 0.5f))
+		{
+			return;
+		}
+
+		if (RateIdx >= UE_ARRAY_COUNT(FireRateTestTickRates))
+		{
+			EndTest(bPassed ? 0 : -1);
+			return;
+		}
+
+		// engine runs frames back to back with this delta, weapon sees the same time steps as at the real rate
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(1.0 / FireRateTestTickRates[RateIdx]);
+
+		PC->SetGodMode(true);
+		PC->SetInfiniteAmmo(true);
+		PC->SetInfiniteClip(true);
+		StartShots = GetNumShotsFired(PC);
+		MyPawn->StartWeaponFire();
+		NumFiringFrames = 0;
+		return;
+	}
+
+	NumFiringFrames++;
+	if (NumFiringFrames * FApp::GetFixedDeltaTime() < Duration)
+	{
+		return;
+	}
+
+	const int32 NumShots = GetNumShotsFired(PC) - StartShots;
+	const int32 ExpectedShots = FMath::FloorToInt(Duration / TimeBetweenShots) + 1;
+	MyPawn->StopWeaponFire();
+	FApp::SetUseFixedTimeStep(false);
+
+	if (NumShots != ExpectedShots)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s at %.0f Hz fired %d shots in %.3f s, expected %d."), *Weapon->GetName(), FireRateTestTickRates[RateIdx], NumShots, Duration, ExpectedShots);
+		bPassed = false;
+	}
+	else
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("%s at %.0f Hz fired %d shots in %.3f s."), *Weapon->GetName(), FireRateTestTickRates[RateIdx], NumShots, Duration);
+	}
+
+	RateIdx++;
+	NumFiringFrames = INDEX_NONE;
+	IdleTime = 0.0f;
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerRadialDamage.h"
+#include "ShooterGame.h"
+#include "Weapons/ShooterDamageGrid.h"
+
+void UShooterTestControllerRadialDamage::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+void UShooterTestControllerRadialDamage::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!IsInGame())
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	AShooterPlayerController* PC = LocalPlayer ? Cast<AShooterPlayerController>(LocalPlayer->PlayerController) : NULL;
+	AShooterCharacter* MyPawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+	if (MyPawn == NULL || MyPawn->GetLocalRole() != ROLE_Authority)
+	{
+		if (GetTimeInCurrentState() > 120.0f)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No authoritative pawn to damage after %.0f seconds."), GetTimeInCurrentState());
+			EndTest(-1);
+		}
+		return;
+	}
+
+	IConsoleVariable* DamageGridCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ShooterDamageGrid.Enable"));
+	if (DamageGridCVar)
+	{
+		DamageGridCVar->Set(1);
+	}
+	PC->SetGodMode(false);
+
+	// just above the head, visibility trace to the pawn hits its mesh rather than its capsule
+	const float Radius = 300.0f;
+	const float HalfHeight = MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float InsideDamage = ExplodeAt(MyPawn, FVector(0.0f, 0.0f, HalfHeight + 30.0f), Radius);
+	const float OutsideDamage = ExplodeAt(MyPawn, FVector(0.0f, 0.0f, HalfHeight + Radius * 2.0f), Radius);
+
+	bool bPassed = true;
+	if (InsideDamage <= 0.0f)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Character inside explosion radius took no damage."));
+		bPassed = false;
+	}
+
+	if (OutsideDamage > 0.0f)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Character outside explosion radius took %.1f damage."), OutsideDamage);
+		bPassed = false;
+	}
+
+	if (bPassed)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Radial damage passed: %.1f damage inside radius, none outside."), InsideDamage);
+	}
+
+	EndTest(bPassed ? 0 : -1);
+}
+
+float UShooterTestControllerRadialDamage::ExplodeAt(AShooterCharacter* Pawn, const FVector& Offset, float Radius) const
+{
+	// keep the pawn alive whatever the damage, only the change matters
+	Pawn->Health = Pawn->GetMaxHealth();
+
+	UShooterDamageGrid* DamageGrid = GetWorld()->GetSubsystem<UShooterDamageGrid>();
+	if (DamageGrid)
+	{
+		DamageGrid->ApplyRadialDamage(10.0f, Pawn->GetActorLocation() + Offset, Radius, UDamageType::StaticClass(), NULL, NULL);
+	}
+
+	return Pawn->GetMaxHealth() - Pawn->Health;
+}
@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "Tests/ShooterTestControllerTakeHitInfo.h"
+#include "ShooterGame.h"
+#include "Weapons/ShooterDamageTypeRegistry.h"
+
+bool UShooterTestPackageMap::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	if (Objects.Num() == 0)
+	{
+		Objects.Add(NULL);
+	}
+
+	uint32 Index = 0;
+	if (Ar.IsSaving())
+	{
+		Index = Objects.AddUnique(Obj);
+	}
+	Ar.SerializeIntPacked(Index);
+	if (Ar.IsLoading())
+	{
+		Obj = Objects.IsValidIndex(Index) ? Objects[Index] : NULL;
+	}
+
+	return Obj == NULL || Obj->IsA(InClass);
+}
+
+void UShooterTestControllerTakeHitInfo::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+void UShooterTestControllerTakeHitInfo::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!IsInGame())
+	{
+		return;
+	}
+
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	AShooterPlayerController* PC = LocalPlayer ? Cast<AShooterPlayerController>(LocalPlayer->PlayerController) : NULL;
+	AShooterCharacter* MyPawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+	if (MyPawn == NULL || MyPawn->GetWeapon() == NULL)
+	{
+		if (GetTimeInCurrentState() > 120.0f)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No armed pawn to build hit info for after %.0f seconds."), GetTimeInCurrentState());
+			EndTest(-1);
+		}
+		return;
+	}
+
+	// registered damage types go as index, anything else as object reference
+	UClass* RegisteredDamageType = UShooterDamageTypeRegistry::Num() > 0 ? UShooterDamageTypeRegistry::GetDamageType(0) : NULL;
+	UClass* OtherDamageType = UDamageType::StaticClass();
+	if (UShooterDamageTypeRegistry::GetIndex(OtherDamageType) != INDEX_NONE)
+	{
+		OtherDamageType = NULL;
+	}
+
+	bool bPassed = true;
+
+	{
+		FPointDamageEvent PointDamage;
+		PointDamage.DamageTypeClass = RegisteredDamageType ? RegisteredDamageType : OtherDamageType;
+		PointDamage.ShotDirection = FVector(1.0f, 2.0f, -0.5f).GetSafeNormal();
+
+		FTakeHitInfo Sent;
+		Sent.ActualDamage = 12.25f;
+		Sent.PawnInstigator = MyPawn;
+		Sent.DamageCauser = MyPawn->GetWeapon();
+		Sent.SetDamageEvent(PointDamage);
+		Sent.bKilled = false;
+		bPassed &= RoundTrip(TEXT("Point"), Sent, MyPawn);
+	}
+
+	{
+		FRadialDamageEvent RadialDamage;
+		RadialDamage.DamageTypeClass = OtherDamageType;
+		RadialDamage.Params = FRadialDamageParams(100.0f, 300.0f);
+		RadialDamage.Origin = MyPawn->GetActorLocation().GridSnap(1.0f) + FVector(-120.0f, 40.0f, 0.0f);
+		FHitResult& Hit = RadialDamage.ComponentHits.AddDefaulted_GetRef();
+		Hit.ImpactPoint = MyPawn->GetActorLocation();
+		Hit.Location = Hit.ImpactPoint;
+
+		FTakeHitInfo Sent;
+		Sent.ActualDamage = 87.5f;
+		Sent.PawnInstigator = MyPawn;
+		Sent.DamageCauser = MyPawn;
+		Sent.SetDamageEvent(RadialDamage);
+		Sent.bKilled = true;
+		bPassed &= RoundTrip(TEXT("Radial"), Sent, MyPawn);
+	}
+
+	{
+		FTakeHitInfo Sent;
+		Sent.ActualDamage = 3.0f;
+		Sent.SetDamageEvent(FDamageEvent(RegisteredDamageType));
+		Sent.bKilled = true;
+		bPassed &= RoundTrip(TEXT("General"), Sent, MyPawn);
+	}
+
+	if (bPassed)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("TakeHitInfo round trip passed for point, radial and general damage."));
+	}
+
+	EndTest(bPassed ? 0 : -1);
+}
+
+bool UShooterTestControllerTakeHitInfo::RoundTrip(const TCHAR* Name, FTakeHitInfo& Sent, AActor* HitActor) const
+{
+	UShooterTestPackageMap* PackageMap = NewObject<UShooterTestPackageMap>();
+
+	bool bWriteSuccess = false;
+	FNetBitWriter Writer(PackageMap, 0);
+	Sent.NetSerialize(Writer, PackageMap, bWriteSuccess);
+
+	bool bReadSuccess = false;
+	FTakeHitInfo Received;
+	FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+	Received.NetSerialize(Reader, PackageMap, bReadSuccess);
+
+	bool bPassed = true;
+	if (!bWriteSuccess || !bReadSuccess || Reader.IsError())
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: serialization reported an error."), Name);
+		bPassed = false;
+	}
+
+	if (!FMath::IsNearlyEqual(Received.ActualDamage, Sent.ActualDamage, 0.25f))
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: ActualDamage %.2f, expected %.2f."), Name, Received.ActualDamage, Sent.ActualDamage);
+		bPassed = false;
+	}
+
+	if (Received.bKilled != Sent.bKilled)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: bKilled %d, expected %d."), Name, (int32)Received.bKilled, (int32)Sent.bKilled);
+		bPassed = false;
+	}
+
+	if (Received.PawnInstigator != Sent.PawnInstigator)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: PawnInstigator %s, expected %s."), Name, *GetNameSafe(Received.PawnInstigator.Get()), *GetNameSafe(Sent.PawnInstigator.Get()));
+		bPassed = false;
+	}
+
+	if (Received.DamageCauser != Sent.DamageCauser)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: DamageCauser %s, expected %s."), Name, *GetNameSafe(Received.DamageCauser.Get()), *GetNameSafe(Sent.DamageCauser.Get()));
+		bPassed = false;
+	}
+
+	const FDamageEvent& SentEvent = Sent.GetDamageEvent();
+	const FDamageEvent& ReceivedEvent = Received.GetDamageEvent();
+	if (ReceivedEvent.GetTypeID() != SentEvent.GetTypeID())
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: damage event type %d, expected %d."), Name, ReceivedEvent.GetTypeID(), SentEvent.GetTypeID());
+		bPassed = false;
+	}
+
+	if (Received.DamageTypeClass != Sent.DamageTypeClass || ReceivedEvent.DamageTypeClass != SentEvent.DamageTypeClass)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: damage type %s, expected %s."), Name, *GetNameSafe(ReceivedEvent.DamageTypeClass), *GetNameSafe(SentEvent.DamageTypeClass));
+		bPassed = false;
+	}
+
+	// hit reactions and momentum only use the impulse direction out of the event
+	FHitResult SentHit, ReceivedHit;
+	FVector SentImpulseDir, ReceivedImpulseDir;
+	SentEvent.GetBestHitInfo(HitActor, Sent.PawnInstigator.Get(), SentHit, SentImpulseDir);
+	ReceivedEvent.GetBestHitInfo(HitActor, Received.PawnInstigator.Get(), ReceivedHit, ReceivedImpulseDir);
+	if (!ReceivedImpulseDir.Equals(SentImpulseDir, 0.01f))
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: impulse direction %s, expected %s."), Name, *ReceivedImpulseDir.ToString(), *SentImpulseDir.ToString());
+		bPassed = false;
+	}
+
+	if (SentEvent.IsOfType(FRadialDamageEvent::ClassID))
+	{
+		const FVector& SentOrigin = static_cast<const FRadialDamageEvent&>(SentEvent).Origin;
+		const FVector& ReceivedOrigin = static_cast<const FRadialDamageEvent&>(ReceivedEvent).Origin;
+		if (!ReceivedOrigin.Equals(SentOrigin, 1.0f))
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  %s: radial origin %s, expected %s."), Name, *ReceivedOrigin.ToString(), *SentOrigin.ToString());
+			bPassed = false;
+		}
+	}
+
+	return bPassed;
+}
@@ -463,9 +463,7 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
+						if (MyGameState->GetRankedPlayers(i).Num() > 0)
 						{
 							NumTeams++;
 						}
@@ -474,11 +472,9 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 				}
 				else // free for all
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					// INDEX_NONE when not ranked yet, shows as 0
+					const int32 MyPos = MyGameState->GetPlayerRank(MyPlayerState) + 1;
+					Text = FString::Printf(TEXT("%d/%d"), MyPos, MyGameState->GetRankedPlayers(0).Num());
 				}
 				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 				Canvas->DrawIcon(PlaceIcon,
@@ -891,40 +887,62 @@ void AShooterHUD::DrawDeathMessages()
 	}
 }
 
+static const int32 MaxDeathMessages = 5;
+
 void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType)
 {
-	const int32 MaxDeathMessages = 5;
-	const float MessageDuration = 10.0f;
-
-	if (GetWorld()->GetGameState())
+	if (GetWorld()->GetGameState() && GetWorld()->GetGameState()->GetDefaultGameMode<AShooterGameMode>())
 	{
-		const AShooterGameMode* DefGame = GetWorld()->GetGameState()->GetDefaultGameMode<AShooterGameMode>();
 		AShooterPlayerState* MyPlayerState = PlayerOwner ? Cast<AShooterPlayerState>(PlayerOwner->PlayerState) : NULL;
+		AddDeathMessage(KillerPlayerState, VictimPlayerState, KillerDamageType, MyPlayerState);
 
-		if (DefGame && KillerPlayerState && VictimPlayerState && MyPlayerState)
+		if (DeathMessages.Num() > MaxDeathMessages)
 		{
-			if (DeathMessages.Num() >= MaxDeathMessages)
-			{
-				DeathMessages.RemoveAt(0, 1, false);
-			}
+			DeathMessages.RemoveAt(0, DeathMessages.Num() - MaxDeathMessages, false);
+		}
+	}
+}
+
+void AShooterHUD::ShowDeathMessages(const TArray<const FShooterKillEvent*>& Kills)
+{
+	if (GetWorld()->GetGameState() && GetWorld()->GetGameState()->GetDefaultGameMode<AShooterGameMode>())
+	{
+		AShooterPlayerState* MyPlayerState = PlayerOwner ? Cast<AShooterPlayerState>(PlayerOwner->PlayerState) : NULL;
+		for (const FShooterKillEvent* Kill : Kills)
+		{
+			AddDeathMessage(Kill->Killer, Kill->Victim, Kill->DamageType, MyPlayerState);
+		}
 
-			FDeathMessage NewMessage;
-			NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
-			NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
-			NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
-			NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
-			NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
-			NewMessage.bVictimIsOwner = MyPlayerState == VictimPlayerState;
+		// a multikill may push out more than one message, trim once
+		if (DeathMessages.Num() > MaxDeathMessages)
+		{
+			DeathMessages.RemoveAt(0, DeathMessages.Num() - MaxDeathMessages, false);
+		}
+	}
+}
 
-			NewMessage.DamageType = MakeWeakObjectPtr(const_cast<UShooterDamageType*>(Cast<const UShooterDamageType>(KillerDamageType)));
-			NewMessage.HideTime = GetWorld()->GetTimeSeconds() + MessageDuration;
+void AShooterHUD::AddDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* MyPlayerState)
+{
+	const float MessageDuration = 10.0f;
 
-			DeathMessages.Add(NewMessage);
-			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
-			{
-				LastKillTime = GetWorld()->GetTimeSeconds();
-				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
-			}
+	if (KillerPlayerState && VictimPlayerState && MyPlayerState)
+	{
+		FDeathMessage NewMessage;
+		NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
+		NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
+		NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
+		NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
+		NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
+		NewMessage.bVictimIsOwner = MyPlayerState == VictimPlayerState;
+
+		NewMessage.DamageType = MakeWeakObjectPtr(const_cast<UShooterDamageType*>(Cast<const UShooterDamageType>(KillerDamageType)));
+		NewMessage.HideTime = GetWorld()->GetTimeSeconds() + MessageDuration;
+
+		DeathMessages.Add(NewMessage);
+		if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
+		{
+			LastKillTime = GetWorld()->GetTimeSeconds();
+			CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
 		}
 	}
 }
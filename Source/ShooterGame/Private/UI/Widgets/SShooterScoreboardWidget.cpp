@@ -27,6 +27,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
+	LastRankingRevision = 0;
 
 	UpdatePlayerStateMaps();
 	
@@ -285,6 +286,15 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 		{
 			bool bRequiresWidgetUpdate = false;
 			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
+
+			// nothing was scored, joined or switched teams since last time
+			if (GameState->GetRankingRevision() == LastRankingRevision && PlayerStateMaps.Num() == NumTeams)
+			{
+				UpdateSelectedPlayer();
+				return;
+			}
+			LastRankingRevision = GameState->GetRankingRevision();
+
 			LastTeamPlayerCount.Reset();
 			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
 			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
@@ -225,6 +225,9 @@ protected:
 	/** player count in each team in the last tick */
 	TArray<int32> LastTeamPlayerCount;
 
+	/** game state ranking revision PlayerStateMaps were built from */
+	uint32 LastRankingRevision;
+
 	/** holds talking player data */
 	TArray<TPair<TSharedRef<const FUniqueNetId>, bool>> PlayersTalkingThisFrame;
 
@@ -0,0 +1,276 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterDamageGrid.h"
+
+int32 CVar_ShooterDamageGrid_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterDamageGridEnable(TEXT("ShooterDamageGrid.Enable"), CVar_ShooterDamageGrid_Enable, TEXT("Use damage grid for explosions instead of UGameplayStatics::ApplyRadialDamage. 0: Disable, 1: Enable"), ECVF_Default );
+
+float CVar_ShooterDamageGrid_CellSize = 512.0f;
+static FAutoConsoleVariableRef CVarShooterDamageGridCellSize(TEXT("ShooterDamageGrid.CellSize"), CVar_ShooterDamageGrid_CellSize, TEXT("Size of damage grid cell in world units"), ECVF_Default );
+
+void UShooterDamageGrid::RegisterActor(AActor* Actor)
+{
+	if (Actor)
+	{
+		DamageableActors.AddUnique(Actor);
+		BuiltFrame = 0;
+	}
+}
+
+void UShooterDamageGrid::UnregisterActor(AActor* Actor)
+{
+	if (DamageableActors.RemoveSingleSwap(Actor, false) > 0)
+	{
+		BuiltFrame = 0;
+	}
+}
+
+FIntVector UShooterDamageGrid::GetCellCoords(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(CVar_ShooterDamageGrid_CellSize, 64.0f);
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UShooterDamageGrid::UpdateCells()
+{
+	if (BuiltFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	BuiltFrame = GFrameCounter;
+	for (TPair<FIntVector, FShooterDamageGridCell>& It : Cells)
+	{
+		It.Value.Actors.Reset();
+	}
+
+	for (AActor* Actor : DamageableActors)
+	{
+		if (Actor == NULL || Actor->IsPendingKill())
+		{
+			continue;
+		}
+
+		// characters move every frame, bounds of root component are enough to pick cells
+		const FBox Bounds = Actor->GetRootComponent() ? Actor->GetRootComponent()->Bounds.GetBox() : FBox(Actor->GetActorLocation(), Actor->GetActorLocation());
+		const FIntVector MinCell = GetCellCoords(Bounds.Min);
+		const FIntVector MaxCell = GetCellCoords(Bounds.Max);
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					Cells.FindOrAdd(FIntVector(X, Y, Z)).Actors.Add(Actor);
+				}
+			}
+		}
+	}
+}
+
+void UShooterDamageGrid::GatherActorsInRadius(const FVector& Origin, float Radius, TArray<AActor*>& OutActors)
+{
+	UpdateCells();
+
+	const FIntVector MinCell = GetCellCoords(Origin - FVector(Radius));
+	const FIntVector MaxCell = GetCellCoords(Origin + FVector(Radius));
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const FShooterDamageGridCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell)
+				{
+					for (AActor* Actor : Cell->Actors)
+					{
+						OutActors.AddUnique(Actor);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool UShooterDamageGrid::ApplyRadialDamage(float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, AActor* DamageCauser, AController* InstigatedBy)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	bool bAppliedDamage = false;
+
+	if (CVar_ShooterDamageGrid_Enable)
+	{
+		bAppliedDamage = ApplyRadialDamageFromGrid(BaseDamage, Origin, DamageRadius, DamageTypeClass, DamageCauser, InstigatedBy);
+	}
+	else
+	{
+		bAppliedDamage = UGameplayStatics::ApplyRadialDamage(this, BaseDamage, Origin, DamageRadius, DamageTypeClass, TArray<AActor*>(), DamageCauser, InstigatedBy);
+	}
+
+	AddDamageSample(CVar_ShooterDamageGrid_Enable != 0, FPlatformTime::Seconds() - StartTime);
+	return bAppliedDamage;
+}
+
+bool UShooterDamageGrid::ApplyRadialDamageFromGrid(float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, AActor* DamageCauser, AController* InstigatedBy)
+{
+	TArray<AActor*> Candidates;
+	GatherActorsInRadius(Origin, DamageRadius, Candidates);
+
+	FCollisionQueryParams LineParams(SCENE_QUERY_STAT(ShooterRadialDamage), true, DamageCauser);
+	const float DamageRadiusSq = FMath::Square(DamageRadius);
+
+	// resolve all hits before dealing damage, deaths may change registered actors
+	TArray<TPair<AActor*, FHitResult>, TInlineAllocator<16>> Victims;
+	for (AActor* Actor : Candidates)
+	{
+		UPrimitiveComponent* VictimComp = Actor ? Cast<UPrimitiveComponent>(Actor->GetRootComponent()) : NULL;
+		if (VictimComp == NULL || Actor == DamageCauser || Actor->IsPendingKill() || !Actor->CanBeDamaged() ||
+			VictimComp->Bounds.GetBox().ComputeSquaredDistanceToPoint(Origin) > DamageRadiusSq)
+		{
+			continue;
+		}
+
+		// single visibility check per actor, mirrors ComponentIsDamageableFrom in GameplayStatics
+		// root capsule of characters ignores visibility, so any component of the victim counts as reached
+		const FVector TraceEnd = VictimComp->Bounds.Origin;
+		FHitResult Hit;
+		++NumGridTraces;
+		if (GetWorld()->LineTraceSingleByChannel(Hit, Origin, TraceEnd, ECC_Visibility, LineParams))
+		{
+			if (Hit.GetActor() != Actor)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			// didn't hit anything, assume nothing blocking the damage and victim is consumed into the explosion
+			const FVector FakeHitNormal = (Origin - TraceEnd).GetSafeNormal();
+			Hit = FHitResult(Actor, VictimComp, TraceEnd, FakeHitNormal);
+		}
+
+		Victims.Add(TPair<AActor*, FHitResult>(Actor, Hit));
+	}
+
+	FRadialDamageEvent DmgEvent;
+	DmgEvent.DamageTypeClass = DamageTypeClass ? DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+	DmgEvent.Origin = Origin;
+	DmgEvent.Params = FRadialDamageParams(BaseDamage, 0.0f, 0.0f, DamageRadius, 1.0f);
+
+	bool bAppliedDamage = false;
+	for (const TPair<AActor*, FHitResult>& Victim : Victims)
+	{
+		if (!Victim.Key->IsPendingKill())
+		{
+			DmgEvent.ComponentHits.Reset();
+			DmgEvent.ComponentHits.Add(Victim.Value);
+
+			Victim.Key->TakeDamage(BaseDamage, DmgEvent, InstigatedBy, DamageCauser);
+			bAppliedDamage = true;
+		}
+	}
+
+	return bAppliedDamage;
+}
+
+void UShooterDamageGrid::RunBenchmark(int32 NumExplosions, float DamageRadius)
+{
+	if (DamageableActors.Num() == 0 || NumExplosions <= 0)
+	{
+		return;
+	}
+
+	// explode around tracked actors, zero damage keeps everyone alive while going through the full TakeDamage path
+	TArray<FVector> Origins;
+	for (int32 Idx = 0; Idx < NumExplosions; Idx++)
+	{
+		AActor* Target = DamageableActors[FMath::RandRange(0, DamageableActors.Num() - 1)];
+		Origins.Add((Target ? Target->GetActorLocation() : FVector::ZeroVector) + FMath::VRand() * FMath::FRandRange(0.0f, DamageRadius));
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		ApplyRadialDamageFromGrid(0.0f, Origin, DamageRadius, UDamageType::StaticClass(), NULL, NULL);
+	}
+	const double GridTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (const FVector& Origin : Origins)
+	{
+		UGameplayStatics::ApplyRadialDamage(this, 0.0f, Origin, DamageRadius, UDamageType::StaticClass(), TArray<AActor*>(), NULL, NULL);
+	}
+	const double GenericTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogShooterWeapon, Log, TEXT("Damage grid benchmark: %d explosions, radius %.0f, %d actors: grid %.3f ms, generic %.3f ms (%.2fx)"),
+		NumExplosions, DamageRadius, DamageableActors.Num(), GridTime * 1000.0, GenericTime * 1000.0, GridTime > 0.0 ? GenericTime / GridTime : 0.0);
+}
+
+void UShooterDamageGrid::AddDamageSample(bool bUsedGrid, double Seconds)
+{
+	if (bUsedGrid)
+	{
+		++NumGridExplosions;
+		TotalGridTime += Seconds;
+	}
+	else
+	{
+		++NumGenericExplosions;
+		TotalGenericTime += Seconds;
+	}
+}
+
+void UShooterDamageGrid::DumpStats() const
+{
+	UE_LOG(LogShooterWeapon, Log, TEXT("Damage grid: %d actors, %d cells"), DamageableActors.Num(), Cells.Num());
+	UE_LOG(LogShooterWeapon, Log, TEXT("Damage grid: %d explosions, avg %.3f ms, %.1f traces per explosion"),
+		NumGridExplosions, NumGridExplosions > 0 ? 1000.0 * TotalGridTime / NumGridExplosions : 0.0, NumGridExplosions > 0 ? (float)NumGridTraces / NumGridExplosions : 0.0f);
+	UE_LOG(LogShooterWeapon, Log, TEXT("Generic radial damage: %d explosions, avg %.3f ms"),
+		NumGenericExplosions, NumGenericExplosions > 0 ? 1000.0 * TotalGenericTime / NumGenericExplosions : 0.0);
+}
+
+void UShooterDamageGrid::ResetStats()
+{
+	NumGridExplosions = 0;
+	NumGenericExplosions = 0;
+	NumGridTraces = 0;
+	TotalGridTime = 0.0;
+	TotalGenericTime = 0.0;
+}
+
+void UShooterDamageGrid::Deinitialize()
+{
+	DamageableActors.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterDamageGridStatsCmd(TEXT("ShooterDamageGrid.Stats"), TEXT("Prints average cost of explosion damage with and without damage grid. Pass 'reset' to clear counters."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterDamageGrid* DamageGrid = World ? World->GetSubsystem<UShooterDamageGrid>() : NULL;
+		if (DamageGrid)
+		{
+			DamageGrid->DumpStats();
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				DamageGrid->ResetStats();
+			}
+		}
+	})
+);
+
+FAutoConsoleCommandWithWorldAndArgs ShooterDamageGridBenchmarkCmd(TEXT("ShooterDamageGrid.Benchmark"), TEXT("[server] Runs <count> zero damage explosions of <radius> around tracked actors through damage grid and UGameplayStatics and prints timings."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterDamageGrid* DamageGrid = (World && World->GetNetMode() != NM_Client) ? World->GetSubsystem<UShooterDamageGrid>() : NULL;
+		if (DamageGrid)
+		{
+			const int32 NumExplosions = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 256;
+			const float DamageRadius = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 300.0f;
+			DamageGrid->RunBenchmark(NumExplosions, DamageRadius);
+		}
+	})
+);
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterDamageTypeRegistry.h"
+
+UShooterDamageTypeRegistry::UShooterDamageTypeRegistry(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	bLoaded = false;
+}
+
+UShooterDamageTypeRegistry* UShooterDamageTypeRegistry::Get()
+{
+	UShooterDamageTypeRegistry* Registry = GetMutableDefault<UShooterDamageTypeRegistry>();
+	if (!Registry->bLoaded)
+	{
+		check(IsInGameThread());
+		Registry->bLoaded = true;
+
+		// keep failed entries so indices of the rest still match on the other side
+		for (int32 Idx = 0; Idx < Registry->DamageTypes.Num(); Idx++)
+		{
+			UClass* DamageTypeClass = Registry->DamageTypes[Idx].TryLoadClass<UDamageType>();
+			if (DamageTypeClass)
+			{
+				Registry->DamageTypeIndices.Add(DamageTypeClass, Idx);
+			}
+			else
+			{
+				UE_LOG(LogShooter, Warning, TEXT("Damage type %s in registry failed to load, it will replicate as object reference"), *Registry->DamageTypes[Idx].ToString());
+			}
+			Registry->LoadedDamageTypes.Add(DamageTypeClass);
+		}
+	}
+
+	return Registry;
+}
+
+int32 UShooterDamageTypeRegistry::GetIndex(const UClass* DamageTypeClass)
+{
+	const int32* Index = Get()->DamageTypeIndices.Find(DamageTypeClass);
+	return Index ? *Index : INDEX_NONE;
+}
+
+UClass* UShooterDamageTypeRegistry::GetDamageType(int32 Index)
+{
+	const UShooterDamageTypeRegistry* Registry = Get();
+	return Registry->LoadedDamageTypes.IsValidIndex(Index) ? Registry->LoadedDamageTypes[Index] : NULL;
+}
+
+int32 UShooterDamageTypeRegistry::Num()
+{
+	return Get()->LoadedDamageTypes.Num();
+}
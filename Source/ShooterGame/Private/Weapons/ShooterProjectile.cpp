@@ -4,6 +4,9 @@
 #include "Weapons/ShooterProjectile.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterExplosionEffect.h"
+#include "Weapons/ShooterProjectilePool.h"
+#include "Weapons/ShooterDamageGrid.h"
+#include "Bots/ShooterInfluenceMap.h"
 
 AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -32,6 +35,12 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 	MovementComp->bRotationFollowsVelocity = true;
 	MovementComp->ProjectileGravityScale = 0.f;
 
+	PoolSize = 16;
+	WeaponConfig = NULL;
+	WeaponConfigOwner = NULL;
+	PoolGeneration = 0;
+	bReturnToPool = false;
+
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
 	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
@@ -43,16 +52,98 @@ void AShooterProjectile::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 	MovementComp->OnProjectileStop.AddDynamic(this, &AShooterProjectile::OnImpact);
+	InitFromOwner();
+}
+
+void AShooterProjectile::InitFromOwner()
+{
+	CollisionComp->MoveIgnoreActors.Reset();
 	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
 
+	// defaults for projectiles placed without a weapon
+	static const FProjectileWeaponData DefaultWeaponConfig;
+
 	AShooterWeapon_Projectile* OwnerWeapon = Cast<AShooterWeapon_Projectile>(GetOwner());
-	if (OwnerWeapon)
+	WeaponConfig = OwnerWeapon ? &OwnerWeapon->GetProjectileConfig() : &DefaultWeaponConfig;
+	WeaponConfigOwner = OwnerWeapon ? OwnerWeapon->GetProjectileConfigOwner() : NULL;
+
+	SetLifeSpan( WeaponConfig->ProjectileLife );
+	MyController = GetInstigatorController();
+}
+
+void AShooterProjectile::ActivateFromPool()
+{
+	bExploded = false;
+	PoolGeneration++;
+
+	InitFromOwner();
+	ResetSimulation();
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	SetNetDormancy(DORM_Awake);
+	ForceNetUpdate();
+}
+
+void AShooterProjectile::DeactivateToPool()
+{
+	SetLifeSpan(0.0f);
+	MovementComp->StopMovementImmediately();
+	MyController.Reset();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	// let the hidden state replicate before the channel goes dormant
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AShooterProjectile::ResetSimulation()
+{
+	// movement component drops its updated component when it stops on impact
+	MovementComp->SetUpdatedComponent(CollisionComp);
+	MovementComp->SetComponentTickEnabled(true);
+
+	// trail was deactivated on impact, bAutoActivate is off so nothing else restarts it
+	if (ParticleComp)
 	{
-		OwnerWeapon->ApplyWeaponConfig(WeaponConfig);
+		ParticleComp->Activate(true);
 	}
 
-	SetLifeSpan( WeaponConfig.ProjectileLife );
-	MyController = GetInstigatorController();
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp && ProjAudioComp->bAutoActivate)
+	{
+		ProjAudioComp->Play();
+	}
+}
+
+int32 AShooterProjectile::GetPoolSize() const
+{
+	return PoolSize;
+}
+
+void AShooterProjectile::Reset()
+{
+	Super::Reset();
+
+	// pooled projectiles have no life span left
+	if (GetLifeSpan() > 0.0f)
+	{
+		LifeSpanExpired();
+	}
+}
+
+void AShooterProjectile::LifeSpanExpired()
+{
+	UShooterProjectilePool* ProjectilePool = bReturnToPool ? GetWorld()->GetSubsystem<UShooterProjectilePool>() : NULL;
+	if (ProjectilePool == NULL || !ProjectilePool->ReleaseProjectile(this))
+	{
+		Super::LifeSpanExpired();
+	}
 }
 
 void AShooterProjectile::InitVelocity(FVector& ShootDirection)
@@ -82,9 +173,19 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 	// effects and damage origin shouldn't be placed inside mesh at impact point
 	const FVector NudgedImpactLocation = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
 
-	if (WeaponConfig.ExplosionDamage > 0 && WeaponConfig.ExplosionRadius > 0 && WeaponConfig.DamageType)
+	if (WeaponConfig->ExplosionDamage > 0 && WeaponConfig->ExplosionRadius > 0 && WeaponConfig->DamageType)
 	{
-		UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
+		UShooterDamageGrid* DamageGrid = GetWorld()->GetSubsystem<UShooterDamageGrid>();
+		if (DamageGrid)
+		{
+			DamageGrid->ApplyRadialDamage(WeaponConfig->ExplosionDamage, NudgedImpactLocation, WeaponConfig->ExplosionRadius, WeaponConfig->DamageType, this, MyController.Get());
+		}
+
+		UShooterInfluenceMap* InfluenceMap = GetWorld()->GetSubsystem<UShooterInfluenceMap>();
+		if (InfluenceMap)
+		{
+			InfluenceMap->AddExplosion(NudgedImpactLocation, WeaponConfig->ExplosionRadius, WeaponConfig->ExplosionDamage);
+		}
 	}
 
 	if (ExplosionTemplate)
@@ -118,6 +219,12 @@ void AShooterProjectile::DisableAndDestroy()
 ///CODE_SNIPPET_START: AActor::GetActorLocation AActor::GetActorRotation
 void AShooterProjectile::OnRep_Exploded()
 {
+	if (!bExploded)
+	{
+		// reset by pool reuse
+		return;
+	}
+
 	FVector ProjDirection = GetActorForwardVector();
 
 	const FVector StartTrace = GetActorLocation() - ProjDirection * 200;
@@ -135,6 +242,11 @@ void AShooterProjectile::OnRep_Exploded()
 }
 ///CODE_SNIPPET_END
 
+void AShooterProjectile::OnRep_PoolGeneration()
+{
+	ResetSimulation();
+}
+
 void AShooterProjectile::PostNetReceiveVelocity(const FVector& NewVelocity)
 {
 	if (MovementComp)
@@ -148,4 +260,5 @@ void AShooterProjectile::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
 	
 	DOREPLIFETIME( AShooterProjectile, bExploded );
+	DOREPLIFETIME( AShooterProjectile, PoolGeneration );
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterProjectilePool.h"
+#include "Weapons/ShooterProjectile.h"
+
+int32 CVar_ShooterProjectilePool_Enable = 1;
+static FAutoConsoleVariableRef CVarShooterProjectilePoolEnable(TEXT("ShooterProjectilePool.Enable"), CVar_ShooterProjectilePool_Enable, TEXT("Reuse exploded projectiles instead of destroying them. 0: Disable, 1: Enable"), ECVF_Default );
+
+AShooterProjectile* UShooterProjectilePool::AcquireProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTM, FVector ShootDir, AActor* OwnerWeapon, APawn* InInstigator)
+{
+	if (ProjectileClass == NULL)
+	{
+		return NULL;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	++NumAcquired;
+
+	FShooterProjectilePoolEntry* Pool = CVar_ShooterProjectilePool_Enable ? Pools.Find(ProjectileClass) : NULL;
+	while (Pool && Pool->Inactive.Num() > 0)
+	{
+		AShooterProjectile* Projectile = Pool->Inactive.Pop(false);
+		if (Projectile && !Projectile->IsPendingKill())
+		{
+			Projectile->SetActorTransform(SpawnTM, false, NULL, ETeleportType::ResetPhysics);
+			Projectile->SetInstigator(InInstigator);
+			Projectile->SetOwner(OwnerWeapon);
+			Projectile->ActivateFromPool();
+			Projectile->InitVelocity(ShootDir);
+
+			++NumReused;
+			TotalReuseTime += FPlatformTime::Seconds() - StartTime;
+			return Projectile;
+		}
+	}
+
+	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileClass, SpawnTM));
+	if (Projectile)
+	{
+		Projectile->SetInstigator(InInstigator);
+		Projectile->SetOwner(OwnerWeapon);
+		Projectile->InitVelocity(ShootDir);
+		Projectile->bReturnToPool = (CVar_ShooterProjectilePool_Enable != 0);
+
+		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+	}
+
+	TotalSpawnTime += FPlatformTime::Seconds() - StartTime;
+	return Projectile;
+}
+
+bool UShooterProjectilePool::ReleaseProjectile(AShooterProjectile* Projectile)
+{
+	if (Projectile == NULL || Projectile->IsPendingKill() || !CVar_ShooterProjectilePool_Enable)
+	{
+		return false;
+	}
+
+	const int32 PoolSize = Projectile->GetPoolSize();
+	FShooterProjectilePoolEntry& Pool = Pools.FindOrAdd(Projectile->GetClass());
+	if (Pool.Inactive.Num() >= PoolSize)
+	{
+		++NumOverflowed;
+		return false;
+	}
+
+	Projectile->DeactivateToPool();
+	Pool.Inactive.Add(Projectile);
+	return true;
+}
+
+void UShooterProjectilePool::DumpStats() const
+{
+	const int32 NumSpawned = NumAcquired - NumReused;
+	const double AvgSpawnTime = NumSpawned > 0 ? TotalSpawnTime / NumSpawned : 0.0;
+	const double AvgReuseTime = NumReused > 0 ? TotalReuseTime / NumReused : 0.0;
+	const double TimeSaved = FMath::Max(0.0, AvgSpawnTime - AvgReuseTime) * NumReused;
+
+	int32 NumPooled = 0;
+	for (const TPair<UClass*, FShooterProjectilePoolEntry>& It : Pools)
+	{
+		NumPooled += It.Value.Inactive.Num();
+		UE_LOG(LogShooterWeapon, Log, TEXT("  %s: %d pooled"), *GetNameSafe(It.Key), It.Value.Inactive.Num());
+	}
+
+	UE_LOG(LogShooterWeapon, Log, TEXT("Projectile pool: %d acquired, %d reused (%.1f%%), %d spawned, %d overflowed, %d pooled"),
+		NumAcquired, NumReused, NumAcquired > 0 ? 100.0f * NumReused / NumAcquired : 0.0f, NumSpawned, NumOverflowed, NumPooled);
+	UE_LOG(LogShooterWeapon, Log, TEXT("Projectile pool: avg spawn %.3f ms, avg reuse %.3f ms, spawn time saved %.2f ms"),
+		AvgSpawnTime * 1000.0, AvgReuseTime * 1000.0, TimeSaved * 1000.0);
+}
+
+void UShooterProjectilePool::ResetStats()
+{
+	NumAcquired = 0;
+	NumReused = 0;
+	NumOverflowed = 0;
+	TotalSpawnTime = 0.0;
+	TotalReuseTime = 0.0;
+}
+
+void UShooterProjectilePool::Deinitialize()
+{
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterProjectilePoolStatsCmd(TEXT("ShooterProjectilePool.Stats"), TEXT("Prints projectile pool reuse rate and spawn time saved. Pass 'reset' to clear counters."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		UShooterProjectilePool* ProjectilePool = World ? World->GetSubsystem<UShooterProjectilePool>() : NULL;
+		if (ProjectilePool)
+		{
+			ProjectilePool->DumpStats();
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				ProjectilePool->ResetStats();
+			}
+		}
+	})
+);
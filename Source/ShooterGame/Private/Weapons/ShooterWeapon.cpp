@@ -2,10 +2,12 @@
 
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Weapons/ShooterWeaponConfig.h"
 #include "Player/ShooterCharacter.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Bots/ShooterAIController.h"
 #include "Online/ShooterPlayerState.h"
+#include "Online/ShooterTelemetry.h"
 #include "UI/ShooterHUD.h"
 #include "MatineeCameraShake.h"
 
@@ -45,6 +47,10 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	CurrentAmmoInClip = 0;
 	BurstCounter = 0;
 	LastFireTime = 0.0f;
+	bFireClockRunning = false;
+	bBatchingShots = false;
+	FireClockStartFrame = 0;
+	PendingServerShots = 0;
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
@@ -57,12 +63,7 @@ void AShooterWeapon::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (WeaponConfig.InitialClips > 0)
-	{
-		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
-		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
-	}
-
+	ResetAmmo();
 	DetachMeshFromPawn();
 }
 
@@ -73,6 +74,17 @@ void AShooterWeapon::Destroyed()
 	StopSimulatingWeaponFire();
 }
 
+void AShooterWeapon::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// clock started this frame already fired or scheduled its shot
+	if (bFireClockRunning && FireClockStartFrame != GFrameCounter)
+	{
+		HandleReFiring(DeltaSeconds);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Inventory
 
@@ -264,7 +276,7 @@ void AShooterWeapon::StartReload(bool bFromReplication)
 		float AnimDuration = PlayWeaponAnimation(ReloadAnim);		
 		if (AnimDuration <= 0.0f)
 		{
-			AnimDuration = WeaponConfig.NoAnimReloadDuration;
+			AnimDuration = GetWeaponConfig().NoAnimReloadDuration;
 		}
 
 		GetWorldTimerManager().SetTimer(TimerHandle_StopReload, this, &AShooterWeapon::StopReload, AnimDuration, false);
@@ -348,7 +360,7 @@ bool AShooterWeapon::CanFire() const
 bool AShooterWeapon::CanReload() const
 {
 	bool bCanReload = (!MyPawn || MyPawn->CanReload());
-	bool bGotAmmo = ( CurrentAmmoInClip < WeaponConfig.AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
+	bool bGotAmmo = ( CurrentAmmoInClip < GetWeaponConfig().AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
 	bool bStateOKToReload = ( ( CurrentState ==  EWeaponState::Idle ) || ( CurrentState == EWeaponState::Firing) );
 	return ( ( bCanReload == true ) && ( bGotAmmo == true ) && ( bStateOKToReload == true) );	
 }
@@ -359,7 +371,7 @@ bool AShooterWeapon::CanReload() const
 
 void AShooterWeapon::GiveAmmo(int AddAmount)
 {
-	const int32 MissingAmmo = FMath::Max(0, WeaponConfig.MaxAmmo - CurrentAmmo);
+	const int32 MissingAmmo = FMath::Max(0, GetWeaponConfig().MaxAmmo - CurrentAmmo);
 	AddAmount = FMath::Min(AddAmount, MissingAmmo);
 	CurrentAmmo += AddAmount;
 
@@ -378,6 +390,20 @@ void AShooterWeapon::GiveAmmo(int AddAmount)
 	}
 }
 
+void AShooterWeapon::ResetAmmo()
+{
+	if (GetWeaponConfig().InitialClips > 0)
+	{
+		CurrentAmmoInClip = GetWeaponConfig().AmmoPerClip;
+		CurrentAmmo = GetWeaponConfig().AmmoPerClip * GetWeaponConfig().InitialClips;
+	}
+	else
+	{
+		CurrentAmmoInClip = 0;
+		CurrentAmmo = 0;
+	}
+}
+
 void AShooterWeapon::UseAmmo()
 {
 	if (!HasInfiniteAmmo())
@@ -390,6 +416,11 @@ void AShooterWeapon::UseAmmo()
 		CurrentAmmo--;
 	}
 
+	if (UShooterTelemetry* Telemetry = UShooterTelemetry::Get(GetWorld()))
+	{
+		Telemetry->Record(EShooterTelemetryEvent::Shot, (uint8)GetAmmoType(), MyPawn ? MyPawn->GetPlayerState() : NULL, NULL, 0.0f, GetActorLocation());
+	}
+
 	AShooterAIController* BotAI = MyPawn ? Cast<AShooterAIController>(MyPawn->GetController()) : NULL;	
 	AShooterPlayerController* PlayerController = MyPawn ? Cast<AShooterPlayerController>(MyPawn->GetController()) : NULL;
 	if (BotAI)
@@ -414,19 +445,31 @@ void AShooterWeapon::UseAmmo()
 	}
 }
 
-void AShooterWeapon::HandleReFiring()
+void AShooterWeapon::HandleReFiring(float DeltaSeconds)
 {
-	// Update TimerIntervalAdjustment
-	UWorld* MyWorld = GetWorld();
+	const int32 NumShots = FireAccumulator.Advance(DeltaSeconds, GetWeaponConfig().TimeBetweenShots, FMath::Max(MaxShotsPerFrame, 1), bAllowAutomaticWeaponCatchup);
 
-	float SlackTimeThisFrame = FMath::Max(0.0f, (MyWorld->TimeSeconds - LastFireTime) - WeaponConfig.TimeBetweenShots);
+	bBatchingShots = true;
+	for (int32 ShotIdx = 0; ShotIdx < NumShots && bFireClockRunning; ShotIdx++)
+	{
+		HandleFiring();
+	}
+	bBatchingShots = false;
 
-	if (bAllowAutomaticWeaponCatchup)
+	// local client will notify server about all shots fired this frame at once
+	if (PendingServerShots > 0)
 	{
-		TimerIntervalAdjustment -= SlackTimeThisFrame;
+		ServerHandleFiring((uint8)FMath::Min<int32>(PendingServerShots, MaxShotsPerServerRequest));
+		PendingServerShots = 0;
 	}
+}
 
-	HandleFiring();
+void AShooterWeapon::StartFireClock(float ElapsedTime)
+{
+	FireAccumulator.Reset();
+	FireAccumulator.Accumulated = ElapsedTime;
+	FireClockStartFrame = GFrameCounter;
+	bFireClockRunning = true;
 }
 
 void AShooterWeapon::HandleFiring()
@@ -481,7 +524,14 @@ void AShooterWeapon::HandleFiring()
 		// local client will notify server
 		if (GetLocalRole() < ROLE_Authority)
 		{
-			ServerHandleFiring();
+			if (bBatchingShots)
+			{
+				PendingServerShots++;
+			}
+			else
+			{
+				ServerHandleFiring(1);
+			}
 		}
 
 		// reload after firing last round
@@ -490,46 +540,56 @@ void AShooterWeapon::HandleFiring()
 			StartReload();
 		}
 
-		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f);
-		if (bRefiring)
+		// keep refire clock running, leftover time is kept for catch up
+		bRefiring = (CurrentState == EWeaponState::Firing && GetWeaponConfig().TimeBetweenShots > 0.0f);
+		if (bRefiring && !bFireClockRunning)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleReFiring, FMath::Max<float>(WeaponConfig.TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
-			TimerIntervalAdjustment = 0.f;
+			StartFireClock(0.0f);
 		}
+		bFireClockRunning = bRefiring;
+	}
+	else
+	{
+		// remote weapons fire on server request
+		bFireClockRunning = false;
 	}
 
 	LastFireTime = GetWorld()->GetTimeSeconds();
 }
 
-bool AShooterWeapon::ServerHandleFiring_Validate()
+bool AShooterWeapon::ServerHandleFiring_Validate(uint8 NumShots)
 {
-	return true;
+	return NumShots > 0 && NumShots <= MaxShotsPerServerRequest;
 }
 
-void AShooterWeapon::ServerHandleFiring_Implementation()
+void AShooterWeapon::ServerHandleFiring_Implementation(uint8 NumShots)
 {
-	const bool bShouldUpdateAmmo = (CurrentAmmoInClip > 0 && CanFire());
+	// config of client may differ, server's own limit wins
+	const int32 NumAllowedShots = FMath::Min<int32>(NumShots, FMath::Max(MaxShotsPerFrame, 1));
+	for (int32 ShotIdx = 0; ShotIdx < NumAllowedShots; ShotIdx++)
+	{
+		const bool bShouldUpdateAmmo = (CurrentAmmoInClip > 0 && CanFire());
 
-	HandleFiring();
+		HandleFiring();
 
-	if (bShouldUpdateAmmo)
-	{
-		// update ammo
-		UseAmmo();
+		if (bShouldUpdateAmmo)
+		{
+			// update ammo
+			UseAmmo();
 
-		// update firing FX on remote clients
-		BurstCounter++;
+			// update firing FX on remote clients
+			BurstCounter++;
+		}
 	}
 }
 
 void AShooterWeapon::ReloadWeapon()
 {
-	int32 ClipDelta = FMath::Min(WeaponConfig.AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
+	int32 ClipDelta = FMath::Min(GetWeaponConfig().AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
 
 	if (HasInfiniteClip())
 	{
-		ClipDelta = WeaponConfig.AmmoPerClip - CurrentAmmoInClip;
+		ClipDelta = GetWeaponConfig().AmmoPerClip - CurrentAmmoInClip;
 	}
 
 	if (ClipDelta > 0)
@@ -594,13 +654,14 @@ void AShooterWeapon::OnBurstStarted()
 {
 	// start firing, can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-		LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+	if (LastFireTime > 0 && GetWeaponConfig().TimeBetweenShots > 0.0f &&
+		LastFireTime + GetWeaponConfig().TimeBetweenShots > GameTime)
 	{
-		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AShooterWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+		StartFireClock(GameTime - LastFireTime);
 	}
 	else
 	{
+		FireAccumulator.Reset();
 		HandleFiring();
 	}
 }
@@ -616,11 +677,11 @@ void AShooterWeapon::OnBurstFinished()
 		StopSimulatingWeaponFire();
 	//}
 	
-	GetWorldTimerManager().ClearTimer(TimerHandle_HandleFiring);
 	bRefiring = false;
 
-	// reset firing interval adjustment
-	TimerIntervalAdjustment = 0.0f;
+	// stop refire clock
+	bFireClockRunning = false;
+	FireAccumulator.Reset();
 }
 
 
@@ -926,6 +987,24 @@ void AShooterWeapon::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & O
 	DOREPLIFETIME_CONDITION( AShooterWeapon, bPendingReload,	COND_SkipOwner );
 }
 
+const FWeaponData& AShooterWeapon::GetWeaponConfig() const
+{
+	return TuningConfig ? TuningConfig->WeaponConfig : GetClass()->GetDefaultObject<AShooterWeapon>()->WeaponConfig;
+}
+
+UShooterWeaponConfig* AShooterWeapon::GetTuningConfig() const
+{
+	return TuningConfig;
+}
+
+#if WITH_EDITOR
+void AShooterWeapon::MigrateToTuningConfig(UShooterWeaponConfig* NewConfig)
+{
+	NewConfig->WeaponConfig = WeaponConfig;
+	TuningConfig = NewConfig;
+}
+#endif
+
 USkeletalMeshComponent* AShooterWeapon::GetWeaponMesh() const
 {
 	return (MyPawn != NULL && MyPawn->IsFirstPerson()) ? Mesh1P : Mesh3P;
@@ -963,24 +1042,24 @@ int32 AShooterWeapon::GetCurrentAmmoInClip() const
 
 int32 AShooterWeapon::GetAmmoPerClip() const
 {
-	return WeaponConfig.AmmoPerClip;
+	return GetWeaponConfig().AmmoPerClip;
 }
 
 int32 AShooterWeapon::GetMaxAmmo() const
 {
-	return WeaponConfig.MaxAmmo;
+	return GetWeaponConfig().MaxAmmo;
 }
 
 bool AShooterWeapon::HasInfiniteAmmo() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
+	return GetWeaponConfig().bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
 }
 
 bool AShooterWeapon::HasInfiniteClip() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
+	return GetWeaponConfig().bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
 }
 
 float AShooterWeapon::GetEquipStartedTime() const
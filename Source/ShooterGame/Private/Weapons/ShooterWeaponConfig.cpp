@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponConfig.h"
+
+const FPrimaryAssetType UShooterWeaponConfig::PrimaryAssetType = TEXT("WeaponConfig");
+
+UShooterWeaponConfig::UShooterWeaponConfig(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+}
+
+FPrimaryAssetId UShooterWeaponConfig::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+bool UShooterWeaponConfig::SetTuningValue(const FString& PropertyPath, const FString& Value)
+{
+	FString StructName, FieldName;
+	if (!PropertyPath.Split(TEXT("."), &StructName, &FieldName))
+	{
+		return false;
+	}
+
+	FStructProperty* StructProp = FindFProperty<FStructProperty>(GetClass(), *StructName);
+	FProperty* FieldProp = StructProp ? StructProp->Struct->FindPropertyByName(*FieldName) : NULL;
+	if (FieldProp == NULL)
+	{
+		return false;
+	}
+
+	void* StructData = StructProp->ContainerPtrToValuePtr<void>(this);
+	return FieldProp->ImportText(*Value, FieldProp->ContainerPtrToValuePtr<void>(StructData), PPF_None, this) != NULL;
+}
+
+FAutoConsoleCommandWithWorldAndArgs ShooterWeaponsSetTuningCmd(TEXT("ShooterWeapons.SetTuning"), TEXT("Changes weapon tuning on a running game: <ConfigAsset> <Struct.Field> <Value>, e.g. DA_Rifle InstantConfig.HitDamage 12"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World)
+	{
+		if (Args.Num() < 3)
+		{
+			return;
+		}
+
+		for (TObjectIterator<UShooterWeaponConfig> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject) && It->GetName() == Args[0])
+			{
+				const bool bChanged = It->SetTuningValue(Args[1], Args[2]);
+				UE_LOG(LogShooterWeapon, Log, TEXT("%s %s = %s: %s"), *It->GetName(), *Args[1], *Args[2], bChanged ? TEXT("changed") : TEXT("failed"));
+				return;
+			}
+		}
+
+		UE_LOG(LogShooterWeapon, Warning, TEXT("Weapon config %s is not loaded"), *Args[0]);
+	})
+);
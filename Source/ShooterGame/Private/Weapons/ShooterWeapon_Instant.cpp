@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon_Instant.h"
+#include "Weapons/ShooterWeaponConfig.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterImpactEffect.h"
 
@@ -23,12 +24,12 @@ void AShooterWeapon_Instant::FireWeapon()
 	const FVector AimDir = GetAdjustedAim();
 	const FVector StartTrace = GetCameraDamageStartLocation(AimDir);
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+	const FVector EndTrace = StartTrace + ShootDir * GetInstantConfig().WeaponRange;
 
 	const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
 
-	CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
+	CurrentFiringSpread = FMath::Min(GetInstantConfig().FiringSpreadMax, CurrentFiringSpread + GetInstantConfig().FiringSpreadIncrement);
 }
 
 bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
@@ -48,7 +49,7 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 
 		// is the angle between the hit and the view within allowed limits (limit + weapon max angle)
 		const float ViewDotHitDir = FVector::DotProduct(GetInstigator()->GetViewRotation().Vector(), ViewDir);
-		if (ViewDotHitDir > InstantConfig.AllowedViewDotHitDir - WeaponAngleDot)
+		if (ViewDotHitDir > GetInstantConfig().AllowedViewDotHitDir - WeaponAngleDot)
 		{
 			if (CurrentState != EWeaponState::Idle)
 			{
@@ -72,7 +73,7 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 
 					// calculate the box extent, and increase by a leeway
 					FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
-					BoxExtent *= InstantConfig.ClientSideHitLeeway;
+					BoxExtent *= GetInstantConfig().ClientSideHitLeeway;
 
 					// avoid precision errors with really thin objects
 					BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
@@ -96,7 +97,7 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 				}
 			}
 		}
-		else if (ViewDotHitDir <= InstantConfig.AllowedViewDotHitDir)
+		else if (ViewDotHitDir <= GetInstantConfig().AllowedViewDotHitDir)
 		{
 			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (facing too far from the hit direction)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
 		}
@@ -124,7 +125,7 @@ void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantize
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantConfig().WeaponRange;
 		SpawnTrailEffect(EndTrace);
 	}
 }
@@ -177,7 +178,7 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantConfig().WeaponRange;
 		const FVector EndPoint = Impact.GetActor() ? Impact.ImpactPoint : EndTrace;
 
 		SpawnTrailEffect(EndPoint);
@@ -204,10 +205,10 @@ bool AShooterWeapon_Instant::ShouldDealDamage(AActor* TestActor) const
 void AShooterWeapon_Instant::DealDamage(const FHitResult& Impact, const FVector& ShootDir)
 {
 	FPointDamageEvent PointDmg;
-	PointDmg.DamageTypeClass = InstantConfig.DamageType;
+	PointDmg.DamageTypeClass = GetInstantConfig().DamageType;
 	PointDmg.HitInfo = Impact;
 	PointDmg.ShotDirection = ShootDir;
-	PointDmg.Damage = InstantConfig.HitDamage;
+	PointDmg.Damage = GetInstantConfig().HitDamage;
 
 	Impact.GetActor()->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
 }
@@ -225,15 +226,33 @@ void AShooterWeapon_Instant::OnBurstFinished()
 
 float AShooterWeapon_Instant::GetCurrentSpread() const
 {
-	float FinalSpread = InstantConfig.WeaponSpread + CurrentFiringSpread;
+	float FinalSpread = GetInstantConfig().WeaponSpread + CurrentFiringSpread;
 	if (MyPawn && MyPawn->IsTargeting())
 	{
-		FinalSpread *= InstantConfig.TargetingSpreadMod;
+		FinalSpread *= GetInstantConfig().TargetingSpreadMod;
 	}
 
 	return FinalSpread;
 }
 
+const FInstantWeaponData& AShooterWeapon_Instant::GetInstantConfig() const
+{
+	return TuningConfig ? TuningConfig->InstantConfig : GetClass()->GetDefaultObject<AShooterWeapon_Instant>()->InstantConfig;
+}
+
+#if WITH_EDITOR
+void AShooterWeapon_Instant::MigrateToTuningConfig(UShooterWeaponConfig* NewConfig)
+{
+	NewConfig->InstantConfig = InstantConfig;
+	Super::MigrateToTuningConfig(NewConfig);
+}
+#endif
+
+float AShooterWeapon_Instant::GetShotRange() const
+{
+	return GetInstantConfig().WeaponRange;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 // Replication & effects
@@ -251,7 +270,7 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 	const FVector StartTrace = ShotOrigin;
 	const FVector AimDir = GetAdjustedAim();
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+	const FVector EndTrace = StartTrace + ShootDir * GetInstantConfig().WeaponRange;
 
 	FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	if (Impact.bBlockingHit)
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon_Projectile.h"
 #include "Weapons/ShooterProjectile.h"
+#include "Weapons/ShooterProjectilePool.h"
+#include "Weapons/ShooterWeaponConfig.h"
 
 AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -72,18 +74,39 @@ bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FV
 void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
 {
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
-	if (Projectile)
+	UShooterProjectilePool* ProjectilePool = GetWorld()->GetSubsystem<UShooterProjectilePool>();
+	if (ProjectilePool)
 	{
-		Projectile->SetInstigator(GetInstigator());
-		Projectile->SetOwner(this);
-		Projectile->InitVelocity(ShootDir);
-
-		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+		ProjectilePool->AcquireProjectile(GetProjectileConfig().ProjectileClass, SpawnTM, ShootDir, this, GetInstigator());
 	}
 }
 
-void AShooterWeapon_Projectile::ApplyWeaponConfig(FProjectileWeaponData& Data)
+const FProjectileWeaponData& AShooterWeapon_Projectile::GetProjectileConfig() const
+{
+	return TuningConfig ? TuningConfig->ProjectileConfig : GetClass()->GetDefaultObject<AShooterWeapon_Projectile>()->ProjectileConfig;
+}
+
+UObject* AShooterWeapon_Projectile::GetProjectileConfigOwner() const
+{
+	return TuningConfig ? (UObject*)TuningConfig : GetClass()->GetDefaultObject();
+}
+
+#if WITH_EDITOR
+void AShooterWeapon_Projectile::MigrateToTuningConfig(UShooterWeaponConfig* NewConfig)
+{
+	NewConfig->ProjectileConfig = ProjectileConfig;
+	Super::MigrateToTuningConfig(NewConfig);
+}
+#endif
+
+float AShooterWeapon_Projectile::GetShotSpeed() const
+{
+	const TSubclassOf<AShooterProjectile> ProjectileClass = GetProjectileConfig().ProjectileClass;
+	const AShooterProjectile* ProjectileCDO = ProjectileClass ? ProjectileClass->GetDefaultObject<AShooterProjectile>() : NULL;
+	return (ProjectileCDO && ProjectileCDO->GetMovementComp()) ? ProjectileCDO->GetMovementComp()->InitialSpeed : 0.0f;
+}
+
+float AShooterWeapon_Projectile::GetShotRange() const
 {
-	Data = ProjectileConfig;
+	return GetShotSpeed() * GetProjectileConfig().ProjectileLife;
 }
@@ -5,6 +5,12 @@
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
 #include "BTTask_FindPointNearEnemy.generated.h"
 
+struct FBTFindPointNearEnemyMemory
+{
+	/** time query was started */
+	float StartTime;
+};
+
 // Bot AI task that tries to find a location near the current enemy
 UCLASS()
 class UBTTask_FindPointNearEnemy : public UBTTask_BlackboardBase
@@ -12,4 +18,24 @@ class UBTTask_FindPointNearEnemy : public UBTTask_BlackboardBase
 	GENERATED_UCLASS_BODY()
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+
+	/** fail if point wasn't found within this time */
+	UPROPERTY(EditAnywhere, Category = Node)
+	float Timeout;
+
+	/** path cost added to tactical point per unit of enemy presence from influence map */
+	UPROPERTY(EditAnywhere, Category = Node)
+	float ThreatCost;
+
+	/** path cost added to tactical point per unit of recent danger from influence map */
+	UPROPERTY(EditAnywhere, Category = Node)
+	float DangerCost;
+
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	/** ask nav query service for point, sets blackboard when found */
+	EBTNodeResult::Type RequestPoint(UBehaviorTreeComponent& OwnerComp) const;
 };
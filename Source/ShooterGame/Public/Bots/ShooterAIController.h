@@ -7,6 +7,25 @@
 class UBehaviorTreeComponent;
 class UBlackboardComponent;
 
+/** what a bot knows about its fight, blackboard is only written when this changes */
+struct FShooterBotPerception
+{
+	/** current target */
+	TWeakObjectPtr<APawn> Enemy;
+
+	/** weapon is almost out of ammo */
+	bool bNeedAmmo;
+
+	/** weapon can hit enemy */
+	bool bHasLOS;
+
+	FShooterBotPerception()
+		: bNeedAmmo(false)
+		, bHasLOS(false)
+	{
+	}
+};
+
 UCLASS(config=Game)
 class AShooterAIController : public AAIController
 {
@@ -52,6 +71,12 @@ public:
 		
 	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const;
 
+	/** get team whose pawns are never enemies, INDEX_NONE when everyone can be */
+	int32 GetFriendlyTeam() const;
+
+	/** [server] set lead corrected aim at enemy, solved by UShooterAimSolver this frame */
+	void SetAimSolution(const FVector& InAimDirection, bool bInAimCanFire);
+
 	// Begin AAIController interface
 	/** Update direction AI is looking based on FocalPoint */
 	virtual void UpdateControlRotation(float DeltaTime, bool bUpdatePawn = true) override;
@@ -63,6 +88,37 @@ protected:
 
 	int32 EnemyKeyID;
 	int32 NeedAmmoKeyID;
+	int32 HasLOSKeyID;
+
+	/** latest perception */
+	FShooterBotPerception Perception;
+
+	/** perception last written to blackboard and focus */
+	FShooterBotPerception AppliedPerception;
+
+	/** write every key on next apply, blackboard may hold values of previous pawn */
+	bool bForceApplyPerception;
+
+	/** refresh perception and apply changes */
+	void UpdatePerception();
+
+	/** write changed perception to blackboard and focus */
+	void ApplyPerception();
+
+	/** Handle for efficient management of UpdatePerception timer */
+	FTimerHandle TimerHandle_UpdatePerception;
+
+	/** lead corrected direction toward enemy */
+	FVector AimDirection;
+
+	/** aim is close enough to AimDirection to fire */
+	bool bAimCanFire;
+
+	/** frame aim was last solved */
+	uint64 AimFrame;
+
+	/** check if aim was solved this or last frame */
+	bool HasAimSolution() const { return AimFrame > 0 && AimFrame + 1 >= GFrameCounter; }
 
 	/** Handle for efficient management of Respawn timer */
 	FTimerHandle TimerHandle_Respawn;
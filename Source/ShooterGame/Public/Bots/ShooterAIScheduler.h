@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterAIScheduler.generated.h"
+
+class UShooterBehaviorTreeComponent;
+
+/** number of bot update tiers */
+#define SHOOTER_AI_LOD_TIERS 3
+
+/** tick counters of a single update tier */
+struct FShooterAILODTierStats
+{
+	/** bots currently in tier */
+	int32 NumBots;
+
+	/** behavior tree ticks done */
+	int32 NumTicks;
+
+	/** ticks run past budget because of max staleness */
+	int32 NumForcedTicks;
+
+	/** ticks postponed because budget was used up */
+	int32 NumDeferredTicks;
+
+	/** sum of time between ticks */
+	double TotalStaleness;
+
+	/** largest time between ticks */
+	float MaxStaleness;
+
+	FShooterAILODTierStats()
+	{
+		FMemory::Memzero(*this);
+	}
+};
+
+//
+// Server side scheduler of bot behavior trees. Bots are put into tiers by distance to the nearest human and whether they are
+// fighting, tiers set how often a tree may tick and the longest it may wait. Ticks within that window share a per frame time budget.
+//
+UCLASS()
+class UShooterAIScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] start scheduling behavior tree */
+	void RegisterComponent(UShooterBehaviorTreeComponent* BehaviorComp);
+
+	/** [server] stop scheduling behavior tree */
+	void UnregisterComponent(UShooterBehaviorTreeComponent* BehaviorComp);
+
+	/**
+	 * Check if behavior tree may tick now.
+	 *
+	 * @param Tier				Update tier of bot.
+	 * @param PendingDeltaTime	Time since tree last ticked.
+	 */
+	bool ShouldTick(uint8 Tier, float PendingDeltaTime);
+
+	/** record behavior tree tick */
+	void AddTickSample(uint8 Tier, float Staleness, double Seconds);
+
+	/** record behavior tree execution request, caused by observer aborts and finished tasks */
+	void AddFlowUpdate() { NumFlowUpdates++; }
+
+	/** record blackboard key update of bot perception */
+	void AddBlackboardUpdate(bool bWritten) { bWritten ? NumBlackboardWrites++ : NumSkippedBlackboardWrites++; }
+
+	/** get behavior tree time since stats were reset */
+	double GetTotalTreeTime() const { return TotalTreeTime; }
+
+	/** print per tier counters and frame times */
+	void DumpStats() const;
+
+	/** reset counters */
+	void ResetStats();
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** scheduled behavior trees */
+	UPROPERTY(Transient)
+	TArray<UShooterBehaviorTreeComponent*> Components;
+
+	/** frame budget was last reset */
+	uint64 BudgetFrame;
+
+	/** behavior tree time spent in BudgetFrame */
+	double FrameTreeTime;
+
+	/** counters per tier */
+	FShooterAILODTierStats TierStats[SHOOTER_AI_LOD_TIERS];
+
+	/** number of frames sampled */
+	int32 NumFrames;
+
+	/** total behavior tree time */
+	double TotalTreeTime;
+
+	/** total game thread time */
+	double TotalGameThreadTime;
+
+	/** total world time */
+	double TotalTime;
+
+	/** behavior tree execution requests processed */
+	int32 NumFlowUpdates;
+
+	/** perception keys written to blackboard */
+	int32 NumBlackboardWrites;
+
+	/** perception keys left alone because they didn't change */
+	int32 NumSkippedBlackboardWrites;
+
+	/** pick update tier of every bot */
+	void UpdateTiers();
+};
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterAimSolver.generated.h"
+
+class AShooterAIController;
+
+/** aim inputs and results of all bots, one array per component, padded to a multiple of 4 */
+struct FShooterAimBatch
+{
+	/** where shots start */
+	TArray<float> ShooterX, ShooterY, ShooterZ;
+
+	/** where target is */
+	TArray<float> TargetX, TargetY, TargetZ;
+
+	/** target velocity */
+	TArray<float> VelocityX, VelocityY, VelocityZ;
+
+	/** current aim direction */
+	TArray<float> ViewX, ViewY, ViewZ;
+
+	/** 1 / shot speed, 0 for instant hit */
+	TArray<float> InvShotSpeed;
+
+	/** squared shot range */
+	TArray<float> RangeSq;
+
+	/** lead corrected aim direction */
+	TArray<float> AimX, AimY, AimZ;
+
+	/** non zero when target is in range and current aim is close enough to fire */
+	TArray<uint8> bFire;
+
+	/** number of used entries */
+	int32 Num;
+
+	FShooterAimBatch()
+		: Num(0)
+	{
+	}
+
+	/** set size, padding entries aim at nothing */
+	void Reset(int32 InNum);
+
+	/** fill one entry */
+	void Set(int32 Idx, const FVector& Shooter, const FVector& Target, const FVector& Velocity, const FVector& View, float ShotSpeed, float Range);
+
+	/** get aim direction of entry */
+	FVector GetAim(int32 Idx) const { return FVector(AimX[Idx], AimY[Idx], AimZ[Idx]); }
+
+	/** solve all entries, four at a time */
+	void Solve(float CosFireTolerance);
+
+	/** solve all entries one at a time, reference for Solve */
+	void SolveScalar(float CosFireTolerance);
+};
+
+//
+// Server side aim of all bots, computed once per frame as one batch.
+// Leads targets by projectile flight time, controllers read the results in UpdateControlRotation and ShootEnemy.
+//
+UCLASS()
+class UShooterAimSolver : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] time batched and scalar solve over synthetic bots */
+	static void RunBenchmark(int32 NumBots, int32 NumIterations);
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** bots in Batch order */
+	TArray<TWeakObjectPtr<AShooterAIController>> Controllers;
+
+	/** reused between frames */
+	FShooterAimBatch Batch;
+};
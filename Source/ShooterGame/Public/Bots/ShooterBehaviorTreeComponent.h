@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "ShooterBehaviorTreeComponent.generated.h"
+
+class UShooterAIScheduler;
+
+// Behavior tree component whose ticks are granted by UShooterAIScheduler, skipped ticks are accumulated into the next one.
+UCLASS()
+class UShooterBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** update tier assigned by scheduler, 0 is most significant */
+	uint8 LODTier;
+
+	/** time passed since tree was last ticked */
+	float PendingDeltaTime;
+
+	// Begin UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	// End UActorComponent interface
+
+private:
+
+	/** scheduler of owning world, NULL when not registered */
+	TWeakObjectPtr<UShooterAIScheduler> Scheduler;
+};
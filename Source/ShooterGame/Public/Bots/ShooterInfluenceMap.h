@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterInfluenceMap.generated.h"
+
+/** influence grid, one is written by worker while the other is published to game thread */
+struct FShooterInfluenceGrid
+{
+	/** world location of cell (0,0) corner */
+	FVector2D Origin;
+
+	/** cell size in world units */
+	float CellSize;
+
+	/** number of cells */
+	int32 SizeX;
+	int32 SizeY;
+
+	/** team of each presence layer */
+	TArray<int32> LayerTeams;
+
+	/** pawn presence per team, SizeX * SizeY each */
+	TArray<TArray<float>> Presence;
+
+	/** recent damage and explosions, team agnostic */
+	TArray<float> Danger;
+
+	FShooterInfluenceGrid()
+		: Origin(FVector2D::ZeroVector)
+		, CellSize(0.0f)
+		, SizeX(0)
+		, SizeY(0)
+	{
+	}
+
+	/** get cell index of location, INDEX_NONE if outside */
+	int32 GetCellIndex(const FVector& Location) const
+	{
+		const int32 X = FMath::FloorToInt((Location.X - Origin.X) / CellSize);
+		const int32 Y = FMath::FloorToInt((Location.Y - Origin.Y) / CellSize);
+		return (CellSize > 0.0f && X >= 0 && Y >= 0 && X < SizeX && Y < SizeY) ? Y * SizeX + X : INDEX_NONE;
+	}
+};
+
+/** game thread snapshot handed to worker */
+struct FShooterInfluenceInput
+{
+	struct FPawnSample
+	{
+		uint32 Id;
+		int32 Team;
+		FVector Location;
+	};
+
+	struct FDangerSample
+	{
+		FVector Location;
+		float Radius;
+		float Amount;
+	};
+
+	TArray<FPawnSample> Pawns;
+	TArray<FDangerSample> DangerEvents;
+
+	/** time since previous update */
+	float DeltaTime;
+
+	/** reach of pawn presence */
+	float PawnRadius;
+
+	/** time for danger to halve */
+	float DangerHalfLife;
+};
+
+/** state owned by worker between updates */
+struct FShooterInfluenceWorkState
+{
+	/** grid being written */
+	TSharedPtr<FShooterInfluenceGrid, ESPMode::ThreadSafe> WriteGrid;
+
+	/** grid last published, only read while game thread may be reading it too */
+	TSharedPtr<FShooterInfluenceGrid, ESPMode::ThreadSafe> PublishedGrid;
+
+	/** cells changed in WriteGrid since it was last brought up to date with PublishedGrid */
+	TBitArray<> DirtyCells;
+
+	/** every cell changed, WriteGrid needs a full copy */
+	bool bAllDirty;
+
+	/** grids were swapped since last update, WriteGrid is missing changes of PublishedGrid */
+	bool bPublished;
+
+	/** cell each pawn was last stamped at */
+	TMap<uint32, TPair<int32, int32>> PawnStamps;
+
+	/** cells with danger above zero */
+	TSet<int32> ActiveDangerCells;
+
+	/** updates since presence layers were last rebuilt from scratch */
+	int32 UpdatesSinceRebuild;
+
+	/** reach of pawn presence stamps currently in grid */
+	float StampRadius;
+
+	/** duration of last update */
+	double LastUpdateTime;
+
+	FShooterInfluenceWorkState()
+		: WriteGrid(MakeShared<FShooterInfluenceGrid, ESPMode::ThreadSafe>())
+		, PublishedGrid(MakeShared<FShooterInfluenceGrid, ESPMode::ThreadSafe>())
+		, bAllDirty(false)
+		, bPublished(false)
+		, UpdatesSinceRebuild(0)
+		, StampRadius(0.0f)
+		, LastUpdateTime(0.0)
+	{
+	}
+
+	/** apply one update */
+	void Update(const FShooterInfluenceInput& Input);
+
+	/** [game thread] swap written and published grid, worker must be idle */
+	void Publish();
+
+	/** copy cells changed by the update before last from PublishedGrid */
+	void CatchUp();
+
+	/** flag cell as changed */
+	void MarkDirty(int32 CellIdx);
+
+	/** add or remove pawn stamp */
+	void StampPawn(int32 LayerIdx, int32 CellIdx, float Sign);
+
+	/** add danger around location */
+	void StampDanger(const FVector& Location, float Radius, float Amount);
+
+	/** get presence layer of team, added on demand */
+	int32 GetLayer(int32 Team);
+};
+
+//
+// Server side influence map of pawn presence per team and recent danger, over the navmesh bounds.
+// Updated incrementally on a worker thread at ShooterInfluence.UpdateRate into one of two grids, readers use the other one without locks.
+// Publishing swaps the grids, the worker then brings its grid up to date by copying only the cells the previous update changed.
+//
+UCLASS()
+class UShooterInfluenceMap : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] someone was damaged at location */
+	void AddDamageEvent(const FVector& Location, float Damage);
+
+	/** [server] explosion went off */
+	void AddExplosion(const FVector& Location, float Radius, float Damage);
+
+	/**
+	 * Get presence of pawns that can be enemies of a team.
+	 *
+	 * @param Location		Query location.
+	 * @param FriendlyTeam	Team whose presence is ignored, INDEX_NONE to count everyone.
+	 */
+	float GetThreat(const FVector& Location, int32 FriendlyTeam) const;
+
+	/** get recent danger at location */
+	float GetDanger(const FVector& Location) const;
+
+	/** get published grid */
+	const FShooterInfluenceGrid& GetGrid() const { return *ReadGrid; }
+
+	/** [server] time full and incremental updates at several cell sizes */
+	void RunBenchmark(int32 NumIterations);
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** grid read by game thread, published grid of WorkState or empty */
+	TSharedPtr<const FShooterInfluenceGrid, ESPMode::ThreadSafe> ReadGrid;
+
+	/** worker state, not touched by game thread while update is running */
+	TSharedPtr<FShooterInfluenceWorkState, ESPMode::ThreadSafe> WorkState;
+
+	/** running update */
+	TFuture<void> PendingUpdate;
+
+	/** danger events since last update */
+	TArray<FShooterInfluenceInput::FDangerSample> PendingDanger;
+
+	/** time since last update was started */
+	float TimeSinceUpdate;
+
+	/** number of updates published */
+	int32 NumUpdates;
+
+	/** total worker time */
+	double TotalUpdateTime;
+
+	/** set up grid over navmesh bounds */
+	void InitGrid(FShooterInfluenceGrid& Grid, float CellSize) const;
+
+	/** gather pawns for worker */
+	void GatherPawns(FShooterInfluenceInput& Input) const;
+
+	/** draw published grid */
+	void DrawDebug() const;
+
+	/** check if map is updated in this world, it's server only */
+	bool IsRecording() const;
+};
@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterLOSService.generated.h"
+
+/** outcome of a line of sight trace from a bot's eyes to a target */
+struct FShooterLOSResult
+{
+	/** trace was blocked before reaching target location */
+	bool bBlockingHit;
+
+	/** actor that blocked the trace */
+	TWeakObjectPtr<AActor> HitActor;
+
+	/** squared distance from trace start to blocking hit */
+	float HitDistSq;
+
+	/** squared distance from trace start to target location */
+	float TargetDistSq;
+
+	/** world time the trace was done */
+	float TraceTime;
+
+	FShooterLOSResult()
+		: bBlockingHit(false)
+		, HitDistSq(0.0f)
+		, TargetDistSq(0.0f)
+		, TraceTime(0.0f)
+	{
+	}
+};
+
+/** who looks at what, vector targets are quantized so nearby points share a trace */
+struct FShooterLOSKey
+{
+	TWeakObjectPtr<APawn> Querier;
+	TWeakObjectPtr<AActor> Target;
+	FIntVector TargetCell;
+
+	bool operator==(const FShooterLOSKey& Other) const
+	{
+		return Querier == Other.Querier && Target == Other.Target && TargetCell == Other.TargetCell;
+	}
+
+	friend uint32 GetTypeHash(const FShooterLOSKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.Querier), GetTypeHash(Key.Target)), GetTypeHash(Key.TargetCell));
+	}
+};
+
+//
+// Server side line of sight cache for bots. Callers get results no older than ShooterLOS.TTL, stale entries are refreshed
+// with async traces limited by ShooterLOS.AsyncTracesPerFrame, and identical requests share a single trace.
+//
+UCLASS()
+class UShooterLOSService : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Get line of sight from pawn's eyes to target.
+	 *
+	 * @param Querier			Looking pawn, ignored by trace.
+	 * @param Target			Target actor, NULL when looking at a location.
+	 * @param TargetLocation	Where to trace to.
+	 * @return trace outcome valid until next request, NULL if not known yet - ask again next frame
+	 */
+	const FShooterLOSResult* RequestLOS(APawn* Querier, AActor* Target, const FVector& TargetLocation);
+
+	/** print request and trace counters */
+	void DumpStats() const;
+
+	/** reset counters */
+	void ResetStats();
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** cached entry */
+	struct FEntry
+	{
+		FShooterLOSResult Result;
+		FVector TargetLocation;
+		float LastRequestTime;
+		bool bHasResult;
+		bool bPending;
+
+		FEntry()
+			: TargetLocation(FVector::ZeroVector)
+			, LastRequestTime(0.0f)
+			, bHasResult(false)
+			, bPending(false)
+		{
+		}
+	};
+
+	/** results per querier and target */
+	TMap<FShooterLOSKey, FEntry> Entries;
+
+	/** keys waiting for an async trace, oldest first */
+	TArray<FShooterLOSKey> PendingKeys;
+
+	/** async traces in flight */
+	TMap<uint32, FShooterLOSKey> InFlight;
+
+	/** id of next async trace */
+	uint32 NextTraceId;
+
+	/** sync traces left this frame */
+	int32 SyncTracesLeft;
+
+	/** number of RequestLOS calls */
+	int32 NumRequests;
+
+	/** number of requests answered from cache */
+	int32 NumCacheHits;
+
+	/** number of requests answered with stale result while refresh is pending */
+	int32 NumStaleHits;
+
+	/** number of requests merged into an already pending one */
+	int32 NumCoalesced;
+
+	/** number of sync traces done */
+	int32 NumSyncTraces;
+
+	/** number of async traces issued */
+	int32 NumAsyncTraces;
+
+	/** sum of result ages returned to callers */
+	double TotalResultAge;
+
+	/**
+	 * Trace from querier eyes to target location.
+	 * Eyes are BaseEyeHeight above actor location, the point HasWeaponLOSToEnemy traced from before results were cached,
+	 * not GetPawnViewLocation, so crouching and aim offsets don't change cached results. Async traces take it when issued.
+	 */
+	void GetTraceEnds(APawn* Querier, const FVector& TargetLocation, FVector& OutStart, FVector& OutEnd) const;
+
+	/** get trace params for querier */
+	FCollisionQueryParams GetTraceParams(APawn* Querier) const;
+
+	/** store trace outcome */
+	void StoreResult(FEntry& Entry, const FHitResult* Hit, const FVector& Start, const FVector& End);
+
+	/** async trace finished */
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+};
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterNavQueryService.generated.h"
+
+namespace EShooterNavQueryStatus
+{
+	enum Type
+	{
+		Pending,
+		Succeeded,
+		Failed,
+	};
+}
+
+/** approach point around an enemy, one per direction sector */
+struct FShooterNavQueryKey
+{
+	TWeakObjectPtr<AActor> Enemy;
+	uint8 Sector;
+
+	bool operator==(const FShooterNavQueryKey& Other) const
+	{
+		return Enemy == Other.Enemy && Sector == Other.Sector;
+	}
+
+	friend uint32 GetTypeHash(const FShooterNavQueryKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Enemy), Key.Sector);
+	}
+};
+
+//
+// Server side queue of navmesh point queries for bots. Queries run in Tick within ShooterNavQuery.BudgetMs,
+// results are cached per enemy and direction for ShooterNavQuery.CacheTime so bots flanking the same enemy share them.
+//
+UCLASS()
+class UShooterNavQueryService : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Get reachable point near enemy, on the side facing querier.
+	 *
+	 * @param Enemy				Enemy to approach.
+	 * @param QuerierLocation	Location of bot looking for the point.
+	 * @param OutLocation		Found point.
+	 * @return Pending until the query has run, ask again later
+	 */
+	EShooterNavQueryStatus::Type RequestPointNearEnemy(AActor* Enemy, const FVector& QuerierLocation, FVector& OutLocation);
+
+	/** print query counters */
+	void DumpStats() const;
+
+	/** reset counters */
+	void ResetStats();
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** cached query */
+	struct FEntry
+	{
+		FVector Location;
+		float QueryTime;
+		float LastRequestTime;
+		bool bHasResult;
+		bool bSuccess;
+		bool bQueued;
+
+		FEntry()
+			: Location(FVector::ZeroVector)
+			, QueryTime(0.0f)
+			, LastRequestTime(0.0f)
+			, bHasResult(false)
+			, bSuccess(false)
+			, bQueued(false)
+		{
+		}
+	};
+
+	/** results per enemy and sector */
+	TMap<FShooterNavQueryKey, FEntry> Entries;
+
+	/** keys waiting for a query, oldest first */
+	TArray<FShooterNavQueryKey> PendingKeys;
+
+	/** number of requests */
+	int32 NumRequests;
+
+	/** number of requests answered from cache */
+	int32 NumCacheHits;
+
+	/** number of navmesh queries run */
+	int32 NumQueries;
+
+	/** number of frames sampled */
+	int32 NumFrames;
+
+	/** longest time spent on queries in a frame */
+	double MaxFrameQueryTime;
+
+	/** total time spent on queries */
+	double TotalQueryTime;
+
+	/** run navmesh query for key */
+	void RunQuery(const FShooterNavQueryKey& Key, FEntry& Entry);
+};
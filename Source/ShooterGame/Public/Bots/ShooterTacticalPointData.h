@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "ShooterTacticalPointData.generated.h"
+
+namespace EShooterTacticalPoint
+{
+	enum Flags
+	{
+		/** low obstacle next to point */
+		Cover			= 1 << 0,
+		/** obstacle next to point blocks standing sight too */
+		FullCover		= 1 << 1,
+		/** wall next to point can be wall ran */
+		WallRunEntry	= 1 << 2,
+		/** point sees more of the map than most */
+		Sightline		= 1 << 3,
+	};
+}
+
+/** single baked point on navmesh */
+USTRUCT()
+struct FShooterTacticalPoint
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** location on navmesh */
+	UPROPERTY()
+	FVector Location;
+
+	/** EShooterTacticalPoint flags */
+	UPROPERTY()
+	uint8 Flags;
+
+	/** sightline cluster, points in a cluster see each other */
+	UPROPERTY()
+	uint16 Cluster;
+
+	FShooterTacticalPoint()
+		: Location(FVector::ZeroVector)
+		, Flags(0)
+		, Cluster(0)
+	{
+	}
+};
+
+//
+// Tactical points of a single map with pairwise visibility and path costs, baked offline with ShooterTactical.Bake.
+// Visibility is a bitset and path costs are quantized to 16 bits, both are N x N row major.
+// Path costs are baked only for pairs within MaxPathDistance, queries estimate the rest.
+//
+UCLASS()
+class UShooterTacticalPointData : public UDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** baked points */
+	UPROPERTY()
+	TArray<FShooterTacticalPoint> Points;
+
+	/** bit (i * N + j) is set when eyes at point j are visible from eyes at point i */
+	UPROPERTY()
+	TArray<uint32> VisibilityBits;
+
+	/** path cost from point i to point j in units of PathCostScale, MAX_uint16 when unknown or unreachable */
+	UPROPERTY()
+	TArray<uint16> PathCosts;
+
+	/** world units per path cost step */
+	UPROPERTY()
+	float PathCostScale;
+
+	/** distance between sampled points */
+	UPROPERTY()
+	float Spacing;
+
+	/** pairs further apart than this have no baked path cost */
+	UPROPERTY()
+	float MaxPathDistance;
+
+	/** check visibility between points */
+	bool IsVisible(int32 FromIdx, int32 ToIdx) const
+	{
+		const int32 Bit = FromIdx * Points.Num() + ToIdx;
+		return (VisibilityBits[Bit >> 5] & (1u << (Bit & 31))) != 0;
+	}
+
+	/** get path cost between points, MAX_FLT if unknown */
+	float GetPathCost(int32 FromIdx, int32 ToIdx) const
+	{
+		const uint16 Cost = PathCosts[FromIdx * Points.Num() + ToIdx];
+		return Cost == MAX_uint16 ? MAX_FLT : Cost * PathCostScale;
+	}
+
+	/** check if path cost between points was baked, pairs too far apart were skipped */
+	bool HasBakedPathCost(int32 FromIdx, int32 ToIdx) const
+	{
+		return FVector::DistSquared(Points[FromIdx].Location, Points[ToIdx].Location) <= FMath::Square(MaxPathDistance);
+	}
+
+#if WITH_EDITOR
+	/**
+	 * Sample navmesh of world and fill points, visibility and path costs.
+	 *
+	 * @param World		World with navmesh and collision.
+	 * @param InSpacing	Distance between sampled points.
+	 * @return false if world has no navmesh
+	 */
+	bool Bake(UWorld* World, float InSpacing);
+#endif
+};
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterTacticalPointService.generated.h"
+
+class UShooterTacticalPointData;
+
+namespace EShooterTacticalVisibility
+{
+	enum Type
+	{
+		/** don't care */
+		Any,
+		/** point must be visible from enemy */
+		Visible,
+		/** point must be hidden from enemy */
+		Hidden,
+	};
+}
+
+/** what a bot is looking for */
+struct FShooterTacticalQuery
+{
+	/** where bot is */
+	FVector QuerierLocation;
+
+	/** where enemy is */
+	FVector EnemyLocation;
+
+	/** distance range from enemy */
+	float MinEnemyDistance;
+	float MaxEnemyDistance;
+
+	/** EShooterTacticalPoint flags point must have */
+	uint8 RequiredFlags;
+
+	/** visibility from enemy */
+	EShooterTacticalVisibility::Type Visibility;
+
+	/** team of querier, its presence isn't a threat */
+	int32 FriendlyTeam;
+
+	/** cost added per unit of enemy presence and recent danger at point, read from UShooterInfluenceMap */
+	float ThreatCost;
+	float DangerCost;
+
+	FShooterTacticalQuery()
+		: QuerierLocation(FVector::ZeroVector)
+		, EnemyLocation(FVector::ZeroVector)
+		, MinEnemyDistance(0.0f)
+		, MaxEnemyDistance(2000.0f)
+		, RequiredFlags(0)
+		, Visibility(EShooterTacticalVisibility::Any)
+		, FriendlyTeam(INDEX_NONE)
+		, ThreatCost(0.0f)
+		, DangerCost(0.0f)
+	{
+	}
+};
+
+//
+// Runtime access to tactical points baked for the current map. Queries only read baked tables, no traces or pathfinding.
+// Data is loaded from /Game/TacticalPoints/<Map>_TacticalPoints on first use.
+//
+UCLASS()
+class UShooterTacticalPointService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** check if map has baked points */
+	bool HasData();
+
+	/**
+	 * Find point matching query with lowest path cost from querier, plus threat and danger costs when query has them.
+	 *
+	 * @param Query			What to look for.
+	 * @param OutLocation	Found point.
+	 * @return false if nothing matched or map has no data
+	 */
+	bool FindTacticalPoint(const FShooterTacticalQuery& Query, FVector& OutLocation);
+
+	/** get index of closest baked point, INDEX_NONE if none within two grid cells */
+	int32 FindNearestPoint(const FVector& Location);
+
+	/** get baked data, NULL if map has none */
+	UShooterTacticalPointData* GetData();
+
+	/** use given data instead of the baked asset */
+	void SetData(UShooterTacticalPointData* InData);
+
+	/** get package name of tactical data for map */
+	static FString GetDataPackageName(UWorld* World);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** baked data */
+	UPROPERTY(Transient)
+	UShooterTacticalPointData* Data;
+
+	/** tried loading data */
+	bool bLoadAttempted;
+
+	/** point indices per 2D cell */
+	TMap<FIntPoint, TArray<uint16>> Cells;
+
+	/** cell size */
+	float CellSize;
+
+	/** load data and build cells */
+	void LoadData();
+
+	/** get cell coordinates of location */
+	FIntPoint GetCellCoords(const FVector& Location) const;
+};
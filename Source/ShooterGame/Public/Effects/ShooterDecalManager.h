@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterTypes.h"
+#include "ShooterDecalManager.generated.h"
+
+class UDecalComponent;
+
+/** single recycled decal */
+USTRUCT()
+struct FShooterDecalSlot
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** decal component, reattached on every reuse */
+	UPROPERTY(Transient)
+	UDecalComponent* Decal;
+
+	/** time when decal should be hidden, 0 if already hidden */
+	float ExpireTime;
+
+	FShooterDecalSlot()
+		: Decal(NULL)
+		, ExpireTime(0.0f)
+	{
+	}
+};
+
+/** ring buffer of decals sharing a material */
+USTRUCT()
+struct FShooterDecalRing
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** decal slots in allocation order */
+	UPROPERTY(Transient)
+	TArray<FShooterDecalSlot> Slots;
+
+	/** oldest slot, reused when ring is full */
+	int32 Head;
+
+	FShooterDecalRing()
+		: Head(0)
+	{
+	}
+};
+
+//
+// Client side owner of impact and explosion decals - NOT used on dedicated servers
+// Keeps a fixed budget of decal components per material (see UShooterGameUserSettings::GetDecalBudget),
+// overwrites the oldest one on overflow and merges decals landing on top of each other.
+//
+UCLASS()
+class UShooterDecalManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Place decal on surface, recycling an existing component when over budget.
+	 *
+	 * @param Decal			Decal material and lifespan.
+	 * @param DecalSize		Decal extent.
+	 * @param SurfaceHit	Where to place decal.
+	 */
+	void SpawnDecal(const FDecalData& Decal, const FVector& DecalSize, const FHitResult& SurfaceHit);
+
+	/** get number of decals currently visible */
+	int32 GetNumVisibleDecals() const;
+
+	/** get number of decal components owned by manager */
+	int32 GetNumDecalComponents() const;
+
+	/** get number of decals merged into existing ones */
+	int32 GetNumMergedDecals() const;
+
+	// Begin USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** decal rings per material */
+	UPROPERTY(Transient)
+	TMap<UMaterialInterface*, FShooterDecalRing> Rings;
+
+	/** number of decals merged into existing ones */
+	int32 NumMergedDecals;
+
+	/** Handle for efficient management of HideExpiredDecals timer */
+	FTimerHandle TimerHandle_HideExpiredDecals;
+
+	/** hide decals whose lifespan is over */
+	void HideExpiredDecals();
+
+	/** try to refresh a visible decal close enough to new one */
+	bool MergeDecal(FShooterDecalRing& Ring, const FHitResult& SurfaceHit, float ExpireTime) const;
+
+	/** destroy oldest decals until ring fits in budget */
+	void TrimRing(FShooterDecalRing& Ring, int32 Budget) const;
+};
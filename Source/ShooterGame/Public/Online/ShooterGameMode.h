@@ -4,6 +4,7 @@
 
 #include "OnlineIdentityInterface.h"
 #include "ShooterPlayerController.h"
+#include "Online/ShooterGameRules.h"
 #include "ShooterGameMode.generated.h"
 
 class AShooterAIController;
@@ -28,15 +29,21 @@ class AShooterGameMode : public AGameMode
 	/** Initialize the game. This is called before actors' PreInitializeComponents. */
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	/** initialize replicated game data */
+	virtual void InitGameState() override;
+
 	/** Accept or reject a player attempting to join the server.  Fails login if you set the ErrorMessage to a non-empty string. */
 	virtual void PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
 
-	/** starts match warmup */
+	/** puts player on a team in team games and starts match warmup */
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 
 	/** Tries to spawn the player's pawn */
 	virtual void RestartPlayer(AController* NewPlayer) override;
 
+	/** reuse parked pawn from pawn pool if there is one */
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
 	/** select best spawn point for player */
 	virtual AActor* ChoosePlayerStart_Implementation(AController* Player) override;
 
@@ -46,14 +53,23 @@ class AShooterGameMode : public AGameMode
 	/** returns default pawn class for given controller */
 	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
-	/** prevents friendly fire */
-	virtual float ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const;
+	/** scale damage by game rules, prevents friendly fire */
+	float ModifyDamage(float Damage, const AShooterCharacter* DamagedPawn, AController* EventInstigator) const;
 
-	/** notify about kills */
+	/** score and notify about kills */
 	virtual void Killed(AController* Killer, AController* KilledPlayer, APawn* KilledPawn, const UDamageType* DamageType);
 
+	/** get relation of players in game rules */
+	EShooterRuleRelation::Type GetRelation(const AShooterPlayerState* DamageInstigator, const AShooterPlayerState* DamagedPlayer) const;
+
 	/** can players damage each other? */
-	virtual bool CanDealDamage(AShooterPlayerState* DamageInstigator, AShooterPlayerState* DamagedPlayer) const;
+	bool CanDealDamage(const AShooterPlayerState* DamageInstigator, const AShooterPlayerState* DamagedPlayer) const;
+
+	/** are players split into teams? */
+	bool IsTeamGame() const { return Rules.NumTeams > 0; }
+
+	/** get compiled game rules */
+	const FShooterRuleTables& GetRules() const { return Rules; }
 
 	/** always create cheat manager */
 	virtual bool AllowCheats(APlayerController* P) override;
@@ -94,17 +110,19 @@ protected:
 	UPROPERTY(config)
 	int32 TimeBetweenMatches;
 
-	/** score for kill */
+	/** rule set from UShooterGameRules, overridden by ?Rules= URL option */
 	UPROPERTY(config)
-	int32 KillScore;
+	FName RulesName;
 
-	/** score for death */
-	UPROPERTY(config)
-	int32 DeathScore;
+	/** rule set compiled when game is initialized */
+	FShooterRuleTables Rules;
 
-	/** scale for self instigated damage */
-	UPROPERTY(config)
-	float DamageSelfScale;
+	/** best player */
+	UPROPERTY(transient)
+	AShooterPlayerState* WinnerPlayerState;
+
+	/** best team, NumTeams if there's none */
+	int32 WinnerTeam;
 
 	UPROPERTY(config)
 	int32 MaxBots;
@@ -128,6 +146,12 @@ protected:
 	/** initialization for bot after creation */
 	virtual void InitBot(AShooterAIController* AIC, int32 BotNum);
 
+	/** compile rule set into Rules, falls back to defaults if it's not found */
+	void CompileRules(FName Name);
+
+	/** pick team with least players in or random when it's equal */
+	int32 ChooseTeam(AShooterPlayerState* ForPlayerState) const;
+
 	/** check who won */
 	virtual void DetermineMatchWinner();
 
@@ -149,6 +173,9 @@ public:
 	UFUNCTION(exec)
 	void FinishMatch();
 
+	/** [server] reset players, pawns, pickups and timers and go back to warmup, without reloading map */
+	virtual void ResetMatch();
+
 	/*Finishes the match and bumps everyone to main menu.*/
 	/*Only GameInstance should call this function */
 	void RequestFinishAndExitToMainMenu();
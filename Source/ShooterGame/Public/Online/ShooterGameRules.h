@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterGameRules.generated.h"
+
+/** how match winner is picked */
+UENUM()
+enum class EShooterWinCondition : uint8
+{
+	/** nobody wins */
+	None,
+	/** single player with highest score, ties have no winner */
+	BestPlayer,
+	/** every player of single team with highest score, ties have no winner */
+	BestTeam,
+};
+
+/** game mode described by data, one entry of UShooterGameRules */
+USTRUCT()
+struct FShooterGameRuleSet
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** name used by game modes and ?Rules= URL option */
+	UPROPERTY()
+	FName Name;
+
+	/** number of teams, 0 for free for all */
+	UPROPERTY()
+	int32 NumTeams;
+
+	/** score for killing an enemy */
+	UPROPERTY()
+	int32 KillScore;
+
+	/** score for killing a teammate */
+	UPROPERTY()
+	int32 TeamKillScore;
+
+	/** score for being killed */
+	UPROPERTY()
+	int32 DeathScore;
+
+	/** score for killing yourself */
+	UPROPERTY()
+	int32 SuicideScore;
+
+	/** scale for self instigated damage */
+	UPROPERTY()
+	float SelfDamageScale;
+
+	/** scale for damage from teammates, 0 turns friendly fire off */
+	UPROPERTY()
+	float TeamDamageScale;
+
+	/** how match winner is picked */
+	UPROPERTY()
+	EShooterWinCondition WinCondition;
+
+	FShooterGameRuleSet()
+		: NumTeams(0)
+		, KillScore(2)
+		, TeamKillScore(0)
+		, DeathScore(-1)
+		, SuicideScore(-1)
+		, SelfDamageScale(0.3f)
+		, TeamDamageScale(0.0f)
+		, WinCondition(EShooterWinCondition::BestPlayer)
+	{
+	}
+};
+
+/** relation of instigator to victim, index into rule tables */
+namespace EShooterRuleRelation
+{
+	enum Type : uint8
+	{
+		Self,
+		Team,
+		Enemy,
+
+		// number of relations
+		MAX
+	};
+}
+
+/** rule set flattened into lookup tables, consulted on damage and kills */
+struct FShooterRuleTables
+{
+	/** rule set tables were compiled from */
+	FName Name;
+
+	/** number of teams, 0 for free for all */
+	int32 NumTeams;
+
+	/** how match winner is picked */
+	EShooterWinCondition WinCondition;
+
+	/** damage scale by relation, 0 if instigator can't damage victim */
+	float DamageScale[EShooterRuleRelation::MAX];
+
+	/** score of killer and victim by relation */
+	int32 KillerScore[EShooterRuleRelation::MAX];
+	int32 VictimScore[EShooterRuleRelation::MAX];
+
+	FShooterRuleTables()
+	{
+		Compile(FShooterGameRuleSet());
+	}
+
+	/** fill tables from rule set */
+	void Compile(const FShooterGameRuleSet& RuleSet);
+
+	/** get relation of instigator to victim */
+	EShooterRuleRelation::Type GetRelation(bool bSamePlayer, int32 InstigatorTeam, int32 VictimTeam) const
+	{
+		if (bSamePlayer)
+		{
+			return EShooterRuleRelation::Self;
+		}
+		return (NumTeams > 0 && InstigatorTeam == VictimTeam) ? EShooterRuleRelation::Team : EShooterRuleRelation::Enemy;
+	}
+
+	/** print tables */
+	void Dump() const;
+};
+
+//
+// Game mode rule sets from config, game modes pick one by name and compile it into FShooterRuleTables.
+// New modes are added as +RuleSets entries and picked with ?Rules=<Name>, no code needed.
+//
+UCLASS(config=Game)
+class UShooterGameRules : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** get rule set by name, NULL if there's none */
+	static const FShooterGameRuleSet* FindRuleSet(FName Name);
+
+private:
+
+	/** every known rule set */
+	UPROPERTY(config)
+	TArray<FShooterGameRuleSet> RuleSets;
+};
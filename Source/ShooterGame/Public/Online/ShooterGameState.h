@@ -3,11 +3,85 @@
 #pragma once
 
 #include "ShooterOnlineGameMatches.h"
+#include "Engine/NetSerialization.h"
 #include "ShooterGameState.generated.h"
 
 /** ranked PlayerState map, created from the GameState */
 typedef TMap<int32, TWeakObjectPtr<AShooterPlayerState> > RankedPlayerMap; 
 
+/** kill shown in the kill feed */
+USTRUCT()
+struct FShooterKillEvent : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** increasing id, every local player shows each kill once */
+	UPROPERTY()
+	int32 KillId;
+
+	UPROPERTY()
+	AShooterPlayerState* Killer;
+
+	UPROPERTY()
+	AShooterPlayerState* Victim;
+
+	UPROPERTY()
+	UDamageType* DamageType;
+
+	/** killer was set on server, NULL Killer on client means its player state isn't resolved yet */
+	UPROPERTY()
+	uint8 bHasKiller : 1;
+
+	/** victim was set on server, NULL Victim on client means its player state isn't resolved yet */
+	UPROPERTY()
+	uint8 bHasVictim : 1;
+
+	/** [server] world time kill was added */
+	UPROPERTY(NotReplicated)
+	float AddTime;
+
+	FShooterKillEvent()
+		: KillId(0)
+		, Killer(NULL)
+		, Victim(NULL)
+		, DamageType(NULL)
+		, bHasKiller(false)
+		, bHasVictim(false)
+		, AddTime(0.0f)
+	{
+	}
+
+	/** check if every player state set on server is known here */
+	bool IsResolved() const
+	{
+		return (Killer || !bHasKiller) && (Victim || !bHasVictim);
+	}
+};
+
+/** kills of the last ShooterKillFeed.Retention seconds, every kill of a frame goes out in the same update */
+USTRUCT()
+struct FShooterKillFeed : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FShooterKillEvent> Items;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FShooterKillEvent, FShooterKillFeed>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterKillFeed> : public TStructOpsTypeTraitsBase2<FShooterKillFeed>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 UCLASS()
 class AShooterGameState : public AGameState
 {
@@ -31,9 +105,41 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
+	/** check if kills go out through KillFeed instead of per kill RPCs */
+	static bool IsKillFeedBatched();
+
+	/** [server] player was killed, adds it to kill feed when batched */
+	void NotifyKill(AShooterPlayerState* KillerPlayerState, AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType);
+
+	/** get recent kills, not sorted */
+	const TArray<FShooterKillEvent>& GetKillEvents() const { return KillFeed.Items; }
+
+	/** [server] print kill feed updates against per kill RPCs */
+	void DumpKillFeedStats() const;
+
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** get players of team, best score first, ties by player id */
+	const TArray<TWeakObjectPtr<AShooterPlayerState>>& GetRankedPlayers(int32 TeamIndex) const;
+
+	/** get 0 based rank of player within its team, INDEX_NONE if not ranked */
+	int32 GetPlayerRank(const AShooterPlayerState* PlayerState) const;
+
+	/** get counter bumped on every ranking change, UI can skip work while it stays the same */
+	uint32 GetRankingRevision() const { return RankingRevision; }
+
+	/** [both] score, team or presence of player changed, move it to its new place */
+	void UpdatePlayerRank(AShooterPlayerState* PlayerState);
+
+	// Begin AGameStateBase interface
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+	// End AGameStateBase interface
+
+	/** [server] match restarted in place, clear scores and timers */
+	virtual void Reset() override;
+
 	void RequestFinishAndExitToMainMenu();
 
 	virtual void HandleMatchHasStarted() override;
@@ -47,4 +153,28 @@ protected:
 	bool bEnableGameFeedback;
 
 	FShooterOnlineGameMatches GameMatches;
+
+	/** players per team, best first */
+	TArray<TArray<TWeakObjectPtr<AShooterPlayerState>>> RankedPlayers;
+
+	/** ranking changes so far */
+	uint32 RankingRevision;
+
+	/** recent kills */
+	UPROPERTY(Transient, Replicated)
+	FShooterKillFeed KillFeed;
+
+	/** [server] id of next kill */
+	int32 NextKillId;
+
+	/** [server] kill feed stats */
+	int32 NumKills;
+	int32 NumKillFrames;
+	int32 NumKillRPCs;
+	uint64 LastKillFrame;
+
+	FTimerHandle TimerHandle_PruneKillFeed;
+
+	/** [server] remove kills older than retention window */
+	void PruneKillFeed();
 };
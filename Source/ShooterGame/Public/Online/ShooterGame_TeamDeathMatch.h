@@ -4,43 +4,9 @@
 
 #include "ShooterGame_TeamDeathMatch.generated.h"
 
-class AShooterPlayerState;
-class AShooterAIController;
-
+/** "TeamDeathMatch" game rules */
 UCLASS()
 class AShooterGame_TeamDeathMatch : public AShooterGameMode
 {
 	GENERATED_UCLASS_BODY()
-
-	/** setup team changes at player login */
-	void PostLogin(APlayerController* NewPlayer) override;
-
-	/** initialize replicated game data */
-	virtual void InitGameState() override;
-
-	/** can players damage each other? */
-	virtual bool CanDealDamage(AShooterPlayerState* DamageInstigator, AShooterPlayerState* DamagedPlayer) const override;
-
-protected:
-
-	/** number of teams */
-	int32 NumTeams;
-
-	/** best team */
-	int32 WinnerTeam;
-
-	/** pick team with least players in or random when it's equal */
-	int32 ChooseTeam(AShooterPlayerState* ForPlayerState) const;
-
-	/** check who won */
-	virtual void DetermineMatchWinner() override;
-
-	/** check if PlayerState is a winner */
-	virtual bool IsWinner(AShooterPlayerState* PlayerState) const override;
-
-	/** check team constraints */
-	virtual bool IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController* Player) const;
-
-	/** initialization for bot after spawning */
-	virtual void InitBot(AShooterAIController* AIC, int32 BotNum) override;	
 };
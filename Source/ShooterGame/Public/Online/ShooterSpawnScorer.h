@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterSpawnScorer.generated.h"
+
+class UShooterTacticalPointData;
+
+/** per map data of spawn points, built once on game thread and shared with worker */
+struct FShooterSpawnStaticData
+{
+	/** location of every start, same order as UShooterSpawnService::GetAllStarts */
+	TArray<FVector> StartLocations;
+
+	/** tactical points visible from each start, WordsPerRow bits per start, empty without tactical data */
+	TArray<uint32> VisibilityRows;
+	int32 WordsPerRow;
+
+	FShooterSpawnStaticData()
+		: WordsPerRow(0)
+	{
+	}
+
+	/** check if tactical point can be seen from start */
+	bool IsVisible(int32 StartIdx, int32 PointIdx) const
+	{
+		return PointIdx != INDEX_NONE && WordsPerRow > 0 && (VisibilityRows[StartIdx * WordsPerRow + (PointIdx >> 5)] & (1u << (PointIdx & 31))) != 0;
+	}
+};
+
+/** game thread snapshot handed to worker */
+struct FShooterSpawnScoreInput
+{
+	struct FPawnSample
+	{
+		FVector Location;
+		int32 Team;
+		/** nearest tactical point, INDEX_NONE if unknown */
+		int32 PointIdx;
+	};
+
+	struct FKillSample
+	{
+		FVector Location;
+		float Age;
+	};
+
+	TArray<FPawnSample> Pawns;
+	TArray<FKillSample> Kills;
+
+	/** teams to score for, INDEX_NONE scores against everyone */
+	TArray<int32> LayerTeams;
+
+	/** settings */
+	float DangerRadius;
+	float VisibleWeight;
+	float KillRadius;
+	float KillHalfLife;
+
+	/** seed for tie breaking */
+	int32 RandomSeed;
+};
+
+/** published scores, one layer per team */
+struct FShooterSpawnScoreTable
+{
+	/** team of each layer */
+	TArray<int32> LayerTeams;
+
+	/** danger of each start per layer */
+	TArray<TArray<float>> Danger;
+
+	/** start indices per layer, safest first */
+	TArray<TArray<uint16>> RankedStarts;
+
+	/** worker time of last update */
+	double UpdateTime;
+
+	FShooterSpawnScoreTable()
+		: UpdateTime(0.0)
+	{
+	}
+
+	/** score all starts */
+	void Update(const FShooterSpawnStaticData& StaticData, const FShooterSpawnScoreInput& Input);
+};
+
+//
+// Server side danger score of every spawn point from enemy proximity, baked tactical visibility and recent kills.
+// Scored on a worker thread every ShooterSpawnScore.Interval into a back table, swapped with the front table when done.
+//
+UCLASS()
+class UShooterSpawnScorer : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] someone died at location */
+	void AddKill(const FVector& Location);
+
+	/**
+	 * Get starts ordered by danger for a team.
+	 *
+	 * @param FriendlyTeam	Team whose pawns are not a threat, INDEX_NONE when everyone is.
+	 * @return indices into UShooterSpawnService::GetAllStarts, safest first. NULL before first update.
+	 */
+	const TArray<uint16>* GetRankedStarts(int32 FriendlyTeam) const;
+
+	/** print timings and safest starts */
+	void DumpStats() const;
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** table read by game thread */
+	TSharedPtr<FShooterSpawnScoreTable, ESPMode::ThreadSafe> FrontTable;
+
+	/** table written by worker */
+	TSharedPtr<FShooterSpawnScoreTable, ESPMode::ThreadSafe> BackTable;
+
+	/** start locations and visibility */
+	TSharedPtr<const FShooterSpawnStaticData, ESPMode::ThreadSafe> StaticData;
+
+	/** tactical data StaticData was built from */
+	TWeakObjectPtr<UShooterTacticalPointData> StaticDataSource;
+
+	/** running update */
+	TFuture<void> PendingUpdate;
+
+	/** recent kills */
+	TArray<TPair<FVector, float>> Kills;
+
+	/** time since last update was started */
+	float TimeSinceUpdate;
+
+	/** number of tables published */
+	int32 NumUpdates;
+
+	/** total worker time */
+	double TotalUpdateTime;
+
+	/** build start data if missing or tactical data changed */
+	void UpdateStaticData();
+
+	/** gather pawns and kills for worker */
+	void GatherInput(FShooterSpawnScoreInput& Input);
+
+	/** drop kills too old to add danger */
+	void PruneKills(float Now);
+};
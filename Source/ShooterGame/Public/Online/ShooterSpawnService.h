@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterSpawnService.generated.h"
+
+class AShooterTeamStart;
+class APlayerStartPIE;
+
+/** pawn capsule blocking spawn points */
+struct FShooterSpawnOccupant
+{
+	FVector Location;
+	float Radius;
+	float HalfHeight;
+};
+
+/** pawn capsules bucketed by every 2D grid cell they touch */
+struct FShooterSpawnOccupancy
+{
+	/** occupants per cell */
+	TMap<FIntPoint, TArray<FShooterSpawnOccupant>> Cells;
+
+	/** cell size in world units */
+	float CellSize;
+
+	FShooterSpawnOccupancy()
+		: CellSize(400.0f)
+	{
+	}
+
+	/** remove all occupants, keeps cell memory */
+	void Reset(float InCellSize);
+
+	/** add capsule */
+	void Add(const FShooterSpawnOccupant& Occupant);
+
+	/** check if capsule at location would overlap any occupant */
+	bool IsOccupied(const FVector& Location, float Radius, float HalfHeight) const;
+};
+
+//
+// Server side cache of AShooterTeamStart points, split by who may use them, and an occupancy grid of alive pawn capsules.
+// Grid is rebuilt once per frame, pawns spawned during the frame are added right away so mass respawns don't stack up.
+//
+UCLASS()
+class UShooterSpawnService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get starts usable by bots or by players */
+	const TArray<AShooterTeamStart*>& GetStarts(bool bForBots);
+
+	/** get every start, order doesn't change once gathered */
+	const TArray<AShooterTeamStart*>& GetAllStarts();
+
+	/** get "Play from Here" start, NULL outside of PIE */
+	APlayerStartPIE* GetPlayInEditorStart();
+
+	/** check if capsule at location would overlap an alive pawn */
+	bool IsOccupied(const FVector& Location, float Radius, float HalfHeight);
+
+	/** [server] pawn was just spawned, block its start for the rest of the frame */
+	void MarkOccupied(APawn* Pawn);
+
+	/** [server] time choosing starts for a mass respawn, scanning every start and pawn vs using the grid */
+	void RunBenchmark(int32 NumSpawns, int32 NumIterations);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	// End UWorldSubsystem interface
+
+private:
+
+	/** all starts */
+	UPROPERTY(Transient)
+	TArray<AShooterTeamStart*> AllStarts;
+
+	/** starts bots may use */
+	UPROPERTY(Transient)
+	TArray<AShooterTeamStart*> BotStarts;
+
+	/** starts players may use */
+	UPROPERTY(Transient)
+	TArray<AShooterTeamStart*> PlayerStarts;
+
+	/** "Play from Here" start */
+	UPROPERTY(Transient)
+	APlayerStartPIE* PlayInEditorStart;
+
+	/** starts were gathered */
+	bool bStartsCached;
+
+	/** alive pawn capsules */
+	FShooterSpawnOccupancy Occupancy;
+
+	/** frame occupancy was last built */
+	uint64 OccupancyFrame;
+
+	/** gather starts from level if not done yet */
+	void CacheStarts();
+
+	/** rebuild occupancy if not done this frame */
+	void UpdateOccupancy();
+};
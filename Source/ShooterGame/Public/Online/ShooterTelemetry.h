@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Containers/Queue.h"
+#include "Containers/LockFreeList.h"
+#include "Commandlets/Commandlet.h"
+#include "ShooterTelemetry.generated.h"
+
+class IFileHandle;
+
+namespace EShooterTelemetryEvent
+{
+	enum Type : uint8
+	{
+		Kill,
+		Damage,
+		Shot,
+		Pickup,
+		WallRun,
+		Teleport,
+		MatchStart,
+		MatchEnd,
+
+		// number of event types
+		MAX
+	};
+}
+
+/** fixed size event, written to file as is */
+struct FShooterTelemetryEvent
+{
+	/** world time */
+	float Time;
+
+	/** EShooterTelemetryEvent */
+	uint8 Type;
+
+	/** event specific: ammo type for shots, wall side for wall runs */
+	uint8 Detail;
+
+	uint16 Reserved;
+
+	/** player id of instigator, INDEX_NONE if none */
+	int32 PlayerId;
+
+	/** player id of other side (victim), INDEX_NONE if none */
+	int32 OtherId;
+
+	/** event specific: damage dealt, kill distance, distance teleported, players at match start and end */
+	float Value;
+
+	/** where it happened */
+	float X;
+	float Y;
+	float Z;
+};
+static_assert(sizeof(FShooterTelemetryEvent) == 32, "Telemetry event layout is part of the file format, bump ShooterTelemetryVersion when changing it");
+
+/** file header, followed by events until end of file */
+struct FShooterTelemetryHeader
+{
+	/** 'SGTL' */
+	uint32 Magic;
+	uint32 Version;
+
+	/** sizeof(FShooterTelemetryEvent) of writer */
+	uint32 EventSize;
+	uint32 Reserved;
+
+	/** UTC FDateTime ticks when recording started */
+	int64 StartTicks;
+
+	/** map name, null terminated */
+	ANSICHAR MapName[40];
+};
+static_assert(sizeof(FShooterTelemetryHeader) == 64, "Telemetry header layout is part of the file format");
+
+/** block of events, owned by one recording thread until handed to writer */
+struct FShooterTelemetryChunk
+{
+	enum { Capacity = 256 };
+
+	FShooterTelemetryEvent Events[Capacity];
+	int32 Num;
+};
+
+/** recording state of one thread, only touched by that thread after creation */
+struct FShooterTelemetryThreadBuffer
+{
+	/** chunk being filled, NULL until first event */
+	FShooterTelemetryChunk* Chunk;
+
+	/** flush generation chunk was started in */
+	int32 Generation;
+
+	/** events recorded and time spent recording them */
+	uint64 NumEvents;
+	uint64 Cycles;
+
+	FShooterTelemetryThreadBuffer()
+		: Chunk(NULL)
+		, Generation(0)
+		, NumEvents(0)
+		, Cycles(0)
+	{
+	}
+};
+
+//
+// Server side match event log, off unless ShooterTelemetry.Enable is set.
+// Any thread records into its own chunk without locking, full chunks go to a queue that a pool thread
+// appends to Saved/Telemetry/<map>_<time>.sgtl every ShooterTelemetry.FlushInterval.
+// Only the newest ShooterTelemetry.MaxFiles files are kept and each is limited to ShooterTelemetry.MaxFileMB.
+// Recording cost on game thread is measured and checked against ShooterTelemetry.BudgetMs.
+// Files are turned into CSV with the ShooterTelemetry commandlet.
+//
+UCLASS()
+class UShooterTelemetry : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get recorder of world, NULL if it's not recording */
+	static UShooterTelemetry* Get(const UWorld* World);
+
+	/** [server] record event, safe to call from any thread */
+	void Record(EShooterTelemetryEvent::Type Type, uint8 Detail, const APlayerState* Player, const APlayerState* Other, float Value, const FVector& Location);
+
+	/** print event counts, bytes written and recording cost */
+	void DumpStats() const;
+
+	/**
+	 * Convert telemetry file to CSV.
+	 *
+	 * @param InFile	Path of .sgtl file.
+	 * @param OutFile	Path of CSV to write.
+	 * @return false if file couldn't be read or isn't a supported version.
+	 */
+	static bool ConvertToCSV(const FString& InFile, const FString& OutFile);
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	// End UWorldSubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** file is open and events are accepted */
+	bool bRecording;
+
+	/** TLS slot holding FShooterTelemetryThreadBuffer of this recorder */
+	uint32 TlsSlot;
+
+	/** buffers of every thread that recorded */
+	TArray<FShooterTelemetryThreadBuffer*> ThreadBuffers;
+	FCriticalSection ThreadBuffersLock;
+
+	/** buffer of game thread, sealed on every flush */
+	FShooterTelemetryThreadBuffer* GameThreadBuffer;
+
+	/** bumped on flush, chunks started in an older generation are handed to writer on next event */
+	volatile int32 FlushGeneration;
+
+	/** chunks waiting for writer */
+	TQueue<FShooterTelemetryChunk*, EQueueMode::Mpsc> PendingChunks;
+	volatile int32 NumPendingChunks;
+
+	/** written chunks ready for reuse */
+	TLockFreePointerListUnordered<FShooterTelemetryChunk, PLATFORM_CACHE_LINE_SIZE> FreeChunks;
+
+	/** output file, only used by writer */
+	IFileHandle* FileHandle;
+	FString FilePath;
+
+	/** size limit of output file */
+	int64 MaxFileBytes;
+
+	/** running write */
+	TFuture<void> PendingWrite;
+
+	/** time since last flush */
+	float TimeSinceFlush;
+
+	/** writer stats, only touched by writer */
+	int64 BytesWritten;
+	bool bFileFull;
+	int32 NumWrites;
+	double TotalWriteTime;
+
+	/** events thrown away because writer fell behind */
+	FThreadSafeCounter NumDroppedEvents;
+
+	/** game thread cost, recording and flushing */
+	uint64 LastGameThreadCycles;
+	uint64 TotalGameThreadCycles;
+	uint64 WindowGameThreadCycles;
+	int32 TotalFrames;
+	int32 WindowFrames;
+	double MaxFrameMs;
+	bool bOverBudget;
+
+	/** get buffer of calling thread, creates it on first use */
+	FShooterTelemetryThreadBuffer* GetThreadBuffer();
+
+	/** count chunk as pending if writer queue isn't full */
+	bool TryReservePendingChunk();
+
+	/** delete oldest telemetry files past ShooterTelemetry.MaxFiles */
+	void DeleteOldFiles(const FString& Directory) const;
+
+	/** hand chunk of buffer to writer and start a new one */
+	void SealChunk(FShooterTelemetryThreadBuffer* Buffer);
+
+	/** write queued chunks to file */
+	void WritePendingChunks();
+
+	/** start writer on pool thread */
+	void Flush();
+
+	/** check game thread cost of last flush window against budget */
+	void CheckBudget();
+};
+
+/**
+ * Converts telemetry files to CSV.
+ * Usage: ShooterGame -run=ShooterTelemetry -In=<file.sgtl> [-Out=<file.csv>]
+ */
+UCLASS()
+class UShooterTelemetryCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterTelemetryCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
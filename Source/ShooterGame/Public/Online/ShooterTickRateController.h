@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterTickRateController.generated.h"
+
+class UNetDriver;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterServerTickRateChanged, UNetDriver*, int32 /* new rate */);
+
+//
+// Dedicated server NetServerMaxTickRate between ShooterTickRate.Min and ShooterTickRate.Max, on with ShooterTickRate.Adaptive.
+// Every ShooterTickRate.Interval the average game thread time is compared with the frame time of the current rate:
+// above ShooterTickRate.HighLoad of it the rate steps down, below ShooterTickRate.LowLoad of the next rate up it steps up.
+// Client connections past ShooterTickRate.FullRateConnections lower the upper bound towards Min.
+//
+UCLASS()
+class UShooterTickRateController : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** rate of a net driver was changed, replication periods need to be derived again */
+	SHOOTERGAME_API static FOnShooterServerTickRateChanged NotifyServerTickRateChanged;
+
+	/** get current tick rate, 0 before net driver is up */
+	int32 GetTickRate() const { return TickRate; }
+
+	/** get number of rate changes since world started */
+	int32 GetNumRateChanges() const { return NumRateChanges; }
+
+	/** print current rate, bounds and load */
+	void DumpStats() const;
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** NetServerMaxTickRate from config, restored when world goes away */
+	int32 ConfiguredTickRate;
+
+	/** rate currently set on net driver */
+	int32 TickRate;
+
+	/** game thread time and frames since last decision */
+	double WindowGameThreadMs;
+	int32 WindowFrames;
+	float WindowTime;
+
+	/** average game thread time of last window */
+	float LastGameThreadMs;
+
+	/** number of rate changes */
+	int32 NumRateChanges;
+
+	/** get upper bound for number of client connections */
+	int32 GetMaxTickRate(int32 NumConnections) const;
+
+	/** set rate on net driver and let replication know */
+	void SetTickRate(UNetDriver* NetDriver, int32 NewTickRate);
+};
@@ -20,6 +20,9 @@ protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** match restarted in place, become available right away */
+	virtual void Reset() override;
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPickupRegistry.generated.h"
+
+class AShooterPickup;
+
+namespace EShooterPickupKind
+{
+	enum Type
+	{
+		Ammo,
+		Health,
+		Other,
+	};
+}
+
+/** pickups of single kind and weapon type, sorted by X for nearest search */
+USTRUCT()
+struct FShooterPickupGroup
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** kind of pickups */
+	TEnumAsByte<EShooterPickupKind::Type> Kind;
+
+	/** weapon refilled by ammo pickups */
+	UPROPERTY(Transient)
+	UClass* WeaponType;
+
+	/** registry indices, sorted by X location */
+	TArray<int32> Indices;
+
+	/** X location of each entry in Indices */
+	TArray<float> SortedX;
+};
+
+//
+// Server side registry of level pickups, grouped by kind and weapon type. Availability is kept in a bitset updated when pickups
+// are taken and respawned, so bots only look at pickups that can be collected. Pickups don't move, groups are built once.
+//
+UCLASS()
+class UShooterPickupRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] start tracking pickup */
+	void RegisterPickup(AShooterPickup* Pickup, bool bActive);
+
+	/** [server] pickup was taken or respawned */
+	void SetPickupActive(AShooterPickup* Pickup, bool bActive);
+
+	/**
+	 * Find closest available pickup.
+	 *
+	 * @param Kind			Kind of pickup.
+	 * @param WeaponClass	For ammo: weapon class the pickup must refill, NULL for any.
+	 * @param Location		Query location.
+	 * @param Filter		Only pickups passing filter are returned.
+	 * @param Querier		When set and ShooterPickups.UsePathCost is on, closest candidates are ranked by navmesh path cost for this agent.
+	 * @return closest pickup or NULL
+	 */
+	AShooterPickup* FindNearestPickup(EShooterPickupKind::Type Kind, UClass* WeaponClass, const FVector& Location, TFunctionRef<bool(AShooterPickup*)> Filter, APawn* Querier = NULL);
+
+	/** get number of currently available pickups */
+	int32 GetNumActivePickups() const;
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** all registered pickups */
+	UPROPERTY(Transient)
+	TArray<AShooterPickup*> Pickups;
+
+	/** availability of each registered pickup */
+	TBitArray<> ActiveBits;
+
+	/** index of pickup in Pickups */
+	TMap<AShooterPickup*, int32> PickupIndices;
+
+	/** pickups grouped by kind and weapon type */
+	UPROPERTY(Transient)
+	TArray<FShooterPickupGroup> Groups;
+
+	/** cached path costs, keyed by quantized start location and pickup index */
+	TMap<TPair<FIntVector, int32>, float> PathCostCache;
+
+	/** get kind of pickup */
+	static EShooterPickupKind::Type GetPickupKind(const AShooterPickup* Pickup);
+
+	/** get path cost from location to pickup, cached */
+	float GetPathCost(APawn* Querier, const FVector& Location, int32 PickupIndex);
+};
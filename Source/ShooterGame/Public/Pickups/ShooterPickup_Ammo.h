@@ -19,6 +19,9 @@ class AShooterPickup_Ammo : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** get weapon class refilled by this pickup */
+	UClass* GetWeaponType() const { return WeaponType; }
+
 protected:
 
 	/** how much ammo does it give? */
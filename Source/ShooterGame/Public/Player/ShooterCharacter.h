@@ -24,6 +24,9 @@ class AShooterCharacter : public ACharacter
 	/** cleanup inventory */
 	virtual void Destroyed() override;
 
+	/** [server] match restarted in place, park in pawn pool or destroy */
+	virtual void Reset() override;
+
 	/** update mesh for first person view */
 	virtual void PawnClientRestart() override;
 
@@ -439,6 +442,16 @@ public:
 
 	/** Called on the actor right before replication occurs */
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/** [server] death presentation is over, hide and stop simulating until reused */
+	void EnterPool();
+
+	/** [server] bring parked pawn back to life at transform */
+	void LeavePool(const FTransform& SpawnTransform);
+
+	/** check if parked in pawn pool */
+	bool IsInPool() const { return (PoolGeneration & 1) != 0; }
+
 protected:
 	/** notification when killed, for both the server and client. */
 	virtual void OnDeath(float KillingDamage, struct FDamageEvent const& DamageEvent, class APawn* InstigatingPawn, class AActor* DamageCauser);
@@ -456,6 +469,29 @@ protected:
 	UFUNCTION()
 	void OnRep_LastTakeHitInfo();
 
+	/** bumped when entering and leaving pawn pool, odd while parked */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_PoolGeneration)
+	uint8 PoolGeneration;
+
+	/** [server] dead pawn goes to pawn pool instead of being torn off */
+	uint32 bReturnToPool : 1;
+
+	/** Handle for efficient management of ReturnToPool timer */
+	FTimerHandle TimerHandle_ReturnToPool;
+
+	/** [server] hand dead pawn to pawn pool */
+	void ReturnToPool();
+
+	/** [client] pawn was parked or reused */
+	UFUNCTION()
+	void OnRep_PoolGeneration();
+
+	/** undo death: ragdoll, collision, movement and meshes */
+	void ResetForRespawn();
+
+	/** play respawn effects */
+	void PlayRespawnEffects();
+
 	//////////////////////////////////////////////////////////////////////////
 	// Inventory
 
@@ -472,6 +508,9 @@ protected:
 	/** [server] remove all weapons from inventory and destroy them */
 	void DestroyInventory();
 
+	/** [server] refill weapons kept from last life and equip first one */
+	void RestoreInventory();
+
 	/** equip weapon */
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerEquipWeapon(class AShooterWeapon* NewWeapon);
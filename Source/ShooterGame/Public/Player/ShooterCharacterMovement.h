@@ -152,6 +152,9 @@ public:
 	 */
 	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 
+	/** Time spent ticking all movement components, for profiling, always 0 in shipping builds */
+	static double TotalTickTime;
+
 	/** Override TickComponent to use custom ability client side and make a prediction */
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
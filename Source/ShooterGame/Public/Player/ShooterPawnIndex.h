@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPawnIndex.generated.h"
+
+class AShooterCharacter;
+
+/** alive pawns of a single team, bucketed by 2D grid cell */
+USTRUCT()
+struct FShooterPawnIndexTeam
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** pawns per cell */
+	TMap<FIntPoint, TArray<AShooterCharacter*>> Cells;
+
+	/** all pawns of team */
+	UPROPERTY(Transient)
+	TArray<AShooterCharacter*> Pawns;
+};
+
+//
+// Server side spatial index of alive AShooterCharacters, partitioned by team.
+// Rebuilt lazily at most once per frame, serves nearest and radius queries for bot target selection and spawn checks.
+//
+UCLASS()
+class UShooterPawnIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] start tracking pawn */
+	void RegisterPawn(AShooterCharacter* Pawn);
+
+	/** [server] stop tracking pawn */
+	void UnregisterPawn(AShooterCharacter* Pawn);
+
+	/**
+	 * Find pawns closest to location, sorted by distance.
+	 *
+	 * @param Location		Query center.
+	 * @param MaxCount		Max number of pawns to return.
+	 * @param OutPawns		Found pawns, closest first.
+	 * @param Filter		Only pawns passing filter are returned.
+	 * @param ExcludeTeam	Team partition to skip, INDEX_NONE to search all teams.
+	 */
+	void FindNearestPawns(const FVector& Location, int32 MaxCount, TArray<AShooterCharacter*>& OutPawns, TFunctionRef<bool(AShooterCharacter*)> Filter, int32 ExcludeTeam = INDEX_NONE);
+
+	/**
+	 * Find pawns within radius of location, unsorted.
+	 *
+	 * @param Location		Query center.
+	 * @param Radius		Max distance from location.
+	 * @param OutPawns		Found pawns.
+	 * @param ExcludeTeam	Team partition to skip, INDEX_NONE to search all teams.
+	 */
+	void FindPawnsInRadius(const FVector& Location, float Radius, TArray<AShooterCharacter*>& OutPawns, int32 ExcludeTeam = INDEX_NONE);
+
+	/** get largest capsule radius of indexed pawns */
+	float GetMaxPawnRadius();
+
+	/** get number of indexed pawns */
+	int32 GetNumPawns();
+
+	/** get all indexed pawns */
+	void GetAlivePawns(TArray<AShooterCharacter*>& OutPawns);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** tracked pawns, alive or not */
+	UPROPERTY(Transient)
+	TArray<AShooterCharacter*> RegisteredPawns;
+
+	/** alive pawns per team */
+	UPROPERTY(Transient)
+	TMap<int32, FShooterPawnIndexTeam> Teams;
+
+	/** occupied cell range, limits nearest search */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	/** largest capsule radius */
+	float MaxPawnRadius;
+
+	/** frame index was last built */
+	uint64 BuiltFrame;
+
+	/** rebuild index from current pawn locations if not done this frame */
+	void UpdateIndex();
+
+	/** get cell coordinates of location */
+	FIntPoint GetCellCoords(const FVector& Location) const;
+};
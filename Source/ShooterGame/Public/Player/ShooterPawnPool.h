@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPawnPool.generated.h"
+
+class AShooterCharacter;
+
+//
+// Server side pool of dead AShooterCharacters, opt-in with ShooterPawnPool.Enable.
+// Dying pawns keep their channel instead of being torn off, and are parked here hidden once the death presentation is over.
+// Respawns reuse a parked pawn of the same class together with its weapons, so no actors are spawned or destroyed.
+//
+UCLASS()
+class UShooterPawnPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** check if dying pawns should be parked for reuse */
+	static bool IsEnabled(const UWorld* World);
+
+	/** get time dead pawn stays visible before it's parked */
+	static float GetCorpseTime();
+
+	/** [server] take parked pawn of class and move it to transform, NULL if there is none */
+	AShooterCharacter* Acquire(UClass* PawnClass, const FTransform& SpawnTransform);
+
+	/** [server] park dead pawn, destroys it when pool is full */
+	void Release(AShooterCharacter* Pawn);
+
+	/** [server] player was restarted, time includes pawn spawn or reuse */
+	void RecordRespawn(double Seconds);
+
+	/** [server] inventory was spawned or refilled after respawn */
+	void RecordInventory(double Seconds);
+
+	/** print respawn cost and garbage collections */
+	void DumpStats() const;
+
+	/** get number of respawns recorded */
+	int32 GetNumRespawns() const { return NumRespawns; }
+
+	/** get number of respawns that reused a parked pawn */
+	int32 GetNumReused() const { return NumReused; }
+
+	/** get total pawn and inventory time of recorded respawns */
+	double GetTotalRespawnTime() const { return TotalRespawnTime; }
+
+	/** get number of garbage collections since world started */
+	int32 GetNumGarbageCollections() const { return NumGarbageCollections; }
+
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** parked pawns */
+	UPROPERTY(Transient)
+	TArray<AShooterCharacter*> PooledPawns;
+
+	/** respawn stats */
+	int32 NumRespawns;
+	int32 NumReused;
+	double TotalRespawnTime;
+	double MaxRespawnTime;
+
+	/** garbage collections seen */
+	int32 NumGarbageCollections;
+
+	/** time subsystem was created */
+	double StartTime;
+
+	FDelegateHandle OnPostGarbageCollectHandle;
+
+	/** count garbage collection */
+	void OnPostGarbageCollect();
+};
@@ -33,6 +33,9 @@ public:
 	/** notify player about finished match */
 	virtual void ClientGameEnded_Implementation(class AActor* EndGameFocus, bool bIsWinner);
 
+	/** match was restarted in place, back to warmup */
+	virtual void ClientReset_Implementation() override;
+
 	/** Notifies clients to send the end-of-round event */
 	UFUNCTION(reliable, client)
 	void ClientSendRoundEndEvent(bool bIsWinner, int32 ExpendedTimeInSeconds);
@@ -184,6 +187,9 @@ public:
 	/** Informs that player fragged someone */
 	void OnKill();
 
+	/** show kills added to game state kill feed since last call, all in one pass */
+	void UpdateKillFeed();
+
 	/** Cleans up any resources necessary to return to main menu.  Does not modify GameInstance state. */
 	virtual void HandleReturnToMainMenu();
 
@@ -224,6 +230,15 @@ protected:
 	/** stores pawn location at last player death, used where player scores a kill after they died **/
 	FVector LastDeathLocation;
 
+	/** id of last kill feed entry shown */
+	int32 LastKillId;
+
+	/** game state LastKillId belongs to, ids start over with every new one */
+	TWeakObjectPtr<const class AShooterGameState> KillFeedGameState;
+
+	/** update hero stat if this player is the one who died */
+	void UpdateDeathStat(class AShooterPlayerState* KilledPlayerState);
+
 	/** shooter in-game menu */
 	TSharedPtr<class FShooterIngameMenu> ShooterIngameMenu;
 
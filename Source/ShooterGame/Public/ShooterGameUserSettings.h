@@ -24,6 +24,12 @@ class UShooterGameUserSettings : public UGameUserSettings
 		GraphicsQuality = InGraphicsQuality;
 	}
 
+	/** get max number of decals per material for current graphics quality */
+	int32 GetDecalBudget() const
+	{
+		return GraphicsQuality == 0 ? DecalBudgetLow : DecalBudgetHigh;
+	}
+
 	int32 GetNVIDIAReflex() const
 	{
 		return NVIDIAReflex;
@@ -126,6 +132,14 @@ private:
 	UPROPERTY(config)
 	int32 GraphicsQuality;
 
+	/** Max decals per material on low graphics quality */
+	UPROPERTY(config)
+	int32 DecalBudgetLow;
+
+	/** Max decals per material on high graphics quality */
+	UPROPERTY(config)
+	int32 DecalBudgetHigh;
+
 	/** NVIDIA Reflex */
 	UPROPERTY(config)
 	int32 NVIDIAReflex;
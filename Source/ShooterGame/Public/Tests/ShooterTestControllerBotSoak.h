@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "GauntletTestController.h"
+#include "ShooterTestControllerBotSoak.generated.h"
+
+/** marks start or end of physics tick groups */
+struct FShooterSoakPhysicsMarker : public FTickFunction
+{
+	/** time marker last ran */
+	double LastTime;
+
+	FShooterSoakPhysicsMarker()
+		: LastTime(0.0)
+	{
+	}
+
+	// Begin FTickFunction interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	// End FTickFunction interface
+};
+
+/** game thread time of one server frame */
+struct FShooterSoakFrame
+{
+	float Time;
+	float GameThreadMs;
+	float AIMs;
+	float MovementMs;
+	float ReplicationMs;
+	float PhysicsMs;
+	float UsedMemoryMB;
+	int32 NumBots;
+	int32 TickRate;
+};
+
+/**
+ * Runs a bot only match on the server for -SoakMinutes= of match time with -SoakBots= bots and writes per frame times to -SoakCSV=.
+ * Fails if 95th percentile game thread time is above -SoakMaxFrameMs= or peak memory is above -SoakMaxMemoryMB=.
+ * -SoakPawnPool reuses dead pawns, respawn cost and garbage collections are reported either way.
+ * On a dedicated server the adaptive tick rate is recorded too, fails if it changes more than -SoakMaxTickRateChanges= times per minute.
+ * -SoakReplay records a replay of the match and reports LastTakeHitInfo update sizes, add -networkprofiler=true for a full profile.
+ */
+UCLASS()
+class UShooterTestControllerBotSoak : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override {}
+	virtual void BeginDestroy() override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** settings from command line */
+	int32 NumBots;
+	float SoakTime;
+	float MaxFrameMs;
+	float MaxMemoryMB;
+	float MaxTickRateChanges;
+	FString CSVFilename;
+	bool bRecordReplay;
+
+	/** replay recording was started */
+	bool bReplayStarted;
+
+	/** match time sampled so far */
+	float ElapsedSoakTime;
+
+	/** recorded frames */
+	TArray<FShooterSoakFrame> Frames;
+
+	/** bots with a pawn */
+	int32 NumSpawnedBots;
+
+	/** largest used memory seen */
+	float PeakMemoryMB;
+
+	/** counters at start of current frame */
+	double FrameStartTreeTime;
+	double FrameStartMovementTime;
+
+	/** replication window of current frame */
+	double PostActorTickTime;
+	double ReplicationTime;
+
+	/** frame is being sampled */
+	bool bSampling;
+
+	/** results were reported */
+	bool bFinished;
+
+	/** world physics markers are registered in */
+	TWeakObjectPtr<UWorld> MarkerWorld;
+	FShooterSoakPhysicsMarker StartPhysicsMarker;
+	FShooterSoakPhysicsMarker EndPhysicsMarker;
+
+	FDelegateHandle OnWorldTickStartHandle;
+	FDelegateHandle OnWorldPostActorTickHandle;
+	FDelegateHandle OnPostTickFlushHandle;
+
+	/** create bot controllers and spawn them if match is running */
+	void UpdateBots(UWorld* World);
+
+	/** hook frame timing into world */
+	void BindWorld(UWorld* World);
+
+	/** finish sample of previous frame and start a new one */
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnPostTickFlush();
+
+	/** write csv, check thresholds and end test */
+	void FinishSoak();
+};
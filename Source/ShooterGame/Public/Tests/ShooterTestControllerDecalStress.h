@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "ShooterTestControllerBase.h"
+#include "ShooterTestControllerDecalStress.generated.h"
+
+class AShooterPlayerController;
+
+/** hosts a game, fires into the nearest wall with infinite ammo and checks decal count stays within budget */
+UCLASS()
+class UShooterTestControllerDecalStress : public UShooterTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override {}
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** turn player towards closest wall and start shooting */
+	void StartFiring(AShooterPlayerController* PC);
+
+	/** log decal count and frame time for last sample window */
+	void ReportSample();
+
+	uint8 bIsFiring : 1;
+
+	/** how long to keep firing, in seconds */
+	float StressDuration;
+
+	float FiringTime;
+	float SampleTime;
+	float SampleFrameTime;
+	int32 SampleFrames;
+	int32 MaxVisibleDecals;
+};
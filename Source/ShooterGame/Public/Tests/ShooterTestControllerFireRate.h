@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "ShooterTestControllerBase.h"
+#include "ShooterTestControllerFireRate.generated.h"
+
+class AShooterPlayerController;
+
+/** hosts a game, holds the trigger of the player's weapon with fixed 20, 60 and 240 Hz frames and checks each fires at the weapon's rate */
+UCLASS()
+class UShooterTestControllerFireRate : public UShooterTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override {}
+	virtual void BeginDestroy() override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** index of tick rate being tested */
+	int32 RateIdx;
+
+	/** frames run with trigger held at current rate, INDEX_NONE between rates */
+	int32 NumFiringFrames;
+
+	/** time since trigger was released */
+	float IdleTime;
+
+	/** shots of player when trigger was pulled */
+	int32 StartShots;
+
+	/** no rate failed so far */
+	bool bPassed;
+
+	/** shots fired by player so far */
+	int32 GetNumShotsFired(const AShooterPlayerController* PC) const;
+};
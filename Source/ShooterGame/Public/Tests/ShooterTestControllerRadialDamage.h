@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "ShooterTestControllerBase.h"
+#include "ShooterTestControllerRadialDamage.generated.h"
+
+class AShooterCharacter;
+
+/** hosts a game and checks explosions through the damage grid hurt a character inside the radius and leave one outside alone */
+UCLASS()
+class UShooterTestControllerRadialDamage : public UShooterTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnPostMapChange(UWorld* World) override {}
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** damage dealt to pawn by an explosion at offset from its location */
+	float ExplodeAt(AShooterCharacter* Pawn, const FVector& Offset, float Radius) const;
+};
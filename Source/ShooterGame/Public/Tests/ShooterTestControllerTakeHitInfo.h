@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "ShooterTestControllerBase.h"
+#include "UObject/CoreNet.h"
+#include "ShooterTestControllerTakeHitInfo.generated.h"
+
+class AShooterCharacter;
+struct FTakeHitInfo;
+
+/** package map writing objects as indices into a local table, so structs can be net serialized without a connection */
+UCLASS(Transient)
+class UShooterTestPackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = NULL) override;
+
+private:
+	/** objects written so far, index 0 is NULL */
+	UPROPERTY()
+	TArray<UObject*> Objects;
+};
+
+/** hosts a game and checks every LastTakeHitInfo field clients read survives net serialization */
+UCLASS()
+class UShooterTestControllerTakeHitInfo : public UShooterTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnPostMapChange(UWorld* World) override {}
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** write hit info and read it back into a fresh struct, false if any field clients use differs */
+	bool RoundTrip(const TCHAR* Name, FTakeHitInfo& Sent, AActor* HitActor) const;
+};
@@ -120,6 +120,9 @@ public:
 	 */
 	void ShowDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType);
 
+	/** add death messages of kill feed entries, oldest first */
+	void ShowDeathMessages(const TArray<const struct FShooterKillEvent*>& Kills);
+
 	/*
 	 * Toggle chat window visibility.
 	 *
@@ -344,6 +347,9 @@ protected:
 	/** Draw death messages. */
 	void DrawDeathMessages();
 
+	/** add death message without trimming the list */
+	void AddDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* MyPlayerState);
+
 	/** Draw NVIDIA reflex timers */
 	void DrawNVIDIAReflexTimers();
 
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterDamageGrid.generated.h"
+
+/** damageable actors overlapping a single grid cell */
+USTRUCT()
+struct FShooterDamageGridCell
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(Transient)
+	TArray<AActor*> Actors;
+};
+
+//
+// Server side spatial hash of damageable actors, used by explosions instead of a generic physics overlap.
+// Actors register themselves, the hash is rebuilt lazily at most once per frame when an explosion queries it.
+//
+UCLASS()
+class UShooterDamageGrid : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** [server] start tracking actor for radial damage */
+	void RegisterActor(AActor* Actor);
+
+	/** [server] stop tracking actor */
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * [server] damage all registered actors within radius, same falloff and FRadialDamageEvent as UGameplayStatics::ApplyRadialDamage
+	 *
+	 * @param BaseDamage		Damage at origin.
+	 * @param Origin			Center of explosion.
+	 * @param DamageRadius		Damage falls off linearly to 0 at this distance.
+	 * @param DamageTypeClass	Damage type.
+	 * @param DamageCauser		Actor that caused the damage, never damaged itself.
+	 * @param InstigatedBy		Controller responsible for the damage.
+	 * @return true if any actor was damaged
+	 */
+	bool ApplyRadialDamage(float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, AActor* DamageCauser, AController* InstigatedBy);
+
+	/** collect registered actors whose bounds may be within radius */
+	void GatherActorsInRadius(const FVector& Origin, float Radius, TArray<AActor*>& OutActors);
+
+	/** record time spent applying radial damage */
+	void AddDamageSample(bool bUsedGrid, double Seconds);
+
+	/** [server] time NumExplosions zero damage explosions around tracked actors with grid and generic path */
+	void RunBenchmark(int32 NumExplosions, float DamageRadius);
+
+	/** print timings of grid and generic radial damage */
+	void DumpStats() const;
+
+	/** reset counters */
+	void ResetStats();
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** tracked actors */
+	UPROPERTY(Transient)
+	TArray<AActor*> DamageableActors;
+
+	/** actors per cell */
+	UPROPERTY(Transient)
+	TMap<FIntVector, FShooterDamageGridCell> Cells;
+
+	/** frame the cells were last built */
+	uint64 BuiltFrame;
+
+	/** number of explosions using the grid */
+	int32 NumGridExplosions;
+
+	/** number of explosions using UGameplayStatics */
+	int32 NumGenericExplosions;
+
+	/** number of visibility traces done by the grid */
+	int32 NumGridTraces;
+
+	/** total time spent in grid path */
+	double TotalGridTime;
+
+	/** total time spent in generic path */
+	double TotalGenericTime;
+
+	/** grid path of ApplyRadialDamage */
+	bool ApplyRadialDamageFromGrid(float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, AActor* DamageCauser, AController* InstigatedBy);
+
+	/** rebuild cells from current actor bounds if not done this frame */
+	void UpdateCells();
+
+	/** get cell coordinates of location */
+	FIntVector GetCellCoords(const FVector& Location) const;
+};
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "ShooterDamageTypeRegistry.generated.h"
+
+//
+// Damage types known to both server and clients, replicated as index into DamageTypes instead of an object reference.
+// List comes from config and has to be the same on server and clients, new types are appended.
+//
+UCLASS(config=Game)
+class UShooterDamageTypeRegistry : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** get index of damage type, INDEX_NONE if it's not registered */
+	static int32 GetIndex(const UClass* DamageTypeClass);
+
+	/** get damage type at index, NULL if it's out of range or failed to load */
+	static UClass* GetDamageType(int32 Index);
+
+	/** get number of registered damage types */
+	static int32 Num();
+
+private:
+
+	/** damage types in index order */
+	UPROPERTY(config)
+	TArray<FSoftClassPath> DamageTypes;
+
+	/** loaded DamageTypes, same order, NULL for entries that failed to load */
+	UPROPERTY(Transient)
+	TArray<UClass*> LoadedDamageTypes;
+
+	/** index of every loaded damage type */
+	TMap<const UClass*, int32> DamageTypeIndices;
+
+	/** DamageTypes were loaded */
+	bool bLoaded;
+
+	/** get registry with damage types loaded */
+	static UShooterDamageTypeRegistry* Get();
+};
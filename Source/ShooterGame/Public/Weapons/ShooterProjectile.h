@@ -25,6 +25,18 @@ class AShooterProjectile : public AActor
 	UFUNCTION()
 	void OnImpact(const FHitResult& HitResult);
 
+	/** [server] reinitialize for another shot after being taken from the pool */
+	void ActivateFromPool();
+
+	/** [server] hide, stop and go dormant until taken from the pool again */
+	void DeactivateToPool();
+
+	/** max number of inactive projectiles of this class kept for reuse */
+	int32 GetPoolSize() const;
+
+	/** match restarted in place, expire now */
+	virtual void Reset() override;
+
 private:
 	/** movement component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Projectile)
@@ -45,17 +57,42 @@ protected:
 	/** controller that fired me (cache for damage calculations) */
 	TWeakObjectPtr<AController> MyController;
 
-	/** projectile data */
-	struct FProjectileWeaponData WeaponConfig;
+	/** projectile data, owned by firing weapon's tuning asset or class defaults */
+	const struct FProjectileWeaponData* WeaponConfig;
+
+	/** keeps WeaponConfig alive */
+	UPROPERTY(Transient)
+	UObject* WeaponConfigOwner;
+
+	/** max number of inactive projectiles of this class kept in UShooterProjectilePool */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	int32 PoolSize;
 
 	/** did it explode? */
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_Exploded)
 	bool bExploded;
 
+	/** incremented every time projectile is taken from the pool, lets clients reset their state */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_PoolGeneration)
+	uint8 PoolGeneration;
+
+	/** [server] should go back to the pool instead of being destroyed */
+	uint8 bReturnToPool : 1;
+
 	/** [client] explosion happened */
 	UFUNCTION()
 	void OnRep_Exploded();
 
+	/** [client] projectile was reused */
+	UFUNCTION()
+	void OnRep_PoolGeneration();
+
+	/** read config from owner weapon and setup lifespan */
+	void InitFromOwner();
+
+	/** [all] restore movement and effects stopped by explosion */
+	void ResetSimulation();
+
 	/** trigger explosion */
 	void Explode(const FHitResult& Impact);
 
@@ -65,6 +102,11 @@ protected:
 	/** update velocity on client */
 	virtual void PostNetReceiveVelocity(const FVector& NewVelocity) override;
 
+	/** [server] return to pool when possible */
+	virtual void LifeSpanExpired() override;
+
+	friend class UShooterProjectilePool;
+
 protected:
 	/** Returns MovementComp subobject **/
 	FORCEINLINE UProjectileMovementComponent* GetMovementComp() const { return MovementComp; }
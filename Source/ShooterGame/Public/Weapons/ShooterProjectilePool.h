@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterProjectilePool.generated.h"
+
+class AShooterProjectile;
+
+/** inactive projectiles of a single class, waiting to be fired again */
+USTRUCT()
+struct FShooterProjectilePoolEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** hidden, dormant projectiles ready for reuse */
+	UPROPERTY(Transient)
+	TArray<AShooterProjectile*> Inactive;
+};
+
+//
+// Server side pool of projectile actors. Instead of destroying a projectile once it exploded or timed out,
+// it is hidden, made dormant and handed out again on the next shot, avoiding actor spawn and channel churn.
+//
+UCLASS()
+class UShooterProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * [server] get a projectile ready to fly, reusing a pooled one when possible
+	 *
+	 * @param ProjectileClass	Class of projectile to fire.
+	 * @param SpawnTM			Initial transform.
+	 * @param ShootDir			Direction to launch projectile in.
+	 * @param OwnerWeapon		Weapon firing the projectile, provides WeaponConfig.
+	 * @param InInstigator		Pawn firing the projectile.
+	 */
+	AShooterProjectile* AcquireProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTM, FVector ShootDir, AActor* OwnerWeapon, APawn* InInstigator);
+
+	/** [server] return projectile to the pool, false if pool is full and projectile should be destroyed instead */
+	bool ReleaseProjectile(AShooterProjectile* Projectile);
+
+	/** print reuse rate and spawn time saved */
+	void DumpStats() const;
+
+	/** reset counters */
+	void ResetStats();
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+private:
+
+	/** pooled projectiles per class */
+	UPROPERTY(Transient)
+	TMap<UClass*, FShooterProjectilePoolEntry> Pools;
+
+	/** number of projectiles handed out */
+	int32 NumAcquired;
+
+	/** number of projectiles handed out from the pool */
+	int32 NumReused;
+
+	/** number of projectiles that had to be destroyed because pool was full */
+	int32 NumOverflowed;
+
+	/** total time spent spawning new projectiles */
+	double TotalSpawnTime;
+
+	/** total time spent reinitializing pooled projectiles */
+	double TotalReuseTime;
+};
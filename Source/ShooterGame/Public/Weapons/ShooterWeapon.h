@@ -71,6 +71,61 @@ struct FWeaponData
 	}
 };
 
+/** fixed step refire clock, turns elapsed time into the number of shots due */
+struct FShooterFireAccumulator
+{
+	/** time accumulated towards next shot */
+	float Accumulated;
+
+	FShooterFireAccumulator()
+		: Accumulated(0.0f)
+	{
+	}
+
+	void Reset()
+	{
+		Accumulated = 0.0f;
+	}
+
+	/**
+	 * Advance clock and consume shots that became due.
+	 *
+	 * @param DeltaTime			Time since last advance.
+	 * @param TimeBetweenShots	Refire interval.
+	 * @param MaxShots			Max shots to return, leftover time is dropped past one interval.
+	 * @param bCatchup			Carry time past the interval over to the next shot, otherwise each shot restarts the clock.
+	 * @return number of shots due
+	 */
+	int32 Advance(float DeltaTime, float TimeBetweenShots, int32 MaxShots, bool bCatchup)
+	{
+		if (TimeBetweenShots <= 0.0f)
+		{
+			return 0;
+		}
+
+		Accumulated += DeltaTime;
+
+		int32 NumShots = 0;
+		while (Accumulated >= TimeBetweenShots && NumShots < MaxShots)
+		{
+			Accumulated -= TimeBetweenShots;
+			NumShots++;
+		}
+
+		if (NumShots > 0 && !bCatchup)
+		{
+			Accumulated = 0.0f;
+		}
+		else if (NumShots >= MaxShots)
+		{
+			// hitch, don't owe more than a single shot
+			Accumulated = FMath::Min(Accumulated, TimeBetweenShots);
+		}
+
+		return NumShots;
+	}
+};
+
 USTRUCT()
 struct FWeaponAnim
 {
@@ -92,7 +147,7 @@ struct FWeaponAnim
 };
 
 UCLASS(Abstract, Blueprintable)
-class AShooterWeapon : public AActor
+class SHOOTERGAME_API AShooterWeapon : public AActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -101,6 +156,9 @@ class AShooterWeapon : public AActor
 
 	virtual void Destroyed() override;
 
+	/** advance refire clock */
+	virtual void Tick(float DeltaSeconds) override;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Ammo
 	
@@ -114,6 +172,9 @@ class AShooterWeapon : public AActor
 	/** [server] add ammo */
 	void GiveAmmo(int AddAmount);
 
+	/** [server] back to ammo weapon was spawned with */
+	void ResetAmmo();
+
 	/** consume a bullet */
 	void UseAmmo();
 
@@ -199,6 +260,23 @@ class AShooterWeapon : public AActor
 	/** get max ammo amount */
 	int32 GetMaxAmmo() const;
 
+	/** get speed of fired shots, 0 for instant hit */
+	virtual float GetShotSpeed() const { return 0.0f; }
+
+	/** get distance a shot can reach */
+	virtual float GetShotRange() const { return WORLD_MAX; }
+
+	/** get weapon data, shared by all instances */
+	const FWeaponData& GetWeaponConfig() const;
+
+	/** get shared tuning asset, NULL if weapon uses its class defaults */
+	class UShooterWeaponConfig* GetTuningConfig() const;
+
+#if WITH_EDITOR
+	/** [editor] copy class config structs into new tuning asset and reference it */
+	virtual void MigrateToTuningConfig(class UShooterWeaponConfig* NewConfig);
+#endif
+
 	/** get weapon mesh (needs pawn owner to determine variant) */
 	USkeletalMeshComponent* GetWeaponMesh() const;
 
@@ -258,14 +336,17 @@ class AShooterWeapon : public AActor
 	UPROPERTY(EditDefaultsOnly, Category=HUD)
 	bool bHideCrosshairWhileNotAiming;
 
-	/** Adjustment to handle frame rate affecting actual timer interval. */
-	UPROPERTY(Transient)
-	float TimerIntervalAdjustment;
-
 	/** Whether to allow automatic weapons to catch up with shorter refire cycles */
 	UPROPERTY(Config)
 	bool bAllowAutomaticWeaponCatchup = true;
 
+	/** Max shots fired in a single frame when catching up after a hitch */
+	UPROPERTY(Config)
+	int32 MaxShotsPerFrame = 4;
+
+	/** most shots a single ServerHandleFiring may carry, independent of config so client and server always agree */
+	enum { MaxShotsPerServerRequest = 16 };
+
 	/** check if weapon has infinite ammo (include owner's cheats) */
 	bool HasInfiniteAmmo() const;
 
@@ -287,7 +368,11 @@ protected:
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_MyPawn)
 	class AShooterCharacter* MyPawn;
 
-	/** weapon data */
+	/** shared tuning, holds all weapon data */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	class UShooterWeaponConfig* TuningConfig;
+
+	/** weapon data, only read from class defaults when TuningConfig is not set, ShooterWeaponConfigMigrate moves it to an asset */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FWeaponData WeaponConfig;
 
@@ -396,6 +481,21 @@ protected:
 	/** weapon is refiring */
 	uint32 bRefiring;
 
+	/** refire clock is running, shots are fired from Tick */
+	uint32 bFireClockRunning;
+
+	/** shots fired from Tick are reported to server in one call */
+	uint32 bBatchingShots;
+
+	/** fixed step refire clock */
+	FShooterFireAccumulator FireAccumulator;
+
+	/** frame refire clock was started, it's not advanced until next frame */
+	uint64 FireClockStartFrame;
+
+	/** shots fired locally, waiting to be sent to server */
+	int32 PendingServerShots;
+
 	/** current weapon state */
 	EWeaponState::Type CurrentState;
 
@@ -429,9 +529,6 @@ protected:
 	/** Handle for efficient management of ReloadWeapon timer */
 	FTimerHandle TimerHandle_ReloadWeapon;
 
-	/** Handle for efficient management of HandleFiring timer */
-	FTimerHandle TimerHandle_HandleFiring;
-
 	//////////////////////////////////////////////////////////////////////////
 	// Input - server side
 
@@ -473,12 +570,15 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() PURE_VIRTUAL(AShooterWeapon::FireWeapon,);
 
-	/** [server] fire & update ammo */
+	/** [server] fire & update ammo for NumShots shots */
 	UFUNCTION(reliable, server, WithValidation)
-	void ServerHandleFiring();
+	void ServerHandleFiring(uint8 NumShots);
+
+	/** [local] fire shots due on refire clock */
+	void HandleReFiring(float DeltaSeconds);
 
-	/** [local + server] handle weapon refire, compensating for slack time if the timer can't sample fast enough */
-	void HandleReFiring();
+	/** [local + server] start refire clock, first step is due after ElapsedTime */
+	void StartFireClock(float ElapsedTime);
 
 	/** [local + server] handle weapon fire */
 	void HandleFiring();
@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "Weapons/ShooterWeapon_Instant.h"
+#include "Weapons/ShooterWeapon_Projectile.h"
+#include "ShooterWeaponConfig.generated.h"
+
+//
+// Weapon tuning shared by every weapon and projectile referencing it.
+// Loaded once through the asset manager (primary asset type "WeaponConfig"), weapons keep only this pointer and ammo counters per instance.
+//
+UCLASS()
+class SHOOTERGAME_API UShooterWeaponConfig : public UPrimaryDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+	/** primary asset type of weapon configs */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/** weapon data */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	FWeaponData WeaponConfig;
+
+	/** instant hit data, used by AShooterWeapon_Instant */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	FInstantWeaponData InstantConfig;
+
+	/** projectile data, used by AShooterWeapon_Projectile and its projectiles */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	FProjectileWeaponData ProjectileConfig;
+
+	/**
+	 * Change single tuning value on a live config, every weapon using it picks it up immediately.
+	 *
+	 * @param PropertyPath	Struct and field, e.g. "InstantConfig.HitDamage".
+	 * @param Value			New value in text form.
+	 * @return false if property wasn't found or value couldn't be parsed
+	 */
+	bool SetTuningValue(const FString& PropertyPath, const FString& Value);
+
+	// Begin UObject interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	// End UObject interface
+};
@@ -94,6 +94,15 @@ class AShooterWeapon_Instant : public AShooterWeapon
 	/** get current spread */
 	float GetCurrentSpread() const;
 
+	/** get instant hit data, shared by all instances */
+	const FInstantWeaponData& GetInstantConfig() const;
+
+	virtual float GetShotRange() const override;
+
+#if WITH_EDITOR
+	virtual void MigrateToTuningConfig(class UShooterWeaponConfig* NewConfig) override;
+#endif
+
 protected:
 
 	virtual EAmmoType GetAmmoType() const override
@@ -101,7 +110,7 @@ protected:
 		return EAmmoType::EBullet;
 	}
 
-	/** weapon config */
+	/** weapon config, only read from class defaults when TuningConfig is not set */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FInstantWeaponData InstantConfig;
 
@@ -48,8 +48,18 @@ class AShooterWeapon_Projectile : public AShooterWeapon
 {
 	GENERATED_UCLASS_BODY()
 
-	/** apply config on projectile */
-	void ApplyWeaponConfig(FProjectileWeaponData& Data);
+	/** get projectile data, shared by all instances and their projectiles */
+	const FProjectileWeaponData& GetProjectileConfig() const;
+
+	/** get object owning projectile data: tuning asset or class defaults */
+	UObject* GetProjectileConfigOwner() const;
+
+	virtual float GetShotSpeed() const override;
+	virtual float GetShotRange() const override;
+
+#if WITH_EDITOR
+	virtual void MigrateToTuningConfig(class UShooterWeaponConfig* NewConfig) override;
+#endif
 
 protected:
 
@@ -58,7 +68,7 @@ protected:
 		return EAmmoType::ERocket;
 	}
 
-	/** weapon config */
+	/** weapon config, only read from class defaults when TuningConfig is not set */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FProjectileWeaponData ProjectileConfig;
 
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterWeaponConfigMigrateCommandlet.h"
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeapon.h"
+#include "Weapons/ShooterWeaponConfig.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogShooterWeaponConfigMigrate, Log, All);
+
+UShooterWeaponConfigMigrateCommandlet::UShooterWeaponConfigMigrateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UShooterWeaponConfigMigrateCommandlet::Main(const FString& Params)
+{
+	FString Path = TEXT("/Game/Blueprints/Weapons");
+	FParse::Value(*Params, TEXT("Path="), Path);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Blueprints;
+	AssetRegistry.GetAssetsByPath(*Path, Blueprints, true);
+
+	int32 NumMigrated = 0;
+	for (const FAssetData& AssetData : Blueprints)
+	{
+		if (AssetData.AssetClass != UBlueprint::StaticClass()->GetFName())
+		{
+			continue;
+		}
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+		UClass* WeaponClass = Blueprint ? *Blueprint->GeneratedClass : NULL;
+		if (WeaponClass == NULL || !WeaponClass->IsChildOf(AShooterWeapon::StaticClass()))
+		{
+			continue;
+		}
+
+		AShooterWeapon* WeaponCDO = WeaponClass->GetDefaultObject<AShooterWeapon>();
+		if (WeaponCDO->GetTuningConfig())
+		{
+			UE_LOG(LogShooterWeaponConfigMigrate, Log, TEXT("%s already uses %s"), *Blueprint->GetName(), *WeaponCDO->GetTuningConfig()->GetName());
+			continue;
+		}
+
+		const FString ConfigPackageName = FString::Printf(TEXT("%s/DA_%s"), *FPackageName::GetLongPackagePath(AssetData.PackageName.ToString()), *Blueprint->GetName());
+		UPackage* ConfigPackage = CreatePackage(*ConfigPackageName);
+		UShooterWeaponConfig* Config = NewObject<UShooterWeaponConfig>(ConfigPackage, *FPackageName::GetShortName(ConfigPackageName), RF_Public | RF_Standalone);
+
+		WeaponCDO->MigrateToTuningConfig(Config);
+		FAssetRegistryModule::AssetCreated(Config);
+
+		const FString ConfigFileName = FPackageName::LongPackageNameToFilename(ConfigPackageName, FPackageName::GetAssetPackageExtension());
+		const FString BlueprintFileName = FPackageName::LongPackageNameToFilename(AssetData.PackageName.ToString(), FPackageName::GetAssetPackageExtension());
+		if (!UPackage::SavePackage(ConfigPackage, Config, RF_Public | RF_Standalone, *ConfigFileName) ||
+			!UPackage::SavePackage(Blueprint->GetOutermost(), Blueprint, RF_Standalone, *BlueprintFileName))
+		{
+			UE_LOG(LogShooterWeaponConfigMigrate, Error, TEXT("%s: failed to save migrated packages"), *Blueprint->GetName());
+			return 1;
+		}
+
+		UE_LOG(LogShooterWeaponConfigMigrate, Log, TEXT("%s: weapon data copied to %s"), *Blueprint->GetName(), *ConfigPackageName);
+		NumMigrated++;
+	}
+
+	UE_LOG(LogShooterWeaponConfigMigrate, Log, TEXT("Migrated %d weapon blueprints"), NumMigrated);
+	return 0;
+}
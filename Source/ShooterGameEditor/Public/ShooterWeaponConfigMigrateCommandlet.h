@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "ShooterWeaponConfigMigrateCommandlet.generated.h"
+
+/**
+ * Copies config structs of weapon blueprints into new WeaponConfig assets next to them and points TuningConfig at those.
+ * Usage: ShooterGame -run=ShooterWeaponConfigMigrate [-Path=/Game/Blueprints/Weapons]
+ */
+UCLASS()
+class UShooterWeaponConfigMigrateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UShooterWeaponConfigMigrateCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};